@@ -45,9 +45,29 @@ typedef enum {
     WHM_MXL_CONFIG_FLOW_MAX
 } whm_mxl_config_flow_e;
 
+typedef struct {
+    const char* odlName;                  /* vendor parameter name in data model */
+    const char* hapdName;                 /* hostapd conf name, NULL if not mapped */
+    whm_mxl_hapd_action_e radAction;      /* action when changed on a radio */
+    whm_mxl_hapd_action_e vapAction;      /* action when changed on an accesspoint */
+    bool hasRadAction;
+    bool hasVapAction;
+} whm_mxl_paramMapEntry_t;
+
+/* Param actions collected during one commit window of a radio */
+typedef struct {
+    amxp_timer_t* timer;                  /* commit window timer, flushes pending actions */
+    whm_mxl_hapd_action_e radAction;      /* highest pending radio scope action */
+    uint32_t nrParams;                    /* params collected in the current window */
+    uint32_t nrLiveApplied;               /* params applied with live SET + beacon update */
+} whm_mxl_pendingActions_t;
+
 typedef swl_rc_ne (* whm_mxl_actionHandler_f) (T_Radio* pRad, T_AccessPoint* pAP);
 typedef swl_rc_ne (* whm_mxl_actionEpHandler_f) (T_Radio* pRad, T_EndPoint* pEP);
 
+void whm_mxl_pendingActions_init(T_Radio* pRad);
+void whm_mxl_pendingActions_deinit(T_Radio* pRad);
+const whm_mxl_paramMapEntry_t* whm_mxl_getParamMapEntry(const char* paramName);
 swl_rc_ne whm_mxl_determineRadParamAction(T_Radio* pRad, const char* paramName, const char* paramValue);
 swl_rc_ne whm_mxl_determineVapParamAction(T_AccessPoint* pAP, const char* paramName, const char* paramValue);
 swl_rc_ne whm_mxl_determineEpParamAction(T_EndPoint* pEP, const char* paramName);
@@ -66,6 +86,10 @@ swl_rc_ne whm_mxl_configureSaeExt(T_AccessPoint* pAP);
 swl_rc_ne whm_mxl_hostapd_setMldParams(T_AccessPoint* pAP);
 swl_rc_ne whm_mxl_toggleWPA3PersonalCompatibility(T_AccessPoint* pAP);
 whm_mxl_config_flow_e whm_mxl_chooseVapConfigFlow(T_AccessPoint* pAP, whm_mxl_config_type_e type);
+void whm_mxl_cfgShadow_setRecording(bool recording);
+void whm_mxl_cfgShadow_update(T_AccessPoint* pAP, swl_mapChar_t* configMap);
+const char* whm_mxl_cfgShadow_get(T_AccessPoint* pAP, const char* key);
+bool whm_mxl_cfgShadow_isParamChanged(T_AccessPoint* pAP, const char* key, const char* newValue);
 #ifdef CONFIG_VENDOR_MXL_PROPRIETARY
 swl_rc_ne whm_mxl_configureBgAcs(T_Radio* pRad, uint16_t bgAcsInterval);
 #endif /* CONFIG_VENDOR_MXL_PROPRIETARY */
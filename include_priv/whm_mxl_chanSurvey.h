@@ -0,0 +1,58 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __WHM_MXL_CHAN_SURVEY_H__
+#define __WHM_MXL_CHAN_SURVEY_H__
+
+#include "wld/wld.h"
+
+#define MXL_CHAN_SURVEY_MAX_RECORDS 64
+#define MXL_CHAN_SURVEY_DEF_HALF_LIFE_SEC 60
+#define MXL_CHAN_SURVEY_DEF_MAX_AGE_SEC 600
+
+/* One channel measurement, as reported by a CHAN_DATA vendor event */
+typedef struct {
+    uint32_t channel;
+    uint32_t freq;                  /* MHz */
+    int32_t bandwidth;              /* driver bandwidth */
+    int32_t load;                   /* channel load, % */
+    int32_t noise;                  /* noise floor, dBm */
+    int32_t interference;           /* channel wide interference, dBm */
+    int32_t nrBss;                  /* BSSs seen on the channel */
+} whm_mxl_chanSurveySample_t;
+
+/* Time decayed measurements of one channel: older samples weigh half as much every half life */
+typedef struct {
+    uint32_t channel;
+    uint32_t freq;
+    int32_t bandwidth;
+    float load;
+    float noise;
+    float interference;
+    float nrBss;
+    whm_mxl_chanSurveySample_t last;
+    swl_timeMono_t firstTime;
+    swl_timeMono_t lastTime;
+    uint32_t nrSamples;
+} whm_mxl_chanSurveyRecord_t;
+
+/* Per radio channel survey, indexed by channel number */
+typedef struct {
+    whm_mxl_chanSurveyRecord_t records[MXL_CHAN_SURVEY_MAX_RECORDS];
+    uint32_t nrRecords;
+    uint8_t index[256];             /* record slot + 1 by channel, 0 for an unknown channel */
+    uint32_t halfLife;              /* seconds */
+    uint32_t maxAge;                /* seconds after which a record is stale */
+    uint64_t nrSamples;
+    uint64_t nrEvicted;             /* records dropped to make room for a new channel */
+} whm_mxl_chanSurvey_t;
+
+void whm_mxl_chanSurvey_init(T_Radio* pRad);
+void whm_mxl_chanSurvey_addSample(T_Radio* pRad, const whm_mxl_chanSurveySample_t* pSample);
+
+#endif /* __WHM_MXL_CHAN_SURVEY_H__ */
@@ -9,11 +9,13 @@
 #ifndef __WHM_MXL_CSI_H__
 #define __WHM_MXL_CSI_H__
 
+#include "swl/swl_common_time_spec.h"
 #include "wld/wld.h"
 #include "whm_mxl_utils.h"
 
 #define MXL_CSI_MIN_SRATE 10
 #define MXL_CSI_MAX_SRATE 30
+#define MXL_CSI_RATE_CTRL_MAX_CLIENTS 16
 
 typedef struct {
     uint16_t saFamily;
@@ -30,16 +32,145 @@ typedef struct {
     uint64_t csiReqInfoCount;
 } whm_mxl_csiCounters_t;
 
+/*
+ * CSI socket wire format.
+ * From the connection, every CSI event is sent as the raw driver struct, without header (legacy raw mode).
+ * Bytes received from a legacy raw subscriber that are not a well formed whm_mxl_csiWireConf_t
+ * (size, magic and version) are ignored, and its stream is never changed.
+ * A well formed request negotiates the framed mode: it gets a reply, a whm_mxl_csiWireHdr_t with
+ * encoding MXL_CSI_WIRE_ENC_CONF followed by the whm_mxl_csiWireConf_t in use from then on,
+ * with its status, and every frame following the reply starts with a whm_mxl_csiWireHdr_t.
+ * The compact format may be requested within 200ms after connecting.
+ * Requests coming later, or asking for a subcarrier decimation or a quantization, are rejected
+ * and the format in use is kept.
+ * In framed mode, each frame is a whm_mxl_csiWireHdr_t followed by payloadLen bytes:
+ * - MXL_CSI_WIRE_ENC_RAW : the raw driver struct
+ * - MXL_CSI_WIRE_ENC_KEY : the raw driver struct, zero run length encoded
+ * - MXL_CSI_WIRE_ENC_DELTA : the XOR with the previous frame of the same radio, zero run length encoded
+ * - MXL_CSI_WIRE_ENC_CONF : reply to a wire format request
+ * Zero run length encoding: a control byte c with bit 7 set stands for (c & 0x7f) + 1 zero bytes,
+ * otherwise it is followed by c + 1 literal bytes.
+ * Multi-byte fields are in host byte order (the socket is local).
+ */
+#define MXL_CSI_WIRE_MAGIC 0x4353    /* "CS" */
+#define MXL_CSI_WIRE_VERSION 1
+
+typedef enum {
+    MXL_CSI_WIRE_FMT_RAW,
+    MXL_CSI_WIRE_FMT_COMPACT,
+    MXL_CSI_WIRE_FMT_MAX
+} whm_mxl_csiWireFmt_e;
+
+typedef enum {
+    MXL_CSI_WIRE_ENC_RAW,
+    MXL_CSI_WIRE_ENC_KEY,
+    MXL_CSI_WIRE_ENC_DELTA,
+    MXL_CSI_WIRE_ENC_CONF,
+} whm_mxl_csiWireEnc_e;
+
+typedef enum {
+    MXL_CSI_WIRE_GRANTED,
+    MXL_CSI_WIRE_REJECTED,
+} whm_mxl_csiWireStatus_e;
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t format;             /* whm_mxl_csiWireFmt_e */
+    uint8_t decimation;         /* keep 1 subcarrier out of N, 1 for all */
+    uint8_t quantBits;          /* bits per sample, 0 for the driver resolution */
+    uint8_t delta;              /* inter-frame delta encoding */
+    uint8_t keyInterval;        /* max frames between two key frames */
+    uint8_t status;             /* whm_mxl_csiWireStatus_e, in replies only */
+} whm_mxl_csiWireConf_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t encoding;           /* whm_mxl_csiWireEnc_e */
+    uint8_t radioIndex;
+    uint8_t reserved;
+    uint16_t seq;               /* per subscriber frame counter */
+    uint32_t rawLen;            /* decoded frame length */
+    uint32_t payloadLen;
+} whm_mxl_csiWireHdr_t;
+
+#define MXL_CSI_COUNTERS_MAX_CLIENTS 32
+#define MXL_CSI_COUNTERS_INDEX_SIZE 64     /* power of 2, at least twice the max number of clients */
+
+/* CSI counters of one sensing client */
+typedef struct {
+    swl_macBin_t mac;
+    whm_mxl_csiCounters_t base;         /* driver counters at the last reset */
+    whm_mxl_csiCounters_t last;         /* driver counters read by the last snapshot */
+    whm_mxl_csiCounters_t counters;     /* counters since the last reset, as of the last snapshot */
+    bool valid;                         /* client read by the last snapshot */
+} whm_mxl_csiClientCounters_t;
+
+/*
+ * Per radio snapshot of the CSI counters of all sensing clients.
+ * Counters are reset against a software baseline taken from the snapshot itself,
+ * so that no frame counted by the driver is lost between the read and the reset.
+ */
+typedef struct {
+    whm_mxl_csiClientCounters_t clients[MXL_CSI_COUNTERS_MAX_CLIENTS];
+    uint32_t nrClients;
+    uint8_t index[MXL_CSI_COUNTERS_INDEX_SIZE];  /* client slot + 1 by MAC hash, 0 for a free entry */
+    whm_mxl_csiCounters_t counters;     /* sum over all clients of the last snapshot */
+    swl_timeSpecMono_t snapshotTs;      /* completion of the last snapshot, or of the last reset */
+    bool hasSnapshot;                   /* snapshotTs is set */
+    bool reported;                      /* last snapshot already reported once */
+    uint32_t nrPending;                 /* counter requests of the snapshot in progress */
+    bool reset;                         /* snapshot in progress also resets the counters */
+    bool resetRequested;                /* reset requested while a snapshot was in progress */
+    uint64_t nrSnapshots;
+    uint64_t nrResets;
+} whm_mxl_csiStats_t;
+
+typedef enum {
+    MXL_CSI_RATE_HOLD,
+    MXL_CSI_RATE_INCREASE,      /* subscribers keep up: step up towards the requested rate */
+    MXL_CSI_RATE_DECREASE,      /* subscribers drop or lag: back off */
+    MXL_CSI_RATE_MIN,           /* no subscriber: sound at the minimum rate */
+} whm_mxl_csiRateDecision_e;
+
+/* Sampling rate control state of one CSI client */
+typedef struct {
+    swl_macBin_t mac;
+    uint8_t rate;               /* Hz applied by the driver, within MXL_CSI_MIN_SRATE..targetRate */
+    uint8_t targetRate;         /* Hz, from the client monitor interval */
+    uint8_t pendingRate;        /* Hz sent to the driver and not acknowledged yet, 0 for none */
+    bool used;
+    bool measured;              /* eventRate measured over the last tick */
+    uint64_t lastNlCsiData;     /* driver CSI events of the client at the previous tick */
+    uint32_t eventRate;         /* CSI events per second delivered for the client over the last tick */
+    whm_mxl_csiRateDecision_e decision; /* decision of the last tick */
+    uint64_t nrDecreases;
+    uint64_t nrIncreases;
+    uint64_t nrRejected;        /* rate changes rejected by the driver */
+} whm_mxl_csiClientRate_t;
+
+/* Per radio CSI sampling rate controller, driven by the drain of the radio frames on the CSI socket */
 typedef struct {
-    int serverfd;
-    int clientfd;
-} whm_mxl_connection_t;
+    whm_mxl_csiClientRate_t clients[MXL_CSI_RATE_CTRL_MAX_CLIENTS];
+    uint64_t nrEvents;          /* CSI events received from the driver */
+    uint64_t lastNrEvents;      /* nrEvents at the previous controller tick */
+    uint32_t eventRate;         /* events per second over the last tick */
+    uint64_t nrSentFrames;      /* frames of the radio fully sent to the subscribers */
+    uint64_t nrDroppedFrames;   /* frames of the radio dropped on full subscriber queues */
+    uint64_t lastSentFrames;    /* nrSentFrames at the previous controller tick */
+    uint64_t lastDroppedFrames; /* nrDroppedFrames at the previous controller tick */
+    uint32_t dropPermille;      /* frames of the radio dropped over the last tick */
+    uint32_t maxBacklog;        /* frames of the radio queued for the slowest subscriber */
+    uint64_t nrDecreases;
+    uint64_t nrIncreases;
+} whm_mxl_csiRateCtrl_t;
 
 swl_rc_ne whm_mxl_rad_sensingCmd(T_Radio* pRad);
 swl_rc_ne whm_mxl_rad_sensingAddClient(T_Radio* pRad, wld_csiClient_t* client);
 swl_rc_ne whm_mxl_rad_sensingDelClient(T_Radio* pRad, swl_macChar_t macAddr);
 swl_rc_ne whm_mxl_rad_sensingCsiStats(T_Radio* pRad, wld_csiState_t* csimonState);
 swl_rc_ne whm_mxl_rad_sensingResetStats(T_Radio* pRad);
-void mxl_rad_sendCsiStatsOverUnixSocket(wifi_csi_driver_nl_event_data_t* stats);
+void mxl_rad_sendCsiStatsOverUnixSocket(T_Radio* pRad, const wifi_csi_driver_nl_event_data_t* stats);
 
 #endif /* __WHM_MXL_CSI_H__ */
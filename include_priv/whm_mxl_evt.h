@@ -14,7 +14,26 @@
 #define WPA_MSG_LEVEL_INFO "<3>"
 #define WPA_MSG_MAX_EVENT_NAME_LEN 64
 
-typedef void (* evtParser_f)(void* userData, char* ifName, char* event, char* params);
+#define WPA_MSG_MAX_EVENT_ARGS 32
+
+/* One "key=value" (or positional value, with NULL key) slice of a wpa ctrl event, not nul-terminated */
+typedef struct {
+    const char* key;
+    uint32_t keyLen;
+    const char* val;
+    uint32_t valLen;
+} whm_mxl_wpaEvtArg_t;
+
+/* wpa ctrl event tokenized in place: all slices point into the received message */
+typedef struct {
+    const char* name;
+    uint32_t nameLen;
+    const char* params;
+    uint32_t nrArgs;
+    whm_mxl_wpaEvtArg_t args[WPA_MSG_MAX_EVENT_ARGS];
+} whm_mxl_wpaEvt_t;
+
+typedef void (* evtParser_f)(void* userData, char* ifName, const whm_mxl_wpaEvt_t* pEvt);
 
 swl_rc_ne mxl_evt_setVendorEvtHandlers(T_Radio* pRad);
 
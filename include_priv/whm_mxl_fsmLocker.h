@@ -12,7 +12,7 @@
 #include "wld/wld_types.h"
 #include "wld/wld_fsm.h"
 
-bool whm_mxl_reconfFsmLock(T_Radio* pRad);
+bool whm_mxl_reconfFsmLock(T_Radio* pRad, bool crossRadio);
 void whm_mxl_reconfFsmUnLock(T_Radio* pRad);
 void whm_mxl_reconfFsmEnsureLock(T_Radio* pRad);
 void whm_mxl_extLocker_init(wld_fsmMngr_t* fsmMngr);
@@ -0,0 +1,46 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __WHM_MXL_HAPD_CONF_H__
+#define __WHM_MXL_HAPD_CONF_H__
+
+#include <sys/types.h>
+#include <time.h>
+
+#include "wld/wld_types.h"
+
+#define MXL_HAPD_CONF_SECTION_NAME_LEN 32
+
+/* One section of the hostapd config file: radio header or one "bss=" block */
+typedef struct {
+    char name[MXL_HAPD_CONF_SECTION_NAME_LEN];  /* empty for the radio header */
+    size_t offset;
+    size_t len;
+    uint32_t hash;
+} whm_mxl_hapdConfSection_t;
+
+/* Layout of the hostapd config file last written or read, per radio */
+typedef struct {
+    whm_mxl_hapdConfSection_t* sections;
+    uint32_t nrSections;
+    uint32_t maxSections;
+    bool valid;                 /* layout matches the file identified by ino/size/mtime */
+    ino_t ino;
+    off_t size;
+    struct timespec mtime;
+    uint32_t nrWrites;          /* config files replaced */
+    uint32_t nrSkipped;         /* generations leaving the config file untouched */
+    uint32_t lastNrChanged;     /* sections changed by the last write */
+} whm_mxl_hapdConf_t;
+
+bool whm_mxl_hapdConf_write(T_Radio* pRad);
+bool whm_mxl_hapdConf_isCurrent(T_Radio* pRad);
+bool whm_mxl_hapdConf_sync(T_Radio* pRad);
+void whm_mxl_hapdConf_cleanup(T_Radio* pRad);
+
+#endif /* __WHM_MXL_HAPD_CONF_H__ */
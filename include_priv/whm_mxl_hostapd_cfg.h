@@ -112,18 +112,119 @@
         } \
     }
 
-#define WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, obj, paramName, configMap, confName) \
+#define WHM_MXL_SET_STRING_PARAM(str, configMap, confName) \
     { \
-        tmpStr = amxd_object_get_value(cstring_t, obj, paramName, NULL); \
-        if (!swl_str_isEmpty(tmpStr)) { \
-            swl_mapCharFmt_addValStr(configMap, confName, "%s", tmpStr); \
+        if (!swl_str_isEmpty(str)) { \
+            swl_mapCharFmt_addValStr(configMap, confName, "%s", str); \
         } \
-        free(tmpStr); \
     }
 
+/* Struct Definition Section */
+/* Radio vendor config sections, one per vendor object feeding the radio config map */
+typedef enum {
+    MXL_RAD_CFG_SECTION_MAIN,           /* WiFi.Radio.{}.Vendor. */
+    MXL_RAD_CFG_SECTION_AFC,            /* WiFi.Radio.{}.Vendor.AFC. */
+    MXL_RAD_CFG_SECTION_BSS_COLOR,      /* WiFi.Radio.{}.Vendor.BssColor. */
+    MXL_RAD_CFG_SECTION_DELAYED_START,  /* WiFi.Radio.{}.Vendor.DelayedStart. */
+    MXL_RAD_CFG_SECTION_OBSS,           /* WiFi.Radio.{}.Vendor.ObssScanParams. */
+    MXL_RAD_CFG_SECTION_ACS,            /* WiFi.Radio.{}.Vendor.ACS. */
+    MXL_RAD_CFG_SECTION_MAX
+} whm_mxl_radCfgSection_e;
+
+typedef struct {
+    int32_t bfMode;
+    bool heDebugMode;
+    bool heBeacon;
+    bool disableMbssid;
+    bool duplicateBeacon;
+    bool backgroundCac;
+    bool ignore40MhzIntolerant;
+    bool probeReqCltMode;
+    bool dynamicEdca;
+    bool qamPlus;
+    uint32_t duplicateBeaconBw;
+    uint32_t twtResponderSupport;
+    uint32_t heMacTwtResponderSupport;
+    uint32_t probeReqListTimer;
+    uint32_t subBandDFS;
+    uint16_t apMaxSta;
+    uint16_t punctureBitMap;
+    int32_t obssBeaconRssiThreshold;
+    int32_t powerSelection;
+    int8_t radarRssiTh;
+    int32_t dfsDebugChan;
+    int32_t zwdfsDebugChan;
+    char* dfsChStateFile;
+    char* ccaTh;
+} whm_mxl_radMainCfg_t;
+
+typedef struct {
+    char* afcdSock;
+    char* opClass;
+    char* frequencyRange;
+    char* certIds;
+    char* serialNumber;
+    char* linearPolygon;
+    char* requestId;
+    char* requestVersion;
+    int32_t locationType;
+} whm_mxl_radAfcCfg_t;
+
+typedef struct {
+    bool autonomousColorChange;
+    int32_t changeTimeout;
+    int32_t numCollisionsThreshold;
+    int32_t collAgeThresh;
+    int32_t usedColorTableAgeing;
+    int32_t heBssColor;
+} whm_mxl_radBssColorCfg_t;
+
+typedef struct {
+    char* startAfter;
+    uint32_t startAfterDelay;
+    uint32_t startAfterWatchdogTime;
+} whm_mxl_radDelayedStartCfg_t;
+
+typedef struct {
+    int32_t obssInterval;
+    uint32_t scanPassiveDwell;
+    uint32_t scanActiveDwell;
+    uint32_t scanPassiveTotalPerChannel;
+    uint32_t scanActiveTotalPerChannel;
+    uint32_t channelTransitionDelayFactor;
+    uint32_t scanActivityThreshold;
+} whm_mxl_radObssCfg_t;
+
+typedef struct {
+    bool scanMode;
+    bool updateDoSwitch;
+    bool fils;
+    bool punct6gMode;
+    char* fallbackChan;
+    char* optChList6g;
+} whm_mxl_radAcsCfg_t;
+
+/*
+ * Typed copy of the radio vendor objects used to generate the radio config map.
+ * A section is reloaded from the data model only after a change of its object.
+ */
+typedef struct {
+    uint32_t validSections;     /* bit per whm_mxl_radCfgSection_e, cleared when object changed */
+    uint32_t nrReloads;         /* sections reloaded from the data model */
+    whm_mxl_radMainCfg_t main;
+    whm_mxl_radAfcCfg_t afc;
+    whm_mxl_radBssColorCfg_t bssColor;
+    whm_mxl_radDelayedStartCfg_t delayedStart;
+    whm_mxl_radObssCfg_t obss;
+    whm_mxl_radAcsCfg_t acs;
+} whm_mxl_radVendorCfg_t;
+
 /* Function Declarations Section */
 /* Radio Configs */
 swl_rc_ne whm_mxl_rad_updateConfigMap(T_Radio* pRad, swl_mapChar_t* configMap);
+void whm_mxl_rad_invalidateVendorCfg(T_Radio* pRad, whm_mxl_radCfgSection_e section);
+void whm_mxl_rad_invalidateVendorCfgFromSignal(const amxc_var_t* const data, whm_mxl_radCfgSection_e section);
+void whm_mxl_rad_cleanupVendorCfg(T_Radio* pRad);
 
 /* VAP Configs */
 swl_rc_ne whm_mxl_vap_updateConfigMap(T_AccessPoint* pAP, swl_mapChar_t* configMap);
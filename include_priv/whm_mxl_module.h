@@ -9,6 +9,7 @@
 #ifndef __WHM_MXL_MODULE_H__
 #define __WHM_MXL_MODULE_H__
 
+#include "wld/wld_types.h"
 #include "wld/wld_vendorModule.h"
 
 #define MXL_VENDOR_NAME "whm-mxl"
@@ -34,10 +35,24 @@ typedef struct {
     bool wpa3CertMode;
 } whm_mxl_module_mode_t;
 
+/* Boot phases, timestamped on their first occurrence */
+typedef enum {
+    MXL_BOOT_MODULE_INIT,           /* vendor module init entered */
+    MXL_BOOT_VENDOR_REGISTERED,     /* vendor function table registered to pwhm */
+    MXL_BOOT_WIPHYS_PROBED,         /* wiphy and vendor wiphy info collected */
+    MXL_BOOT_IFACES_CREATED,        /* main interfaces available */
+    MXL_BOOT_RADIOS_ADDED,          /* radios attached to the vendor */
+    MXL_BOOT_FIRST_VAP_UP,          /* first BSS up, i.e. first beacon */
+    MXL_BOOT_ALL_RADIOS_UP,         /* every radio has a BSS up */
+    MXL_BOOT_PHASE_MAX
+} whm_mxl_bootPhase_e;
+
 bool whm_mxl_module_init();
 bool whm_mxl_module_deInit();
 bool whm_mxl_module_loadDefaults();
 swl_rc_ne whm_mxl_module_addRadios();
+void whm_mxl_module_markBootPhase(whm_mxl_bootPhase_e phase);
+void whm_mxl_module_markRadioUp(T_Radio* pRad);
 whm_mxl_module_mode_e whm_mxl_getModuleMode();
 bool whm_mxl_isCertModeEnabled();
 bool whm_mxl_isWpa3CertModeEnabled();
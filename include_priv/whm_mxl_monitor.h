@@ -12,10 +12,37 @@
 #include "wld/wld.h"
 #include "swl/swl_common_time_spec.h"
 
+#define MXL_NASTA_HASH_SIZE 128
+
+typedef enum {
+    MXL_NASTA_SCHED_PRIORITY,    /* measure the devices with the oldest measurement first */
+    MXL_NASTA_SCHED_ROUND_ROBIN, /* measure the devices in turn */
+    MXL_NASTA_SCHED_MAX
+} mxl_nastaSchedPolicy_e;
+
 typedef struct nastaEntryData {
-    amxc_llist_it_t it;
+    amxc_llist_it_t it;           /* hash bucket chaining */
+    amxc_llist_it_t schedIt;      /* scheduling order */
+    amxc_llist_it_t runIt;        /* in-flight request list */
     swl_macBin_t mac;
-    swl_timeSpecMono_t startTs;
+    T_NonAssociatedDevice* pMD;
+    uint32_t syncGen;
+    swl_timeSpecMono_t startTs;   /* start of in-flight request */
+    uint32_t timeoutMs;           /* in-flight request expiry, relative to startTs */
+    swl_timeMono_t addTime;
+    swl_timeMono_t lastMeasTime;  /* last successful measurement, 0 if none */
+    uint32_t nrRequests;
+    uint32_t nrMeasurements;
+    uint32_t nrTimeouts;
+    /* last measurement written to the NonAssociatedDevice instance */
+    int32_t syncRssi;
+    uint8_t syncChannel;
+    uint8_t syncOperClass;
+    swl_timeMono_t syncTime;
+    bool synced;                  /* instance written at least once */
+    bool dirty;                   /* instance to be written on the next flush */
+    bool writing;                 /* selected in the sync transaction being applied */
+    swl_timeMono_t avoidedTime;   /* last measurement whose write was skipped, counted once */
 } mxl_nastaEntryData_t;
 
 typedef struct nastaData {
@@ -29,10 +56,42 @@ typedef struct nastaData {
      */
     amxp_timer_t* timer;
 
+    /*
+     * Monitored stations, hashed on MAC address
+     */
+    amxc_llist_t buckets[MXL_NASTA_HASH_SIZE];
+
+    /*
+     * Monitored stations, in scheduling order
+     */
+    amxc_llist_t schedList;
+
     /*
      * list of runtime Unassoc stations being scanned, and waiting for measurements
      */
     amxc_llist_t scanList;
+
+    /* Scheduler configuration */
+    uint32_t capacity;
+    uint32_t batchSize;
+    mxl_nastaSchedPolicy_e policy;
+
+    /* Scheduler state and counters */
+    uint32_t nrEntries;
+    uint32_t syncGen;
+    uint32_t nrRejected;          /* stations not monitored on the last sync, capacity reached */
+    uint32_t nrWindows;
+
+    /* NonAssociatedDevice data model sync */
+    amxp_timer_t* syncTimer;      /* rate limited flush of the dirty entries */
+    swl_timeSpecMono_t lastSyncTs;
+    uint32_t syncHysteresis;      /* dB of RSSI change needed to write an instance, 0 for any change */
+    uint32_t syncInterval;        /* ms between two flushes */
+    uint32_t nrDirty;
+    uint64_t nrSyncFlushes;
+    uint64_t nrSyncWrites;        /* instances written */
+    uint64_t nrSyncAvoided;       /* new measurements not written: no change beyond the hysteresis */
+    uint64_t nrSyncCoalesced;     /* changes merged into a pending write */
 } mxl_nastaData_t;
 
 void whm_mxl_monitor_init(T_Radio* pRad);
@@ -46,9 +105,11 @@ int whm_mxl_monitor_updateNaStaObj(T_Radio* pRad);
 swl_rc_ne whm_mxl_monitor_addStaMon(T_Radio* pRad, T_NonAssociatedDevice* pMD);
 int whm_mxl_monitor_delStamon(T_Radio* pRad, T_NonAssociatedDevice* pMD);
 
+mxl_nastaEntryData_t* whm_mxl_monitor_fetchNaStaEntry(T_Radio* pRad, swl_macBin_t* pStaMac);
+mxl_nastaEntryData_t* whm_mxl_monitor_addNaStaEntry(T_Radio* pRad, T_NonAssociatedDevice* pMD);
+void whm_mxl_monitor_delNaStaEntry(T_Radio* pRad, mxl_nastaEntryData_t* pEntry);
 mxl_nastaEntryData_t* whm_mxl_monitor_fetchRunNaStaEntry(T_Radio* pRad, swl_macBin_t* pStaMac);
-mxl_nastaEntryData_t* whm_mxl_monitor_addRunNaStaEntry(T_Radio* pRad, swl_macBin_t* pStaMac);
-void whm_mxl_monitor_delRunNaStaEntry(mxl_nastaEntryData_t* pEntry);
+void whm_mxl_monitor_completeRunNaStaEntry(mxl_nastaEntryData_t* pEntry, bool measured);
 void whm_mxl_monitor_dropAllRunNaStaEntries(T_Radio* pRad);
 void whm_mxl_monitor_checkRunNaStaList(T_Radio* pRad);
 uint32_t whm_mxl_monitor_getRunNaStaEntryCount(T_Radio* pRad);
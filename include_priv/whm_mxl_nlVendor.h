@@ -0,0 +1,31 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __WHM_MXL_NL_VENDOR_H__
+#define __WHM_MXL_NL_VENDOR_H__
+
+#include <netlink/attr.h>
+#include <netlink/msg.h>
+
+#include "swl/swl_common.h"
+
+/* Read-only view on the vendor payload of a netlink message, pointing into the message buffer */
+typedef struct {
+    const void* data;
+    size_t len;
+    uint32_t id;        /* vendor subcmd or vendor event */
+} whm_mxl_nlVendorView_t;
+
+/* Typed access to the payload of a view, only valid while the netlink message is alive */
+#define WHM_MXL_NL_VENDOR_VIEW(pView, type) ((const type*) (pView)->data)
+
+swl_rc_ne whm_mxl_nlVendor_getReplyView(struct nlmsghdr* nlh, uint32_t subcmd, whm_mxl_nlVendorView_t* pView);
+swl_rc_ne whm_mxl_nlVendor_getSizedReplyView(struct nlmsghdr* nlh, size_t size, whm_mxl_nlVendorView_t* pView);
+swl_rc_ne whm_mxl_nlVendor_getEvtView(struct nlattr* vendorData, uint32_t evt, whm_mxl_nlVendorView_t* pView);
+
+#endif /* __WHM_MXL_NL_VENDOR_H__ */
@@ -12,10 +12,11 @@
 #include <netlink/attr.h>
 
 #include "wld/wld.h"
+#include "whm_mxl_nlVendor.h"
 
-swl_rc_ne mxl_parseNaStaStats(T_Radio* pRad, struct nlattr* tb[], uint8_t reqType, bool syncDm);
-swl_rc_ne mxl_parseChanDataEvt(T_Radio* pRad, struct nlattr* tb[]);
-swl_rc_ne mxl_parseCsiStatsEvt(T_Radio* pRad, struct nlattr* tb[]);
+swl_rc_ne mxl_parseNaStaStats(T_Radio* pRad, const whm_mxl_nlVendorView_t* pView, uint8_t reqType, bool syncDm);
+swl_rc_ne mxl_parseChanDataEvt(T_Radio* pRad, const whm_mxl_nlVendorView_t* pView);
+swl_rc_ne mxl_parseCsiStatsEvt(T_Radio* pRad, const whm_mxl_nlVendorView_t* pView);
 swl_rc_ne mxl_parseWiphyInfo(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv);
 
 #endif /* __WHM_MXL_PARSER_H__ */
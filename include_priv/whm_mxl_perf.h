@@ -0,0 +1,52 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __WHM_MXL_PERF_H__
+#define __WHM_MXL_PERF_H__
+
+#include "wld/wld_types.h"
+#include "swl/swl_common_time_spec.h"
+
+typedef enum {
+    MXL_PERF_RAD_STATS,     /* radio stats poll */
+    MXL_PERF_STA_STATS,     /* station stats poll of one AP */
+    MXL_PERF_RECONF_CYCLE,  /* reconf FSM cycle, from leaving IDLE until back to IDLE */
+    MXL_PERF_MAX
+} whm_mxl_perfProbe_e;
+
+typedef struct {
+    uint64_t nrRuns;
+    uint64_t totalUs;
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint64_t totalRoundTrips;   /* driver or hostapd requests */
+    uint32_t lastRoundTrips;
+    uint32_t lastNrItems;       /* stations, APs or actions handled in the last run */
+} whm_mxl_perfStats_t;
+
+typedef struct {
+    swl_timeSpecMono_t startTs;
+    uint32_t nrRoundTrips;
+    uint32_t nrItems;
+    bool running;
+} whm_mxl_perfRun_t;
+
+typedef struct {
+    whm_mxl_perfStats_t stats[MXL_PERF_MAX];
+    whm_mxl_perfRun_t run[MXL_PERF_MAX];
+} whm_mxl_perf_t;
+
+void whm_mxl_perf_start(T_Radio* pRad, whm_mxl_perfProbe_e probe);
+void whm_mxl_perf_addRoundTrips(T_Radio* pRad, whm_mxl_perfProbe_e probe, uint32_t nrRoundTrips);
+void whm_mxl_perf_addItems(T_Radio* pRad, whm_mxl_perfProbe_e probe, uint32_t nrItems);
+void whm_mxl_perf_stop(T_Radio* pRad, whm_mxl_perfProbe_e probe);
+void whm_mxl_perf_record(T_Radio* pRad, whm_mxl_perfProbe_e probe, whm_mxl_perfRun_t* pRun);
+void whm_mxl_perf_reset(T_Radio* pRad);
+void whm_mxl_perf_toVar(T_Radio* pRad, amxc_var_t* pMap);
+
+#endif /* __WHM_MXL_PERF_H__ */
@@ -13,6 +13,14 @@
 #include "whm_mxl_monitor.h"
 #include "whm_mxl_zwdfs.h"
 #include "whm_mxl_reconfFsm.h"
+#include "whm_mxl_reconfMngr.h"
+#include "whm_mxl_perf.h"
+#include "whm_mxl_hapdConf.h"
+#include "whm_mxl_cfgActions.h"
+#include "whm_mxl_hostapd_cfg.h"
+#include "whm_mxl_vendorQueue.h"
+#include "whm_mxl_csi.h"
+#include "whm_mxl_chanSurvey.h"
 
 /* General Definitions Section */
 #define CCA_TH_SIZE 5
@@ -24,6 +32,9 @@
 /* Macros Section */
 
 /* Struct Definition Section */
+/* In flight radio stats round, aggregating async driver replies (whm_mxl_rad.c) */
+typedef struct whm_mxl_radStatsRound whm_mxl_radStatsRound_t;
+
 typedef struct {
     /**
      * Data for naStation monitor
@@ -42,9 +53,51 @@ typedef struct {
     /* Reconf FSM state indication */
     whm_mxl_reconfFsm_brief_state_e reconfFsmBriefState;
 
+    /* Radio stats round waiting for driver replies, NULL when idle */
+    whm_mxl_radStatsRound_t* pStatsRound;
+
+    /* Result of the last completed radio stats round: error when no request got a reply */
+    swl_rc_ne statsRoundRc;
+
+    /* Cost instrumentation of stats polls and reconf cycles */
+    whm_mxl_perf_t perf;
+
+    /* Layout of the last written hostapd config file */
+    whm_mxl_hapdConf_t hapdConf;
+
+    /* Reconf FSM current step waits for a hostapd event (event driven mode) */
+    bool reconfFsmWaitEvt;
+
+    /* Reconf FSM remaining attempts to reconnect the wpa ctrl sockets after reconf */
+    uint32_t reconfSyncRetries;
+
     /* Mxl reconf commit timer */
     amxp_timer_t* commitTimer;
 
+    /* Retry timer of stale wpa ctrl sockets reconnection */
+    amxp_timer_t* ctrlRetryTimer;
+
+    /* Changes batched by the reconf commit timer */
+    whm_mxl_commitBatch_t commitBatch;
+
+    /* Async vendor subcmd requests */
+    whm_mxl_vendorQueue_t vendorQueue;
+
+    /* CSI counters collected from the queued per client requests */
+    whm_mxl_csiStats_t csiStats;
+
+    /* CSI sampling rate of each client, adapted to the CSI socket consumers */
+    whm_mxl_csiRateCtrl_t csiRateCtrl;
+
+    /* Channel quality reported by the driver channel data events */
+    whm_mxl_chanSurvey_t chanSurvey;
+
+    /* Typed copy of vendor objects used for radio config map generation */
+    whm_mxl_radVendorCfg_t vendorCfg;
+
+    /* Param change actions coalesced over one commit window */
+    whm_mxl_pendingActions_t pendingActions;
+
     /* Indicate if need to sync wpa ctrl when running Reconf FSM */
     bool checkWpaCtrlOnSync;
 
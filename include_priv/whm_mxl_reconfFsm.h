@@ -24,5 +24,9 @@ typedef enum {
 FSM_STATE whm_mxl_reconf_fsm(T_Radio* pRad);
 void whm_mxl_reconFsm_allRadioReset(void);
 void whm_mxl_reconfFsm_init(T_Radio* pRad);
+void whm_mxl_reconfFsm_setEventDriven(bool enable);
+bool whm_mxl_reconfFsm_isEventDriven(void);
+void whm_mxl_reconfFsm_waitEvent(T_Radio* pRad, uint32_t timeoutMs);
+void whm_mxl_reconfFsm_notifyEvent(T_Radio* pRad);
 
 #endif /* __WHM_MXL_RECONF_FSM_H__ */
@@ -10,6 +10,7 @@
 #define __WHM_MXL_RECONF_MNGR_H__
 
 #include "wld/wld_fsm.h"
+#include "swl/swl_common_time_spec.h"
 
 typedef enum {
     RECONF_FSM_MOD_HAPD_CONF_FILE,      /* Write new configuration file for hostapd */
@@ -21,6 +22,24 @@ typedef enum {
     RECONF_FSM_MAX
 } whm_mxl_reconfMngr_actions_e;
 
+#define MXL_COMMIT_LATENCY_NR_BUCKETS   8
+
+/* Changes batched into one reconf commit, and commit latency statistics */
+typedef struct {
+    bool pending;                       /* commit timer armed for a batch */
+    swl_timeSpecMono_t firstTs;         /* first change of the pending batch */
+    uint32_t bootWaitMs;                /* part of the pending batch blocked by the boot delay */
+    uint32_t nrChanges;                 /* changes in the pending batch */
+    uint32_t nrBatches;
+    uint64_t nrChangesTotal;
+    uint32_t nrDeadlineHits;            /* batches committed on max delay while changes kept arriving */
+    uint32_t nrBootDeferred;            /* batches held back by the boot delay, latency counted from its end */
+    uint32_t lastLatencyMs;             /* from first change, or end of boot delay, to commit */
+    uint32_t maxLatencyMs;
+    uint64_t totalLatencyMs;
+    uint32_t latencyHist[MXL_COMMIT_LATENCY_NR_BUCKETS];
+} whm_mxl_commitBatch_t;
+
 wld_fsmMngr_t* whm_mxl_get_reconfMngr(void);
 int whm_mxl_reconfMngr_doCommit(T_Radio* pRad);
 void whm_mxl_reconfMngr_notifyCommit(T_Radio* pRad);
@@ -12,8 +12,11 @@
 #include "wld/wld.h"
 #include "wld/wld_linuxIfUtils.h"
 #include "whm_mxl_cfgActions.h"
+#include "whm_mxl_wpaCtrlHealth.h"
 
 /* General Definitions Section */
+typedef struct whm_mxl_staStatsRound whm_mxl_staStatsRound_t;
+
 typedef enum {
     MXL_MAP_OFF = 0,
     MXL_BACKHAUL_MAP = 1,
@@ -59,6 +62,14 @@ typedef struct {
     bool h2eRequired;
     /* Enable or Disable ignoring of 11vDiassoc timer */
     bool ignore11vDiassoc;
+    /* Highest param change action pending in the radio commit window */
+    whm_mxl_hapd_action_e pendingAction;
+    /* Shadow of last written hostapd config keys used for config flow selection */
+    amxc_var_t cfgShadow;
+    /* wpa ctrl socket health, for targeted reconnection */
+    whm_mxl_wpaCtrlHealth_t ctrlHealth;
+    /* Station stats round waiting for driver replies, NULL when idle */
+    whm_mxl_staStatsRound_t* pStaStatsRound;
 } mxl_VapVendorData_t;
 
 /* Macros Section */
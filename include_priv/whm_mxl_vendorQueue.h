@@ -0,0 +1,67 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __WHM_MXL_VENDOR_QUEUE_H__
+#define __WHM_MXL_VENDOR_QUEUE_H__
+
+#include "wld/wld.h"
+#include "whm_mxl_nlVendor.h"
+
+#define MXL_VENDOR_QUEUE_DEF_MAX_IN_FLIGHT 4
+#define MXL_VENDOR_QUEUE_DEF_TIMEOUT_MS 1000
+#define MXL_VENDOR_QUEUE_MAX_DEPTH 64
+
+/*
+ * Completion of a queued vendor request, called from the event loop.
+ * pView is only set for successful requests expecting a reply, and is only valid during the call.
+ * On radio teardown, pending requests complete with SWL_RC_INVALID_STATE,
+ * synchronously from within whm_mxl_vendorQueue_deinit().
+ */
+typedef void (* whm_mxl_vendorReqDone_f)(swl_rc_ne rc, const whm_mxl_nlVendorView_t* pView, void* userData);
+
+typedef struct {
+    T_AccessPoint* pAP;             /* AP to send the subcmd on, NULL for a radio subcmd */
+    uint32_t subcmd;
+    const void* data;               /* subcmd payload, copied by the queue */
+    size_t dataLen;
+    bool expectReply;               /* driver replies with vendor data, otherwise the request completes on ack */
+    size_t replySize;               /* expected reply size, 0 to check the reply against the subcmd policy */
+    uint32_t timeoutMs;             /* 0 for the queue default */
+    whm_mxl_vendorReqDone_f doneCb; /* optional */
+    void* userData;
+} whm_mxl_vendorReqArgs_t;
+
+/* Per radio queue of async vendor requests */
+typedef struct {
+    amxc_llist_t waitList;          /* requests waiting for an in-flight slot */
+    amxc_llist_t sentList;          /* requests in flight */
+    amxc_llist_t expiredList;       /* requests past their deadline, still outstanding in the nl80211 layer */
+    amxp_timer_t* deadlineTimer;
+    uint32_t maxInFlight;
+    uint32_t timeoutMs;
+    uint32_t nextSeq;
+    uint32_t nrWaiting;
+    uint32_t nrInFlight;
+    uint32_t nrExpired;             /* expired requests, still outstanding in the nl80211 layer */
+    uint32_t maxDepth;              /* max waiting + in flight requests seen */
+    uint64_t nrQueued;
+    uint64_t nrCompleted;
+    uint64_t nrFailed;
+    uint64_t nrTimeouts;
+    uint64_t nrRejected;            /* requests refused because the queue was full */
+    uint64_t nrLateReplies;         /* replies received after the request deadline */
+    uint64_t totalLatencyMs;
+    uint32_t lastLatencyMs;
+    uint32_t maxLatencyMs;
+} whm_mxl_vendorQueue_t;
+
+void whm_mxl_vendorQueue_init(T_Radio* pRad);
+void whm_mxl_vendorQueue_deinit(T_Radio* pRad);
+swl_rc_ne whm_mxl_vendorQueue_send(T_Radio* pRad, const whm_mxl_vendorReqArgs_t* pArgs, uint32_t* pSeq);
+
+#endif /* __WHM_MXL_VENDOR_QUEUE_H__ */
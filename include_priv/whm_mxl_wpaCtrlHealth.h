@@ -0,0 +1,30 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __WHM_MXL_WPA_CTRL_HEALTH_H__
+#define __WHM_MXL_WPA_CTRL_HEALTH_H__
+
+#include "wld/wld.h"
+#include "swl/swl_common_time_spec.h"
+
+/* wpa ctrl socket health of one VAP */
+typedef struct {
+    bool stale;                         /* socket found not ready, not yet reopened */
+    uint32_t nrFailures;                /* consecutive failed reopen attempts */
+    uint32_t backoffMs;                 /* delay from last attempt to next reopen attempt */
+    swl_timeSpecMono_t lastAttemptTs;
+    uint32_t nrReconnects;              /* successful reopens */
+    uint32_t nrAttempts;                /* all reopen attempts */
+} whm_mxl_wpaCtrlHealth_t;
+
+void whm_mxl_wpaCtrlHealth_init(T_Radio* pRad);
+void whm_mxl_wpaCtrlHealth_deinit(T_Radio* pRad);
+swl_rc_ne whm_mxl_wpaCtrlHealth_reconnectStale(T_Radio* pRad, bool withDummyVap);
+void whm_mxl_wpaCtrlHealth_toVar(T_Radio* pRad, amxc_var_t* pMap);
+
+#endif /* __WHM_MXL_WPA_CTRL_HEALTH_H__ */
@@ -33,6 +33,7 @@
 #include "whm_mxl_vap.h"
 #include "whm_mxl_zwdfs.h"
 #include "whm_mxl_reconfMngr.h"
+#include "whm_mxl_hapdConf.h"
 
 #define ME "mxlAct"
 
@@ -624,55 +625,173 @@ SWL_TABLE(sRadCfgParamsActionMap,
               {"Country3",                       HAPD_ACTION_NEED_TOGGLE},
               ));
 
-static swl_rc_ne whm_mxl_hostapd_getRadParamAction(whm_mxl_hapd_action_e* pOutMappedAction, const char* paramName) {
-    whm_mxl_hapd_action_e* pMappedAction = (whm_mxl_hapd_action_e*) swl_table_getMatchingValue(&sRadCfgParamsActionMap, 1, 0, paramName);
-    ASSERTS_NOT_NULL(pMappedAction, SWL_RC_ERROR, ME, "NULL");
-    W_SWL_SETPTR(pOutMappedAction, *pMappedAction);
-    return SWL_RC_OK;
-}
-
 static whm_mxl_actionHandler_f whm_mxl_getActionHdlr(uint32_t action) {
     whm_mxl_actionHandler_f* pfActionHdlr = (whm_mxl_actionHandler_f*) swl_table_getMatchingValue(&sActionHandlers, 1, 0, &action);
     ASSERTS_NOT_NULL(pfActionHdlr, NULL, ME, "no internal hdlr defined for action(%d)", action);
     return *pfActionHdlr;
 }
 
+/*
+ * Params that hostapd applies at runtime on SET and only need the beacon to be refreshed.
+ * Their mapped heavy action is only used as fallback when the live SET fails.
+ */
+static const char* sLiveApplyParamPrefixes[] = {
+    "WmmAc",
+    "TxQueue",
+};
+
+static bool s_isLiveApplicableParam(const char* paramName) {
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(sLiveApplyParamPrefixes); i++) {
+        if(strncmp(paramName, sLiveApplyParamPrefixes[i], strlen(sLiveApplyParamPrefixes[i])) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Actions applied on the whole radio, covering the beacon update of all its BSSs */
+static bool s_isRadioWideAction(whm_mxl_hapd_action_e action) {
+    return (action >= HAPD_ACTION_NEED_TOGGLE);
+}
+
+static void s_runAction(T_Radio* pRad, T_AccessPoint* pAP, whm_mxl_hapd_action_e action) {
+    whm_mxl_actionHandler_f pfActionHdlr = whm_mxl_getActionHdlr(action);
+    ASSERTS_NOT_NULL(pfActionHdlr, , ME, "No handler for action(%d)", action);
+    swl_rc_ne rc = pfActionHdlr(pRad, pAP);
+    if(rc < SWL_RC_OK) {
+        SAH_TRACEZ_ERROR(ME, "%s: action(%d) failed rc(%d)", pRad->Name, action, rc);
+    }
+}
+
+/*
+ * End of commit window: run the minimal set of actions covering all collected param changes.
+ * A radio wide action is run once; otherwise each VAP gets its own highest pending action.
+ * Before a radio wide action, the conf of every VAP with a pending change is rewritten,
+ * as hostapd reloads it and would otherwise undo the params applied live.
+ */
+static void s_flushPendingActions_th(amxp_timer_t* timer _UNUSED, void* priv) {
+    T_Radio* pRad = (T_Radio*) priv;
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    whm_mxl_pendingActions_t* pPending = &pRadVendor->pendingActions;
+
+    whm_mxl_hapd_action_e maxAction = pPending->radAction;
+    T_AccessPoint* pAP = NULL;
+    wld_rad_forEachAp(pAP, pRad) {
+        mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+        if(pVapVendor != NULL) {
+            maxAction = SWL_MAX(maxAction, pVapVendor->pendingAction);
+        }
+    }
+    SAH_TRACEZ_INFO(ME, "%s: flush %u param changes (%u applied live), action=%d",
+                    pRad->Name, pPending->nrParams, pPending->nrLiveApplied, maxAction);
+
+    bool radioWide = s_isRadioWideAction(maxAction);
+    wld_rad_forEachAp(pAP, pRad) {
+        mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+        if(pVapVendor == NULL) {
+            continue;
+        }
+        whm_mxl_hapd_action_e vapAction = pVapVendor->pendingAction;
+        pVapVendor->pendingAction = HAPD_ACTION_NONE;
+        if(vapAction == HAPD_ACTION_NONE) {
+            continue;
+        }
+        if(radioWide) {
+            s_runAction(pRad, pAP, HAPD_ACTION_NEED_UPDATE_CONF);
+            continue;
+        }
+        s_runAction(pRad, pAP, vapAction);
+    }
+    if(radioWide) {
+        s_runAction(pRad, NULL, maxAction);
+    } else if(pPending->radAction != HAPD_ACTION_NONE) {
+        s_runAction(pRad, NULL, pPending->radAction);
+    }
+
+    pPending->radAction = HAPD_ACTION_NONE;
+    pPending->nrParams = 0;
+    pPending->nrLiveApplied = 0;
+}
+
+static swl_rc_ne s_addPendingAction(T_Radio* pRad, T_AccessPoint* pAP, whm_mxl_hapd_action_e action, bool liveApplied) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, SWL_RC_INVALID_PARAM, ME, "pRadVendor is NULL");
+    whm_mxl_pendingActions_t* pPending = &pRadVendor->pendingActions;
+    ASSERT_NOT_NULL(pPending->timer, SWL_RC_INVALID_STATE, ME, "%s: no commit window timer", pRad->Name);
+
+    if(pAP != NULL) {
+        mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+        ASSERT_NOT_NULL(pVapVendor, SWL_RC_INVALID_PARAM, ME, "pVapVendor is NULL");
+        pVapVendor->pendingAction = SWL_MAX(pVapVendor->pendingAction, action);
+    } else {
+        pPending->radAction = SWL_MAX(pPending->radAction, action);
+    }
+    pPending->nrParams++;
+    if(liveApplied) {
+        pPending->nrLiveApplied++;
+    }
+    amxp_timer_state_t state = pPending->timer->state;
+    if((state != amxp_timer_running) && (state != amxp_timer_started)) {
+        amxp_timer_start(pPending->timer, DM_EVENT_HOOK_TIMEOUT_MS);
+    }
+    return SWL_RC_OK;
+}
+
+void whm_mxl_pendingActions_init(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    pRadVendor->pendingActions.radAction = HAPD_ACTION_NONE;
+    amxp_timer_new(&pRadVendor->pendingActions.timer, s_flushPendingActions_th, pRad);
+}
+
+void whm_mxl_pendingActions_deinit(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    amxp_timer_delete(&pRadVendor->pendingActions.timer);
+    pRadVendor->pendingActions.timer = NULL;
+}
+
 /**
  * @brief Determine which actions to take when specific RADIO parameter is changed
  *
+ * The action is not run immediately but coalesced with the other changes of the commit window.
+ *
  * @param pRad radio
  * @param paramName parameter name in data model
- * @return return code of executed action.
+ * @return return code of action scheduling.
  */
 swl_rc_ne whm_mxl_determineRadParamAction(T_Radio* pRad, const char* paramName, const char* paramValue) {
     ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "No Radio Mapped");
     ASSERT_NOT_NULL(paramName, SWL_RC_INVALID_PARAM, ME, "paramName is NULL");
     whm_mxl_hapd_action_e action = HAPD_ACTION_NONE;
-    swl_rc_ne rc;
-    whm_mxl_actionHandler_f pfRadActionHdlr;
     bool ret = 0;
 
     /* First try setting parameter dynamically via ctrl interface before applying any action */
+    const whm_mxl_paramMapEntry_t* pMapEntry = whm_mxl_getParamMapEntry(paramName);
     T_AccessPoint* masterVap = wld_rad_getFirstVap(pRad);
     if (masterVap != NULL) {
         if(wld_wpaCtrlInterface_isReady(masterVap->wpaCtrlInterface) && (paramValue != NULL)) {
-            const char* pConfName= (char*) swl_table_getMatchingValue(&sVendorParamsOdlToConf, 1, 0, paramName);
+            const char* pConfName = (pMapEntry != NULL) ? pMapEntry->hapdName : NULL;
             ret = wld_ap_hostapd_setParamValue(masterVap, pConfName, paramValue, paramName);
             /* TO DO: maybe fallback to specific action if SET failed? */
         }
     }
 
-    whm_mxl_hostapd_getRadParamAction(&action, paramName);
+    if ((pMapEntry != NULL) && pMapEntry->hasRadAction) {
+        action = pMapEntry->radAction;
+    }
     ASSERT_NOT_EQUALS(action, HAPD_ACTION_ERROR, SWL_RC_INVALID_PARAM, ME, "Action HAPD_ACTION_ERROR");
     SAH_TRACEZ_INFO(ME, "%s: paramName=%s action=%d", pRad->Name, paramName, action);
     if ((pRad->status == RST_ERROR) || (pRad->status == RST_UNKNOWN)) {
         action = HAPD_ACTION_NONE;
         SAH_TRACEZ_INFO(ME, "%s: Invalid radio state(%d), forcing action HAPD_ACTION_NONE", pRad->Name, pRad->status);
     }
-    pfRadActionHdlr = whm_mxl_getActionHdlr(action);
-    ASSERTS_NOT_NULL(pfRadActionHdlr, SWL_RC_NOT_IMPLEMENTED, ME, "No handler for action(%d)", action);
-    rc = pfRadActionHdlr(pRad, NULL);
-    return rc;
+    ASSERTS_NOT_EQUALS(action, HAPD_ACTION_NONE, SWL_RC_OK, ME, "%s: no action for %s", pRad->Name, paramName);
+    return s_addPendingAction(pRad, NULL, action, false);
 }
 
 SWL_TABLE(sVapCfgParamsActionMap,
@@ -765,20 +884,128 @@ SWL_TABLE(sVapCfgParamsActionMap,
               {"EhtMacEpcsPrioAccess",          HAPD_ACTION_NEED_RECONF},
               ));
 
-static swl_rc_ne whm_mxl_hostapd_getVapParamAction(whm_mxl_hapd_action_e* pOutMappedAction, const char* paramName) {
-    whm_mxl_hapd_action_e* pMappedAction = (whm_mxl_hapd_action_e*) swl_table_getMatchingValue(&sVapCfgParamsActionMap, 1, 0, paramName);
-    ASSERTS_NOT_NULL(pMappedAction, SWL_RC_ERROR, ME, "NULL");
-    W_SWL_SETPTR(pOutMappedAction, *pMappedAction);
-    return SWL_RC_OK;
+/*
+ * Sorted index merging sVendorParamsOdlToConf, sRadCfgParamsActionMap and sVapCfgParamsActionMap.
+ * The tables above stay the single source of truth; the index is built once on first
+ * lookup, so that a parameter change costs one binary search instead of three linear scans.
+ */
+typedef struct {
+    whm_mxl_paramMapEntry_t entry;
+    uint32_t order; /* position in source tables, keeps first match semantics of swl_table */
+} whm_mxl_paramMapIndexEntry_t;
+
+static whm_mxl_paramMapIndexEntry_t* s_paramMapIndex = NULL;
+static size_t s_paramMapIndexSize = 0;
+static bool s_paramMapIndexBuilt = false;
+
+static int s_cmpParamMapIndexEntry(const void* a, const void* b) {
+    const whm_mxl_paramMapIndexEntry_t* pA = (const whm_mxl_paramMapIndexEntry_t*) a;
+    const whm_mxl_paramMapIndexEntry_t* pB = (const whm_mxl_paramMapIndexEntry_t*) b;
+    int ret = strcmp(pA->entry.odlName, pB->entry.odlName);
+    if(ret != 0) {
+        return ret;
+    }
+    return (pA->order > pB->order) - (pA->order < pB->order);
+}
+
+static int s_cmpParamMapKey(const void* key, const void* elem) {
+    return strcmp((const char*) key, ((const whm_mxl_paramMapIndexEntry_t*) elem)->entry.odlName);
+}
+
+static void s_addParamMapTable(swl_table_t* pTable, whm_mxl_paramMapIndexEntry_t* pIndex, size_t* pNr, bool isConf, bool isVap) {
+    for(size_t i = 0; i < pTable->nrTuples; i++) {
+        const char** pName = (const char**) swl_table_getValue(pTable, i, 0);
+        void* pValue = swl_table_getValue(pTable, i, 1);
+        if((pName == NULL) || (*pName == NULL) || (pValue == NULL)) {
+            continue;
+        }
+        whm_mxl_paramMapIndexEntry_t* pIdx = &pIndex[*pNr];
+        pIdx->entry.odlName = *pName;
+        pIdx->entry.radAction = HAPD_ACTION_NONE;
+        pIdx->entry.vapAction = HAPD_ACTION_NONE;
+        pIdx->order = *pNr;
+        if(isConf) {
+            pIdx->entry.hapdName = *(const char**) pValue;
+        } else if(isVap) {
+            pIdx->entry.vapAction = *(whm_mxl_hapd_action_e*) pValue;
+            pIdx->entry.hasVapAction = true;
+        } else {
+            pIdx->entry.radAction = *(whm_mxl_hapd_action_e*) pValue;
+            pIdx->entry.hasRadAction = true;
+        }
+        (*pNr)++;
+    }
+}
+
+/* Merge the entries of the same ODL name, first definition of each attribute wins */
+static void s_mergeParamMapEntry(whm_mxl_paramMapEntry_t* pDst, const whm_mxl_paramMapEntry_t* pSrc) {
+    if((pDst->hapdName == NULL) && (pSrc->hapdName != NULL)) {
+        pDst->hapdName = pSrc->hapdName;
+    }
+    if(!pDst->hasRadAction && pSrc->hasRadAction) {
+        pDst->radAction = pSrc->radAction;
+        pDst->hasRadAction = true;
+    }
+    if(!pDst->hasVapAction && pSrc->hasVapAction) {
+        pDst->vapAction = pSrc->vapAction;
+        pDst->hasVapAction = true;
+    }
+}
+
+static void s_buildParamMapIndex(void) {
+    s_paramMapIndexBuilt = true;
+    size_t maxEntries = sVendorParamsOdlToConf.nrTuples + sRadCfgParamsActionMap.nrTuples + sVapCfgParamsActionMap.nrTuples;
+    ASSERT_NOT_EQUALS(maxEntries, 0, , ME, "No parameter mapping defined");
+    whm_mxl_paramMapIndexEntry_t* pIndex = calloc(maxEntries, sizeof(whm_mxl_paramMapIndexEntry_t));
+    ASSERT_NOT_NULL(pIndex, , ME, "Fail to allocate parameter mapping index");
+
+    size_t nr = 0;
+    s_addParamMapTable(&sVendorParamsOdlToConf, pIndex, &nr, true, false);
+    s_addParamMapTable(&sRadCfgParamsActionMap, pIndex, &nr, false, false);
+    s_addParamMapTable(&sVapCfgParamsActionMap, pIndex, &nr, false, true);
+    qsort(pIndex, nr, sizeof(whm_mxl_paramMapIndexEntry_t), s_cmpParamMapIndexEntry);
+
+    size_t nrUnique = 0;
+    for(size_t i = 0; i < nr; i++) {
+        if((nrUnique > 0) && swl_str_matches(pIndex[nrUnique - 1].entry.odlName, pIndex[i].entry.odlName)) {
+            s_mergeParamMapEntry(&pIndex[nrUnique - 1].entry, &pIndex[i].entry);
+            continue;
+        }
+        pIndex[nrUnique++] = pIndex[i];
+    }
+    s_paramMapIndex = pIndex;
+    s_paramMapIndexSize = nrUnique;
+    SAH_TRACEZ_INFO(ME, "Parameter mapping index built: %zu entries (%zu table rows)", nrUnique, nr);
+}
+
+/**
+ * @brief Look up the hostapd mapping of a vendor ODL parameter
+ *
+ * @param paramName parameter name in data model
+ * @return mapping entry with the hostapd conf name and the radio / vap actions,
+ *         or NULL when the parameter is not mapped at all.
+ */
+const whm_mxl_paramMapEntry_t* whm_mxl_getParamMapEntry(const char* paramName) {
+    ASSERT_NOT_NULL(paramName, NULL, ME, "paramName is NULL");
+    if(!s_paramMapIndexBuilt) {
+        s_buildParamMapIndex();
+    }
+    ASSERTS_NOT_NULL(s_paramMapIndex, NULL, ME, "No parameter mapping index");
+    whm_mxl_paramMapIndexEntry_t* pIdx = bsearch(paramName, s_paramMapIndex, s_paramMapIndexSize,
+                                                 sizeof(whm_mxl_paramMapIndexEntry_t), s_cmpParamMapKey);
+    ASSERTS_NOT_NULL(pIdx, NULL, ME, "%s: param not mapped", paramName);
+    return &pIdx->entry;
 }
 
 /**
  * @brief Determine which actions to take when specific VAP parameter is changed
+ * Params applied live by hostapd only need a beacon update when the SET succeeded.
+ * The action is coalesced with the other changes of the commit window.
  *
  * @param pAP accesspoint
  * @param paramName parameter name in data model
  * @param paramValue param value represented as a string
- * @return return code of executed action.
+ * @return return code of action scheduling.
  */
 swl_rc_ne whm_mxl_determineVapParamAction(T_AccessPoint* pAP, const char* paramName, const char* paramValue) {
     ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "No pAP Mapped");
@@ -786,19 +1013,24 @@ swl_rc_ne whm_mxl_determineVapParamAction(T_AccessPoint* pAP, const char* paramN
     T_Radio* pRad = pAP->pRadio;
     ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "No Radio Mapped");
     whm_mxl_hapd_action_e action = HAPD_ACTION_NONE;
-    swl_rc_ne rc;
-    whm_mxl_actionHandler_f pfVapActionHdlr;
     bool ret = 0;
 
     /* First try setting parameter dynamically via ctrl interface before applying any action */
+    const whm_mxl_paramMapEntry_t* pMapEntry = whm_mxl_getParamMapEntry(paramName);
     if(wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface) && (paramValue != NULL)) {
-        const char* pConfName= (char*) swl_table_getMatchingValue(&sVendorParamsOdlToConf, 1, 0, paramName);
+        const char* pConfName = (pMapEntry != NULL) ? pMapEntry->hapdName : NULL;
         ret = wld_ap_hostapd_setParamValue(pAP, pConfName, paramValue, paramName);
     }
 
-    whm_mxl_hostapd_getVapParamAction(&action, paramName);
+    if ((pMapEntry != NULL) && pMapEntry->hasVapAction) {
+        action = pMapEntry->vapAction;
+    }
     ASSERT_NOT_EQUALS(action, HAPD_ACTION_ERROR, SWL_RC_INVALID_PARAM, ME, "Action HAPD_ACTION_ERROR");
-    SAH_TRACEZ_INFO(ME, "%s: paramName=%s action=%d", pAP->alias, paramName, action);
+    bool liveApplied = (ret && s_isLiveApplicableParam(paramName) && (action > HAPD_ACTION_NEED_UPDATE_BEACON));
+    if (liveApplied) {
+        action = HAPD_ACTION_NEED_UPDATE_BEACON;
+    }
+    SAH_TRACEZ_INFO(ME, "%s: paramName=%s action=%d live=%d", pAP->alias, paramName, action, liveApplied);
     if ((pRad->status == RST_ERROR) || (pRad->status == RST_UNKNOWN)) {
         action = HAPD_ACTION_NONE;
         SAH_TRACEZ_INFO(ME, "%s: Invalid radio state(%d), forcing action HAPD_ACTION_NONE", pRad->Name, pRad->status);
@@ -806,10 +1038,8 @@ swl_rc_ne whm_mxl_determineVapParamAction(T_AccessPoint* pAP, const char* paramN
         action = HAPD_ACTION_NEED_UPDATE_CONF;
         SAH_TRACEZ_INFO(ME, "%s: AP state(%d), forcing action HAPD_ACTION_NEED_UPDATE_CONF", pRad->Name, pAP->status);
     }
-    pfVapActionHdlr = whm_mxl_getActionHdlr(action);
-    ASSERTS_NOT_NULL(pfVapActionHdlr, SWL_RC_NOT_IMPLEMENTED, ME, "No handler for action(%d)", action);
-    rc = pfVapActionHdlr(pRad, pAP);
-    return rc;
+    ASSERTS_NOT_EQUALS(action, HAPD_ACTION_NONE, SWL_RC_OK, ME, "%s: no action for %s", pAP->alias, paramName);
+    return s_addPendingAction(pRad, pAP, action, liveApplied);
 }
 
 static swl_rc_ne s_doEpUpdate(T_Radio* pRad _UNUSED, T_EndPoint* pEP) {
@@ -1183,24 +1413,154 @@ swl_rc_ne whm_mxl_toggleWPA3PersonalCompatibility(T_AccessPoint* pAP) {
     return SWL_RC_OK;
 }
 
-static bool s_isParamChanged(swl_mapChar_t* pCurrVapParams,
-                              const char* param, const char* newValue) {
-    ASSERTS_NOT_NULL(param, false, ME, "NULL");
-    ASSERTS_NOT_NULL(pCurrVapParams, false, ME, "NULL");
-    const char* oldValue = swl_mapChar_get(pCurrVapParams, (char*) param);
+/*
+ * Hostapd config shadow: keeps, per VAP, the last written value of the keys
+ * used for config flow selection, so that the decision does not need to reload
+ * and parse the hostapd config file, nor to generate the whole VAP config.
+ * VAP config maps are also generated without writing the config file,
+ * so the shadow is only recorded while the config file is written,
+ * and it is reloaded from the file when someone else wrote it.
+ */
+static const char* sCfgShadowKeys[] = {
+    "ssid", "ignore_broadcast_ssid", "wpa", "wpa_group_rekey", "wps_state"
+};
+
+/* Set while the hostapd config file is written */
+static bool s_cfgShadowRecording = false;
+
+/**
+ * @brief Record the VAP config maps generated from now on into the config shadow
+ *
+ * @param recording true just before writing the hostapd config file, false once written
+ * @return None
+ */
+void whm_mxl_cfgShadow_setRecording(bool recording) {
+    s_cfgShadowRecording = recording;
+}
+
+static void s_recordCfgShadow(mxl_VapVendorData_t* pVapVendor, swl_mapChar_t* configMap) {
+    for (uint32_t i = 0; i < SWL_ARRAY_SIZE(sCfgShadowKeys); i++) {
+        const char* value = (configMap != NULL) ? swl_mapChar_get(configMap, (char*) sCfgShadowKeys[i]) : NULL;
+        amxc_var_t* pEntry = amxc_var_get_key(&pVapVendor->cfgShadow, sCfgShadowKeys[i], AMXC_VAR_FLAG_DEFAULT);
+        if (value == NULL) {
+            amxc_var_delete(&pEntry);
+        } else if (pEntry != NULL) {
+            amxc_var_set(cstring_t, pEntry, value);
+        } else {
+            amxc_var_add_key(cstring_t, &pVapVendor->cfgShadow, sCfgShadowKeys[i], value);
+        }
+    }
+}
+
+/**
+ * @brief Update the hostapd config shadow of a VAP from its generated config map
+ *
+ * Ignored unless the map is being written to the hostapd config file.
+ *
+ * @param pAP accesspoint
+ * @param configMap VAP config map
+ * @return None
+ */
+void whm_mxl_cfgShadow_update(T_AccessPoint* pAP, swl_mapChar_t* configMap) {
+    ASSERTS_TRUE(s_cfgShadowRecording, , ME, "config file not written");
+    ASSERT_NOT_NULL(configMap, , ME, "configMap is NULL");
+    mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+    ASSERT_NOT_NULL(pVapVendor, , ME, "pVapVendor is NULL");
+    s_recordCfgShadow(pVapVendor, configMap);
+}
+
+/*
+ * Reload the config shadow of all VAPs of the radio from the hostapd config file.
+ * The file identity is saved first, so that a write racing with the load is caught on the next check.
+ */
+static bool s_loadCfgShadow(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad->hostapd, false, ME, "%s: no hostapd", pRad->Name);
+    ASSERTI_TRUE(whm_mxl_hapdConf_sync(pRad), false, ME, "%s: no readable config file", pRad->Name);
+    wld_hostapd_config_t* pConfig = NULL;
+    ASSERTI_TRUE(wld_hostapd_loadConfig(&pConfig, pRad->hostapd->cfgFile), false, ME, "%s: fail to load config", pRad->Name);
+    T_AccessPoint* pAP = NULL;
+    wld_rad_forEachAp(pAP, pRad) {
+        mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+        if ((pVapVendor == NULL) || (pAP->pSSID == NULL) || whm_mxl_utils_isDummyVap(pAP)) {
+            continue;
+        }
+        s_recordCfgShadow(pVapVendor, wld_hostapd_getConfigMapByBssid(pConfig, (swl_macBin_t*) pAP->pSSID->BSSID));
+    }
+    wld_hostapd_deleteConfig(pConfig);
+    SAH_TRACEZ_INFO(ME, "%s: config shadow reloaded from %s", pRad->Name, pRad->hostapd->cfgFile);
+    return true;
+}
+
+/**
+ * @brief Get the last written value of a hostapd config key of a VAP
+ *
+ * @param pAP accesspoint
+ * @param key hostapd config key
+ * @return key value, NULL if not written
+ */
+const char* whm_mxl_cfgShadow_get(T_AccessPoint* pAP, const char* key) {
+    mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+    ASSERT_NOT_NULL(pVapVendor, NULL, ME, "pVapVendor is NULL");
+    return GET_CHAR(&pVapVendor->cfgShadow, key);
+}
+
+/**
+ * @brief Check if new value of a hostapd config key differs from the last written one
+ *
+ * @param pAP accesspoint
+ * @param key hostapd config key
+ * @param newValue new key value
+ * @return true if value changed
+ */
+bool whm_mxl_cfgShadow_isParamChanged(T_AccessPoint* pAP, const char* key, const char* newValue) {
+    ASSERTS_NOT_NULL(key, false, ME, "NULL");
+    const char* oldValue = whm_mxl_cfgShadow_get(pAP, key);
     ASSERTS_FALSE(swl_str_matches(oldValue, newValue), false, ME, "same value");
     return true;
 }
 
-static bool s_isAnyMultipleParamsChanged(swl_mapChar_t* pCurrVapParams, swl_mapChar_t* pNewVapParams,
-                                    const char* params[], uint32_t nParams) {
-    ASSERTS_NOT_NULL(pCurrVapParams, false, ME, "NULL");
-    ASSERTS_NOT_NULL(pNewVapParams, false, ME, "NULL");
-    bool changed = false;
-    for (uint32_t i = 0; i < nParams; i++) {
-        changed |= s_isParamChanged(pCurrVapParams, params[i], swl_mapChar_get(pNewVapParams, (char*) params[i]));
+static bool s_isCfgShadowParamChangedInt(T_AccessPoint* pAP, const char* key, int32_t newValue) {
+    const char* oldValue = whm_mxl_cfgShadow_get(pAP, key);
+    return (((oldValue != NULL) ? atoi(oldValue) : 0) != newValue);
+}
+
+/* The config file may have been written without us, or our last write failed: reload the shadow then */
+static bool s_isCfgShadowValid(T_AccessPoint* pAP) {
+    mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+    ASSERTS_NOT_NULL(pVapVendor, false, ME, "NULL");
+    if (!whm_mxl_hapdConf_isCurrent(pAP->pRadio)) {
+        ASSERTS_TRUE(s_loadCfgShadow(pAP->pRadio), false, ME, "%s: no config shadow", pAP->alias);
     }
-    return changed;
+    ASSERTS_FALSE(amxc_htable_is_empty(amxc_var_constcast(amxc_htable_t, &pVapVendor->cfgShadow)), false, ME, "empty");
+    return true;
+}
+
+/* hostapd "wpa" value of the security mode, as the config generator sets it */
+static int32_t s_getWpaValue(T_AccessPoint* pAP) {
+    mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+    if ((pVapVendor != NULL) && pVapVendor->EnableWPA3PersonalCompatibility) {
+        return 2;
+    }
+    switch (pAP->secModeEnabled) {
+        case SWL_SECURITY_APMODE_NONE:
+        case SWL_SECURITY_APMODE_WEP64:
+        case SWL_SECURITY_APMODE_WEP128:
+        case SWL_SECURITY_APMODE_WEP128IV:
+            return 0;
+        case SWL_SECURITY_APMODE_WPA_P:
+        case SWL_SECURITY_APMODE_WPA_E:
+            return 1;
+        case SWL_SECURITY_APMODE_WPA_WPA2_P:
+        case SWL_SECURITY_APMODE_WPA_WPA2_E:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+static bool s_isSsidHidden(const char* ignoreBcastSsid) {
+    /* Any non zero ignore_broadcast_ssid value hides the SSID */
+    return ((ignoreBcastSsid != NULL) && (atoi(ignoreBcastSsid) != 0));
 }
 
 static whm_mxl_config_flow_e s_chooseGeneralConfigFlow(T_AccessPoint* pAP) {
@@ -1213,38 +1573,23 @@ static whm_mxl_config_flow_e s_chooseSsidConfigFlow(T_AccessPoint* pAP) {
     ASSERT_NOT_NULL(pAP, WHM_MXL_CONFIG_FLOW_GENERIC, ME, "No pAP Mapped");
     T_Radio* pRad = pAP->pRadio;
     ASSERT_NOT_NULL(pRad, WHM_MXL_CONFIG_FLOW_GENERIC, ME, "No pRad Mapped");
+    ASSERT_NOT_NULL(pAP->pSSID, WHM_MXL_CONFIG_FLOW_GENERIC, ME, "No pSSID Mapped");
     /* Schedule reconf only when hostapd is running */
     ASSERTI_TRUE(wld_secDmn_isEnabled(pRad->hostapd), WHM_MXL_CONFIG_FLOW_GENERIC, ME, "hostapd is not running");
-    wld_hostapd_config_t* pCurrentConfig = NULL;
-    bool ret = wld_hostapd_loadConfig(&pCurrentConfig, pRad->hostapd->cfgFile);
-    ASSERTI_TRUE(ret, WHM_MXL_CONFIG_FLOW_GENERIC, ME, "no saved current config");
-    swl_mapChar_t* pCurrVapParams = wld_hostapd_getConfigMapByBssid(pCurrentConfig, (swl_macBin_t*) pAP->pSSID->BSSID);
-    swl_mapChar_t newVapParams;
-    swl_mapChar_t* pNewVapParams = &newVapParams;
-    swl_mapChar_init(pNewVapParams);
-    wld_hostapd_cfgFile_setVapConfig(pAP, pNewVapParams, (swl_mapChar_t*) NULL);
+    ASSERTI_TRUE(s_isCfgShadowValid(pAP), WHM_MXL_CONFIG_FLOW_GENERIC, ME, "no saved current config");
+
+    /* Only the keys of the decision are derived from the VAP settings */
+    bool ssidChanged = whm_mxl_cfgShadow_isParamChanged(pAP, "ssid", pAP->pSSID->SSID);
+    bool isHidden = !pAP->SSIDAdvertisementEnabled;
+    bool wasHidden = s_isSsidHidden(whm_mxl_cfgShadow_get(pAP, "ignore_broadcast_ssid"));
 
     /* SSID requires extra checks - handle it first */
-    const char* ssidVapParams[] = {
-        "ssid"
-    };
-    bool ssidChanged = s_isAnyMultipleParamsChanged(pCurrVapParams, pNewVapParams, ssidVapParams, SWL_ARRAY_SIZE(ssidVapParams));
-    if (ssidChanged && !pAP->SSIDAdvertisementEnabled) {
+    if (ssidChanged && isHidden) {
         SAH_TRACEZ_INFO(ME, "%s: SSID changed with hidden ssid enabled - need reconf", pAP->alias);
-        swl_mapChar_cleanup(pNewVapParams);
-        wld_hostapd_deleteConfig(pCurrentConfig);
         return WHM_MXL_CONFIG_FLOW_RECONF;
     }
 
-    const char* ssidRelatedVapParams[] = {
-        "ignore_broadcast_ssid"
-    };
-    bool anyChanged = s_isAnyMultipleParamsChanged(pCurrVapParams, pNewVapParams, ssidRelatedVapParams, SWL_ARRAY_SIZE(ssidRelatedVapParams));
-
-    swl_mapChar_cleanup(pNewVapParams);
-    wld_hostapd_deleteConfig(pCurrentConfig);
-
-    return (anyChanged ? WHM_MXL_CONFIG_FLOW_RECONF : WHM_MXL_CONFIG_FLOW_GENERIC);
+    return ((isHidden != wasHidden) ? WHM_MXL_CONFIG_FLOW_RECONF : WHM_MXL_CONFIG_FLOW_GENERIC);
 }
 
 static whm_mxl_config_flow_e s_chooseSecurityConfigFlow(T_AccessPoint* pAP) {
@@ -1253,22 +1598,15 @@ static whm_mxl_config_flow_e s_chooseSecurityConfigFlow(T_AccessPoint* pAP) {
     ASSERT_NOT_NULL(pRad, WHM_MXL_CONFIG_FLOW_GENERIC, ME, "No pRad Mapped");
     /* Schedule reconf only when hostapd is running */
     ASSERTI_TRUE(wld_secDmn_isEnabled(pRad->hostapd), WHM_MXL_CONFIG_FLOW_GENERIC, ME, "hostapd is not running");
-    wld_hostapd_config_t* pCurrentConfig = NULL;
-    bool ret = wld_hostapd_loadConfig(&pCurrentConfig, pRad->hostapd->cfgFile);
-    ASSERTI_TRUE(ret, WHM_MXL_CONFIG_FLOW_GENERIC, ME, "no saved current config");
-    swl_mapChar_t* pCurrVapParams = wld_hostapd_getConfigMapByBssid(pCurrentConfig, (swl_macBin_t*) pAP->pSSID->BSSID);
-    swl_mapChar_t newVapParams;
-    swl_mapChar_t* pNewVapParams = &newVapParams;
-    swl_mapChar_init(pNewVapParams);
-    wld_hostapd_cfgFile_setVapConfig(pAP, pNewVapParams, (swl_mapChar_t*) NULL);
+    ASSERTI_TRUE(s_isCfgShadowValid(pAP), WHM_MXL_CONFIG_FLOW_GENERIC, ME, "no saved current config");
 
-    const char* secVapParams[] = {
-        "wpa", "wpa_group_rekey", "wps_state"
-    };
-    bool anyChanged = s_isAnyMultipleParamsChanged(pCurrVapParams, pNewVapParams, secVapParams, SWL_ARRAY_SIZE(secVapParams));
-
-    swl_mapChar_cleanup(pNewVapParams);
-    wld_hostapd_deleteConfig(pCurrentConfig);
+    /* Only the keys of the decision are derived from the VAP settings */
+    int32_t wpa = s_getWpaValue(pAP);
+    bool anyChanged = s_isCfgShadowParamChangedInt(pAP, "wpa", wpa);
+    if (wpa != 0) {
+        anyChanged |= s_isCfgShadowParamChangedInt(pAP, "wpa_group_rekey", pAP->rekeyingInterval);
+    }
+    anyChanged |= s_isCfgShadowParamChangedInt(pAP, "wps_state", pAP->WPS_Enable ? (pAP->WPS_Configured ? 2 : 1) : 0);
 
     return (anyChanged ? WHM_MXL_CONFIG_FLOW_RECONF : WHM_MXL_CONFIG_FLOW_GENERIC);
 }
@@ -0,0 +1,187 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : whm_mxl_chanSurvey.c                                  *
+*         Description  : Channel survey fed by driver channel data events      *
+*                                                                              *
+*  *****************************************************************************/
+
+#include "swl/swl_common.h"
+#include "wld/wld.h"
+#include "wld/wld_radio.h"
+
+#include "whm_mxl_chanSurvey.h"
+#include "whm_mxl_rad.h"
+
+#define ME "mxlSurv"
+
+/* Minimum weight of a new sample, so that bursts of samples within one second still count */
+#define MXL_CHAN_SURVEY_MIN_NEW_WEIGHT 0.125f
+
+static whm_mxl_chanSurvey_t* s_getSurvey(T_Radio* pRad) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, NULL, ME, "NULL");
+    return &pRadVendor->chanSurvey;
+}
+
+/* Weight left to the past samples after elapsed seconds: 2^(-elapsed / halfLife), linear within a half life */
+static float s_getDecayWeight(uint32_t elapsed, uint32_t halfLife) {
+    uint32_t nrHalfLives = elapsed / halfLife;
+    if(nrHalfLives >= 24) {
+        return 0;
+    }
+    float weight = 1.0f / (float) (1U << nrHalfLives);
+    float fraction = (float) (elapsed % halfLife) / (float) halfLife;
+    return SWL_MIN(weight * (1.0f - (fraction / 2)), 1.0f - MXL_CHAN_SURVEY_MIN_NEW_WEIGHT);
+}
+
+static whm_mxl_chanSurveyRecord_t* s_findRecord(whm_mxl_chanSurvey_t* pSurvey, uint32_t channel) {
+    ASSERTS_TRUE(channel < SWL_ARRAY_SIZE(pSurvey->index), NULL, ME, "invalid channel %u", channel);
+    uint8_t slot = pSurvey->index[channel];
+    return (slot != 0) ? &pSurvey->records[slot - 1] : NULL;
+}
+
+/* Record of a newly surveyed channel, replacing the least recently measured channel when full */
+static whm_mxl_chanSurveyRecord_t* s_addRecord(whm_mxl_chanSurvey_t* pSurvey, uint32_t channel) {
+    ASSERT_TRUE(channel < SWL_ARRAY_SIZE(pSurvey->index), NULL, ME, "invalid channel %u", channel);
+    uint32_t slot = pSurvey->nrRecords;
+    if(slot < MXL_CHAN_SURVEY_MAX_RECORDS) {
+        pSurvey->nrRecords++;
+    } else {
+        slot = 0;
+        for(uint32_t i = 1; i < MXL_CHAN_SURVEY_MAX_RECORDS; i++) {
+            if(pSurvey->records[i].lastTime < pSurvey->records[slot].lastTime) {
+                slot = i;
+            }
+        }
+        pSurvey->index[pSurvey->records[slot].channel] = 0;
+        pSurvey->nrEvicted++;
+    }
+    whm_mxl_chanSurveyRecord_t* pRecord = &pSurvey->records[slot];
+    memset(pRecord, 0, sizeof(*pRecord));
+    pRecord->channel = channel;
+    pSurvey->index[channel] = slot + 1;
+    return pRecord;
+}
+
+/**
+ * @brief Merge one channel measurement into the survey of the radio
+ *
+ * The record of the channel keeps a time decayed average of the measurements,
+ * so that channel quality can be read without a new off-channel scan.
+ *
+ * @param pRad radio that reported the measurement
+ * @param pSample channel measurement
+ */
+void whm_mxl_chanSurvey_addSample(T_Radio* pRad, const whm_mxl_chanSurveySample_t* pSample) {
+    ASSERT_NOT_NULL(pSample, , ME, "NULL");
+    whm_mxl_chanSurvey_t* pSurvey = s_getSurvey(pRad);
+    ASSERT_NOT_NULL(pSurvey, , ME, "NULL");
+
+    swl_timeMono_t now = swl_time_getMonoSec();
+    whm_mxl_chanSurveyRecord_t* pRecord = s_findRecord(pSurvey, pSample->channel);
+    if(pRecord == NULL) {
+        pRecord = s_addRecord(pSurvey, pSample->channel);
+        ASSERT_NOT_NULL(pRecord, , ME, "%s: fail to survey channel %u", pRad->Name, pSample->channel);
+        pRecord->firstTime = now;
+        pRecord->load = pSample->load;
+        pRecord->noise = pSample->noise;
+        pRecord->interference = pSample->interference;
+        pRecord->nrBss = pSample->nrBss;
+    } else {
+        float weight = s_getDecayWeight(now - pRecord->lastTime, SWL_MAX(pSurvey->halfLife, 1U));
+        pRecord->load = (weight * pRecord->load) + ((1.0f - weight) * pSample->load);
+        pRecord->noise = (weight * pRecord->noise) + ((1.0f - weight) * pSample->noise);
+        pRecord->interference = (weight * pRecord->interference) + ((1.0f - weight) * pSample->interference);
+        pRecord->nrBss = (weight * pRecord->nrBss) + ((1.0f - weight) * pSample->nrBss);
+    }
+    pRecord->freq = pSample->freq;
+    pRecord->bandwidth = pSample->bandwidth;
+    pRecord->last = *pSample;
+    pRecord->lastTime = now;
+    pRecord->nrSamples++;
+    pSurvey->nrSamples++;
+}
+
+void whm_mxl_chanSurvey_init(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    whm_mxl_chanSurvey_t* pSurvey = s_getSurvey(pRad);
+    ASSERT_NOT_NULL(pSurvey, , ME, "NULL");
+    memset(pSurvey, 0, sizeof(*pSurvey));
+    pSurvey->halfLife = MXL_CHAN_SURVEY_DEF_HALF_LIFE_SEC;
+    pSurvey->maxAge = MXL_CHAN_SURVEY_DEF_MAX_AGE_SEC;
+}
+
+static void s_setChanSurveyConf_ocf(void* priv _UNUSED, amxd_object_t* object, const amxc_var_t* const newParamValues _UNUSED) {
+    SAH_TRACEZ_IN(ME);
+    /* WiFi.Radio.{}.Vendor.ChannelSurvey. */
+    amxd_object_t* radObj = amxd_object_get_parent(amxd_object_get_parent(object));
+    T_Radio* pRad = wld_rad_fromObj(radObj);
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    whm_mxl_chanSurvey_t* pSurvey = s_getSurvey(pRad);
+    ASSERT_NOT_NULL(pSurvey, , ME, "NULL");
+
+    pSurvey->halfLife = SWL_MAX(amxd_object_get_value(uint32_t, object, "HalfLife", NULL), 1U);
+    pSurvey->maxAge = SWL_MAX(amxd_object_get_value(uint32_t, object, "MaxAge", NULL), 1U);
+    SAH_TRACEZ_INFO(ME, "%s: channel survey half life %u s max age %u s", pRad->Name, pSurvey->halfLife, pSurvey->maxAge);
+
+    SAH_TRACEZ_OUT(ME);
+}
+
+SWLA_DM_HDLRS(sChanSurveyDmHdlrs, ARR(), .objChangedCb = s_setChanSurveyConf_ocf);
+
+void _whm_mxl_chanSurvey_setConf_ocf(const char* const sig_name,
+                                     const amxc_var_t* const data,
+                                     void* const priv) {
+    swla_dm_procObjEvtOfLocalDm(&sChanSurveyDmHdlrs, sig_name, data, priv);
+}
+
+amxd_status_t _whm_mxl_chanSurvey_getSurvey(amxd_object_t* object,
+                                            amxd_function_t* func _UNUSED,
+                                            amxc_var_t* args _UNUSED,
+                                            amxc_var_t* retval) {
+    /* WiFi.Radio.{}.Vendor. */
+    T_Radio* pRad = wld_rad_fromObj(amxd_object_get_parent(object));
+    ASSERT_NOT_NULL(pRad, amxd_status_unknown_error, ME, "No Radio Mapped");
+    whm_mxl_chanSurvey_t* pSurvey = s_getSurvey(pRad);
+    ASSERT_NOT_NULL(pSurvey, amxd_status_unknown_error, ME, "NULL");
+
+    swl_timeMono_t now = swl_time_getMonoSec();
+    amxc_var_set_type(retval, AMXC_VAR_ID_HTABLE);
+    amxc_var_add_key(uint32_t, retval, "HalfLife", pSurvey->halfLife);
+    amxc_var_add_key(uint32_t, retval, "MaxAge", pSurvey->maxAge);
+    amxc_var_add_key(uint64_t, retval, "NrSamples", pSurvey->nrSamples);
+    amxc_var_add_key(uint64_t, retval, "NrEvicted", pSurvey->nrEvicted);
+    amxc_var_t* pChanList = amxc_var_add_key(amxc_llist_t, retval, "Channels", NULL);
+    /* list the channels in increasing order */
+    for(uint32_t channel = 0; channel < SWL_ARRAY_SIZE(pSurvey->index); channel++) {
+        whm_mxl_chanSurveyRecord_t* pRecord = s_findRecord(pSurvey, channel);
+        if(pRecord == NULL) {
+            continue;
+        }
+        uint32_t age = now - pRecord->lastTime;
+        amxc_var_t* pChanMap = amxc_var_add(amxc_htable_t, pChanList, NULL);
+        amxc_var_add_key(uint32_t, pChanMap, "Channel", pRecord->channel);
+        amxc_var_add_key(uint32_t, pChanMap, "Frequency", pRecord->freq);
+        amxc_var_add_key(int32_t, pChanMap, "Bandwidth", pRecord->bandwidth);
+        amxc_var_add_key(int32_t, pChanMap, "Load", (int32_t) pRecord->load);
+        amxc_var_add_key(int32_t, pChanMap, "Noise", (int32_t) pRecord->noise);
+        amxc_var_add_key(int32_t, pChanMap, "Interference", (int32_t) pRecord->interference);
+        amxc_var_add_key(int32_t, pChanMap, "BssCount", (int32_t) pRecord->nrBss);
+        amxc_var_add_key(int32_t, pChanMap, "LastLoad", pRecord->last.load);
+        amxc_var_add_key(int32_t, pChanMap, "LastNoise", pRecord->last.noise);
+        amxc_var_add_key(int32_t, pChanMap, "LastInterference", pRecord->last.interference);
+        amxc_var_add_key(int32_t, pChanMap, "LastBssCount", pRecord->last.nrBss);
+        amxc_var_add_key(uint32_t, pChanMap, "Samples", pRecord->nrSamples);
+        amxc_var_add_key(uint32_t, pChanMap, "Age", age);
+        amxc_var_add_key(bool, pChanMap, "Stale", (age > pSurvey->maxAge));
+    }
+    return amxd_status_ok;
+}
@@ -28,156 +28,821 @@
 
 #include "whm_mxl_csi.h"
 #include "whm_mxl_vap.h"
+#include "whm_mxl_rad.h"
+#include "whm_mxl_nlVendor.h"
+#include "whm_mxl_vendorQueue.h"
 
 #define ME "mxlCsi"
 
-whm_mxl_connection_t conn = {.serverfd = -1, .clientfd = -1};
+#define MXL_CSI_MAX_SUBSCRIBERS         8
+#define MXL_CSI_SUBSCRIBER_QUEUE_LEN    32
 
-/**
- * After adding a CSI client for a specific MAC address and monitor interval,
- * the Maxlinear WiFi driver sends back periodically the CSI raw data over a specific Netlink vendor stats event.
- * This function is called from the event parser to forward the received CSI stats to the opened unix socket stream,
- * which is used by third-party Apps to manage WiFi sensing data raw.
+/* Sampling rate controller */
+#define MXL_CSI_RATE_CTRL_PERIOD_MS     1000
+#define MXL_CSI_RATE_DROP_HIGH_PERMILLE 50  /* decrease above 5% dropped frames of the radio */
+#define MXL_CSI_RATE_STEP               2   /* Hz added per tick while the subscribers keep up */
+
+/* Wire format negotiation */
+#define MXL_CSI_WIRE_NEGO_TIMEOUT_MS    200 /* subscribers silent for that long after connecting keep raw mode */
+#define MXL_CSI_WIRE_MAX_RADIOS         8   /* radios with inter-frame delta state */
+#define MXL_CSI_WIRE_DEF_KEY_INTERVAL   16
+#define MXL_CSI_RLE_ZERO_RUN            0x80
+#define MXL_CSI_RLE_MAX_RUN             128
+
+typedef struct {
+    uint32_t len;
+    uint8_t radioIndex;         /* radio of the CSI event, UINT8_MAX for a reply */
+    uint8_t data[sizeof(whm_mxl_csiWireHdr_t) + sizeof(wifi_csi_driver_nl_event_data_t)];
+} whm_mxl_csiFrame_t;
+
+typedef struct {
+    int fd;
+    whm_mxl_csiFrame_t* queue;  /* ring buffer of MXL_CSI_SUBSCRIBER_QUEUE_LEN frames */
+    uint32_t head;              /* index of the oldest queued frame */
+    uint32_t count;             /* number of queued frames */
+    uint32_t offset;            /* bytes of the oldest frame already sent */
+    bool waitWrite;             /* waiting for the socket to be writable */
+    uint64_t sentFrames;
+    uint64_t droppedFrames;
+    swl_timeSpecMono_t connectTs;
+    bool configured;            /* wire format settled, later requests are rejected */
+    bool framed;                /* negotiated by a well formed request: every frame has a header */
+    whm_mxl_csiWireConf_t conf; /* wire format in use, raw until a request is granted */
+    uint16_t seq;
+    uint8_t* prevFrames[MXL_CSI_WIRE_MAX_RADIOS]; /* last frame sent per radio, reference of delta frames */
+    uint32_t framesSinceKey[MXL_CSI_WIRE_MAX_RADIOS];
+    uint64_t rawBytes;          /* CSI event bytes forwarded */
+    uint64_t wireBytes;         /* bytes queued on the socket for these events */
+} whm_mxl_csiSubscriber_t;
+
+typedef struct {
+    int serverfd;
+    whm_mxl_csiSubscriber_t subscribers[MXL_CSI_MAX_SUBSCRIBERS];
+    amxp_timer_t* rateCtrlTimer;
+} whm_mxl_csiServer_t;
+
+static whm_mxl_csiServer_t s_csiServer = {.serverfd = -1};
+
+static void s_initSubscribers(void) {
+    for(uint32_t i = 0; i < MXL_CSI_MAX_SUBSCRIBERS; i++) {
+        s_csiServer.subscribers[i].fd = -1;
+    }
+}
+
+static void s_resetDeltaState(whm_mxl_csiSubscriber_t* pSub) {
+    for(uint32_t i = 0; i < MXL_CSI_WIRE_MAX_RADIOS; i++) {
+        free(pSub->prevFrames[i]);
+        pSub->prevFrames[i] = NULL;
+        pSub->framesSinceKey[i] = 0;
+    }
+}
+
+static void s_closeSubscriber(whm_mxl_csiSubscriber_t* pSub) {
+    ASSERTS_FALSE(pSub->fd < 0, , ME, "subscriber not connected");
+    SAH_TRACEZ_INFO(ME, "Remote peer disconnected, fd %d (sent %"PRIu64" dropped %"PRIu64")",
+                    pSub->fd, pSub->sentFrames, pSub->droppedFrames);
+    amxo_connection_remove(get_wld_plugin_parser(), pSub->fd);
+    close(pSub->fd);
+    free(pSub->queue);
+    s_resetDeltaState(pSub);
+    memset(pSub, 0, sizeof(*pSub));
+    pSub->fd = -1;
+}
+
+static whm_mxl_csiSubscriber_t* s_getSubscriber(int fd) {
+    for(uint32_t i = 0; i < MXL_CSI_MAX_SUBSCRIBERS; i++) {
+        if(s_csiServer.subscribers[i].fd == fd) {
+            return &s_csiServer.subscribers[i];
+        }
+    }
+    return NULL;
+}
+
+static void s_flushSubscriber(whm_mxl_csiSubscriber_t* pSub);
+static whm_mxl_csiRateCtrl_t* s_getCsiRateCtrl(T_Radio* pRad);
+
+static whm_mxl_csiRateCtrl_t* s_getCsiRateCtrlByIndex(uint8_t radioIndex) {
+    T_Radio* pRad;
+    wld_for_eachRad(pRad) {
+        if((pRad != NULL) && (pRad->ref_index == radioIndex)) {
+            return s_getCsiRateCtrl(pRad);
+        }
+    }
+    return NULL;
+}
+
+static void s_subscriberCanWriteCb(int fd, void* priv _UNUSED) {
+    whm_mxl_csiSubscriber_t* pSub = s_getSubscriber(fd);
+    ASSERTS_NOT_NULL(pSub, , ME, "fd %d not a subscriber", fd);
+    pSub->waitWrite = false;
+    s_flushSubscriber(pSub);
+}
+
+/*
+ * Write as much queued data as the socket accepts without blocking.
+ * On EAGAIN, resume from the event loop once the socket is writable again.
  */
-void mxl_rad_sendCsiStatsOverUnixSocket(wifi_csi_driver_nl_event_data_t* stats) {
-    ASSERT_FALSE(conn.serverfd < 0, , ME, "No server socket created");
-
-    struct sockaddr_un clientAddr;
-    socklen_t addrLen = sizeof(clientAddr);
-    if(conn.clientfd == -1) {
-        conn.clientfd = accept(conn.serverfd, (struct sockaddr*) &clientAddr, &addrLen);
-        if(conn.clientfd == -1) {
+static void s_flushSubscriber(whm_mxl_csiSubscriber_t* pSub) {
+    while(pSub->count > 0) {
+        whm_mxl_csiFrame_t* pFrame = &pSub->queue[pSub->head];
+        ssize_t n = send(pSub->fd, pFrame->data + pSub->offset, pFrame->len - pSub->offset, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if(n < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
             if((errno == EWOULDBLOCK) || (errno == EAGAIN)) {
-                SAH_TRACEZ_INFO(ME, "No remote peer connected");
-            } else {
-                SAH_TRACEZ_ERROR(ME, "Accept failed: error:%d:%s", errno, strerror(errno));
+                if(!pSub->waitWrite) {
+                    pSub->waitWrite = (amxo_connection_wait_write(get_wld_plugin_parser(), pSub->fd, s_subscriberCanWriteCb) == 0);
+                }
+                return;
             }
+            SAH_TRACEZ_ERROR(ME, "Send to peer fd %d failed: error:%d:%s", pSub->fd, errno, strerror(errno));
+            s_closeSubscriber(pSub);
             return;
         }
-        SAH_TRACEZ_INFO(ME, "New remote peer connected, fd %d", conn.clientfd);
+        pSub->offset += n;
+        if(pSub->offset >= pFrame->len) {
+            pSub->head = (pSub->head + 1) % MXL_CSI_SUBSCRIBER_QUEUE_LEN;
+            pSub->count--;
+            pSub->offset = 0;
+            pSub->sentFrames++;
+            whm_mxl_csiRateCtrl_t* pRateCtrl = (pFrame->radioIndex != UINT8_MAX) ? s_getCsiRateCtrlByIndex(pFrame->radioIndex) : NULL;
+            if(pRateCtrl != NULL) {
+                pRateCtrl->nrSentFrames++;
+            }
+        }
     }
+}
 
-    fd_set read_fds;
-    struct timeval timeout;
-    FD_ZERO(&read_fds);
-    FD_SET(conn.clientfd, &read_fds);
+/* Slow consumer: drop the new frame rather than blocking the event loop */
+static void s_dropFrame(whm_mxl_csiSubscriber_t* pSub, T_Radio* pRad) {
+    pSub->droppedFrames++;
+    whm_mxl_csiRateCtrl_t* pRateCtrl = s_getCsiRateCtrl(pRad);
+    if(pRateCtrl != NULL) {
+        pRateCtrl->nrDroppedFrames++;
+    }
+}
 
-    timeout.tv_sec = 0;
-    timeout.tv_usec = 5000;
+/* Queue a frame of the radio, or a reply when pRad is NULL */
+static void s_enqueueFrame(whm_mxl_csiSubscriber_t* pSub, T_Radio* pRad, const void* data, uint32_t len) {
+    if(pSub->count >= MXL_CSI_SUBSCRIBER_QUEUE_LEN) {
+        s_dropFrame(pSub, pRad);
+        return;
+    }
+    whm_mxl_csiFrame_t* pFrame = &pSub->queue[(pSub->head + pSub->count) % MXL_CSI_SUBSCRIBER_QUEUE_LEN];
+    pFrame->radioIndex = (pRad != NULL) ? pRad->ref_index : UINT8_MAX;
+    pFrame->len = SWL_MIN(len, (uint32_t) sizeof(pFrame->data));
+    memcpy(pFrame->data, data, pFrame->len);
+    pSub->count++;
+}
 
-    int clientReady = select(conn.clientfd + 1, &read_fds, NULL, NULL, &timeout);
-    if(clientReady < 0) {
-        SAH_TRACEZ_ERROR(ME, "Select failed: error:%d:%s", errno, strerror(errno));
+/* Wire format of a subscriber until its request is granted */
+static void s_initWireConf(whm_mxl_csiSubscriber_t* pSub) {
+    whm_mxl_csiWireConf_t* pConf = &pSub->conf;
+    memset(pConf, 0, sizeof(*pConf));
+    pConf->magic = MXL_CSI_WIRE_MAGIC;
+    pConf->version = MXL_CSI_WIRE_VERSION;
+    pConf->format = MXL_CSI_WIRE_FMT_RAW;
+    pConf->decimation = 1;
+    pConf->quantBits = 0;
+    pConf->status = MXL_CSI_WIRE_GRANTED;
+    pSub->configured = false;
+    pSub->framed = false;
+}
+
+/* A well formed request speaks the wire protocol, whatever it asks for */
+static bool s_isWireConfReq(const whm_mxl_csiWireConf_t* pReq, size_t len) {
+    return (len >= sizeof(*pReq)) && (pReq->magic == MXL_CSI_WIRE_MAGIC) && (pReq->version == MXL_CSI_WIRE_VERSION);
+}
+
+/*
+ * Check a wire format request, return the reject reason or NULL when it can be granted.
+ * Subcarrier decimation and quantization are not supported, as the CSI matrix is forwarded
+ * as an opaque driver struct.
+ */
+static const char* s_checkWireConfReq(whm_mxl_csiSubscriber_t* pSub, const whm_mxl_csiWireConf_t* pReq, size_t len) {
+    if(len < sizeof(*pReq)) {
+        return "short request";
+    }
+    if(pReq->magic != MXL_CSI_WIRE_MAGIC) {
+        return "bad magic";
+    }
+    if(pReq->version != MXL_CSI_WIRE_VERSION) {
+        return "unsupported version";
+    }
+    if(pReq->format >= MXL_CSI_WIRE_FMT_MAX) {
+        return "unsupported format";
+    }
+    if((pReq->decimation > 1) || (pReq->quantBits != 0)) {
+        return "decimation and quantization not supported";
+    }
+    if(pSub->configured) {
+        return "wire format already settled";
+    }
+    return NULL;
+}
+
+/* Settle the wire format of a subscriber from its granted request */
+static void s_setWireConf(whm_mxl_csiSubscriber_t* pSub, const whm_mxl_csiWireConf_t* pReq) {
+    whm_mxl_csiWireConf_t* pConf = &pSub->conf;
+    s_initWireConf(pSub);
+    pSub->framed = true;
+    pConf->format = pReq->format;
+    if(pConf->format == MXL_CSI_WIRE_FMT_COMPACT) {
+        pConf->delta = (pReq->delta != 0);
+        pConf->keyInterval = (pReq->keyInterval != 0) ? pReq->keyInterval : MXL_CSI_WIRE_DEF_KEY_INTERVAL;
+    }
+    s_resetDeltaState(pSub);
+    pSub->configured = true;
+    SAH_TRACEZ_INFO(ME, "fd %d: wire format %u delta %u keyInterval %u", pSub->fd, pConf->format, pConf->delta, pConf->keyInterval);
+}
+
+/* Requests are accepted shortly after connecting only, then the format in use is settled */
+static bool s_isConfigured(whm_mxl_csiSubscriber_t* pSub) {
+    if(!pSub->configured) {
+        swl_timeSpecMono_t now;
+        swl_timespec_getMono(&now);
+        pSub->configured = (swl_timespec_diffToMillisec(&pSub->connectTs, &now) >= MXL_CSI_WIRE_NEGO_TIMEOUT_MS);
+    }
+    return pSub->configured;
+}
+
+/* Queue the reply to a wire format request, between two CSI frames */
+static void s_sendWireConfReply(whm_mxl_csiSubscriber_t* pSub, whm_mxl_csiWireStatus_e status) {
+    struct __attribute__((packed)) {
+        whm_mxl_csiWireHdr_t hdr;
+        whm_mxl_csiWireConf_t conf;
+    } reply;
+    memset(&reply, 0, sizeof(reply));
+    reply.hdr.magic = MXL_CSI_WIRE_MAGIC;
+    reply.hdr.version = MXL_CSI_WIRE_VERSION;
+    reply.hdr.encoding = MXL_CSI_WIRE_ENC_CONF;
+    reply.hdr.radioIndex = UINT8_MAX;
+    reply.hdr.seq = pSub->seq;
+    reply.hdr.rawLen = sizeof(reply.conf);
+    reply.hdr.payloadLen = sizeof(reply.conf);
+    reply.conf = pSub->conf;
+    reply.conf.status = status;
+    s_enqueueFrame(pSub, NULL, &reply, sizeof(reply));
+    if(!pSub->waitWrite) {
+        s_flushSubscriber(pSub);
+    }
+}
+
+static void s_handleWireConfReq(whm_mxl_csiSubscriber_t* pSub, const char* buf, size_t len) {
+    whm_mxl_csiWireConf_t req;
+    memset(&req, 0, sizeof(req));
+    memcpy(&req, buf, SWL_MIN(len, sizeof(req)));
+    s_isConfigured(pSub);
+    if(!pSub->framed && !s_isWireConfReq(&req, len)) {
+        /* legacy raw client: never switch its stream to header framed data */
+        SAH_TRACEZ_INFO(ME, "fd %d: ignore %zu bytes, not a wire format request", pSub->fd, len);
+        return;
+    }
+    const char* rejectReason = s_checkWireConfReq(pSub, &req, len);
+    if(rejectReason != NULL) {
+        SAH_TRACEZ_WARNING(ME, "fd %d: reject wire format request: %s", pSub->fd, rejectReason);
+        /* the format in use is kept, but the client speaks the protocol: frame its stream from now on */
+        pSub->framed = true;
+        pSub->configured = true;
+        s_sendWireConfReply(pSub, MXL_CSI_WIRE_REJECTED);
         return;
-    } else if(clientReady == 0) {
-        // send data to remote peer
-        SAH_TRACEZ_INFO(ME, "Send stats to connected remote peer, fd %d", conn.clientfd);
-        send(conn.clientfd, stats, sizeof(wifi_csi_driver_nl_event_data_t), 0);
+    }
+    s_setWireConf(pSub, &req);
+    /* the frames queued so far are raw, the following ones use the granted format */
+    s_sendWireConfReply(pSub, MXL_CSI_WIRE_GRANTED);
+}
+
+/* Byte i of the frame, XORed with the reference frame when given */
+static inline uint8_t s_frameByte(const uint8_t* in, const uint8_t* ref, uint32_t i) {
+    return (ref != NULL) ? (in[i] ^ ref[i]) : in[i];
+}
+
+/*
+ * Zero run length encoding of in (XOR ref), see whm_mxl_csi.h.
+ * Return the encoded length, or 0 when it does not fit in outMax bytes.
+ */
+static uint32_t s_rleEncode(const uint8_t* in, const uint8_t* ref, uint32_t len, uint8_t* out, uint32_t outMax) {
+    uint32_t o = 0;
+    uint32_t i = 0;
+    while(i < len) {
+        uint32_t run = 0;
+        while((i + run < len) && (run < MXL_CSI_RLE_MAX_RUN) && (s_frameByte(in, ref, i + run) == 0)) {
+            run++;
+        }
+        if(run > 0) {
+            if(o >= outMax) {
+                return 0;
+            }
+            out[o++] = MXL_CSI_RLE_ZERO_RUN | (run - 1);
+            i += run;
+            continue;
+        }
+        /* literals, keeping isolated zero bytes inside the literal run */
+        uint32_t lit = 0;
+        while((i + lit < len) && (lit < MXL_CSI_RLE_MAX_RUN)) {
+            if((s_frameByte(in, ref, i + lit) == 0) &&
+               ((i + lit + 1 >= len) || (s_frameByte(in, ref, i + lit + 1) == 0))) {
+                break;
+            }
+            lit++;
+        }
+        if(o + 1 + lit > outMax) {
+            return 0;
+        }
+        out[o++] = lit - 1;
+        for(uint32_t k = 0; k < lit; k++) {
+            out[o++] = s_frameByte(in, ref, i + k);
+        }
+        i += lit;
+    }
+    return o;
+}
+
+/*
+ * Frame one CSI event with a header, directly into the next queue slot.
+ * The payload is encoded in the compact format, or kept raw for negotiated raw subscribers.
+ */
+static void s_enqueueFramedFrame(whm_mxl_csiSubscriber_t* pSub, T_Radio* pRad, const uint8_t* data, uint32_t len) {
+    if(pSub->count >= MXL_CSI_SUBSCRIBER_QUEUE_LEN) {
+        s_dropFrame(pSub, pRad);
+        return;
+    }
+    whm_mxl_csiFrame_t* pFrame = &pSub->queue[(pSub->head + pSub->count) % MXL_CSI_SUBSCRIBER_QUEUE_LEN];
+    whm_mxl_csiWireHdr_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = MXL_CSI_WIRE_MAGIC;
+    hdr.version = MXL_CSI_WIRE_VERSION;
+    hdr.radioIndex = (pRad != NULL) ? pRad->ref_index : UINT8_MAX;
+    hdr.seq = pSub->seq++;
+    hdr.rawLen = len;
+    pFrame->radioIndex = hdr.radioIndex;
+
+    uint32_t radIdx = hdr.radioIndex;
+    bool hasDeltaState = pSub->conf.delta && (radIdx < MXL_CSI_WIRE_MAX_RADIOS);
+    if(hasDeltaState && (pSub->prevFrames[radIdx] == NULL)) {
+        pSub->prevFrames[radIdx] = calloc(1, sizeof(wifi_csi_driver_nl_event_data_t));
+        hasDeltaState = (pSub->prevFrames[radIdx] != NULL);
+        pSub->framesSinceKey[radIdx] = 0;
+    }
+    const uint8_t* ref = NULL;
+    if(hasDeltaState && (pSub->framesSinceKey[radIdx] > 0) && (pSub->framesSinceKey[radIdx] < pSub->conf.keyInterval)) {
+        ref = pSub->prevFrames[radIdx];
+    }
+
+    uint8_t* payload = pFrame->data + sizeof(hdr);
+    uint32_t payloadLen = 0;
+    if(pSub->conf.format == MXL_CSI_WIRE_FMT_COMPACT) {
+        payloadLen = s_rleEncode(data, ref, len, payload, len - 1);
+    }
+    if(payloadLen > 0) {
+        hdr.encoding = (ref != NULL) ? MXL_CSI_WIRE_ENC_DELTA : MXL_CSI_WIRE_ENC_KEY;
     } else {
-        // check if remote peer already connected
-        char buffer[1024];
-        int bytes_received = recv(conn.clientfd, buffer, sizeof(buffer), 0);
-        if(bytes_received <= 0) {
-            if((bytes_received == 0) || (errno == ECONNRESET) || (errno == ECONNABORTED)) {
-                SAH_TRACEZ_INFO(ME, "Remote peer disconnected, fd %d", conn.clientfd);
-            } else {
-                SAH_TRACEZ_ERROR(ME, "Recv data from peer failed: error:%d:%s", errno, strerror(errno));
+        /* incompressible frame, also a key frame */
+        hdr.encoding = MXL_CSI_WIRE_ENC_RAW;
+        memcpy(payload, data, len);
+        payloadLen = len;
+    }
+    hdr.payloadLen = payloadLen;
+    memcpy(pFrame->data, &hdr, sizeof(hdr));
+    pFrame->len = sizeof(hdr) + payloadLen;
+    pSub->count++;
+    pSub->rawBytes += len;
+    pSub->wireBytes += pFrame->len;
+
+    if(hasDeltaState) {
+        memcpy(pSub->prevFrames[radIdx], data, len);
+        pSub->framesSinceKey[radIdx] = (ref != NULL) ? (pSub->framesSinceKey[radIdx] + 1) : 1;
+    }
+}
+
+static void s_subscriberReadCb(int fd, void* priv _UNUSED) {
+    whm_mxl_csiSubscriber_t* pSub = s_getSubscriber(fd);
+    ASSERTS_NOT_NULL(pSub, , ME, "fd %d not a subscriber", fd);
+    char buffer[1024];
+    ssize_t bytesReceived = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if(bytesReceived > 0) {
+        /* Only a wire format request is expected from the remote peer */
+        s_handleWireConfReq(pSub, buffer, (size_t) bytesReceived);
+        return;
+    }
+    if((bytesReceived < 0) && ((errno == EWOULDBLOCK) || (errno == EAGAIN) || (errno == EINTR))) {
+        return;
+    }
+    if((bytesReceived < 0) && (errno != ECONNRESET) && (errno != ECONNABORTED)) {
+        SAH_TRACEZ_ERROR(ME, "Recv data from peer failed: error:%d:%s", errno, strerror(errno));
+    }
+    s_closeSubscriber(pSub);
+}
+
+static int s_setSocketNonBlocking(int sockfd) {
+    int flags = fcntl(sockfd, F_GETFL, 0);
+    if(flags == -1) {
+        SAH_TRACEZ_ERROR(ME, "Get sockfd flags failed: error:%d:%s", errno, strerror(errno));
+        return -1;
+    }
+    if(fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) == -1) {
+        SAH_TRACEZ_ERROR(ME, "Set non-blocking flag failed: error:%d:%s", errno, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+static void s_serverAcceptCb(int fd, void* priv _UNUSED) {
+    while(true) {
+        int clientfd = accept(fd, NULL, NULL);
+        if(clientfd == -1) {
+            if((errno != EWOULDBLOCK) && (errno != EAGAIN)) {
+                SAH_TRACEZ_ERROR(ME, "Accept failed: error:%d:%s", errno, strerror(errno));
             }
-            close(conn.clientfd);
-            conn.clientfd = -1;
+            return;
+        }
+        whm_mxl_csiSubscriber_t* pSub = s_getSubscriber(-1);
+        if(pSub == NULL) {
+            SAH_TRACEZ_WARNING(ME, "Max number of CSI subscribers (%d) reached, reject fd %d", MXL_CSI_MAX_SUBSCRIBERS, clientfd);
+            close(clientfd);
+            continue;
+        }
+        pSub->queue = calloc(MXL_CSI_SUBSCRIBER_QUEUE_LEN, sizeof(whm_mxl_csiFrame_t));
+        if((pSub->queue == NULL) || (s_setSocketNonBlocking(clientfd) == -1) ||
+           (amxo_connection_add(get_wld_plugin_parser(), clientfd, s_subscriberReadCb, NULL, AMXO_CUSTOM, NULL) != 0)) {
+            SAH_TRACEZ_ERROR(ME, "Fail to register remote peer fd %d", clientfd);
+            free(pSub->queue);
+            pSub->queue = NULL;
+            close(clientfd);
+            continue;
         }
+        pSub->fd = clientfd;
+        swl_timespec_getMono(&pSub->connectTs);
+        s_initWireConf(pSub);
+        SAH_TRACEZ_INFO(ME, "New remote peer connected, fd %d", clientfd);
     }
 }
 
-static swl_rc_ne s_getCsiCountersCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
-    ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "Request error");
-    ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
+static whm_mxl_csiRateCtrl_t* s_getCsiRateCtrl(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, NULL, ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, NULL, ME, "NULL");
+    return &pRadVendor->csiRateCtrl;
+}
 
-    struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
-    ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
+/**
+ * After adding a CSI client for a specific MAC address and monitor interval,
+ * the Maxlinear WiFi driver sends back periodically the CSI raw data over a specific Netlink vendor stats event.
+ * This function is called from the event parser to forward the received CSI stats to all the remote peers
+ * connected to the unix socket stream, which is used by third-party Apps to manage WiFi sensing data raw.
+ * Each peer has its own bounded queue, so that a slow peer never blocks the event loop nor the other peers.
+ */
+void mxl_rad_sendCsiStatsOverUnixSocket(T_Radio* pRad, const wifi_csi_driver_nl_event_data_t* stats) {
+    ASSERT_NOT_NULL(stats, , ME, "NULL");
+    whm_mxl_csiRateCtrl_t* pRateCtrl = s_getCsiRateCtrl(pRad);
+    if(pRateCtrl != NULL) {
+        pRateCtrl->nrEvents++;
+    }
+    ASSERT_FALSE(s_csiServer.serverfd < 0, , ME, "No server socket created");
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
+    for(uint32_t i = 0; i < MXL_CSI_MAX_SUBSCRIBERS; i++) {
+        whm_mxl_csiSubscriber_t* pSub = &s_csiServer.subscribers[i];
+        if(pSub->fd < 0) {
+            continue;
+        }
+        /* frames are never held back: raw until a well formed wire format request is received */
+        s_isConfigured(pSub);
+        if(pSub->framed) {
+            s_enqueueFramedFrame(pSub, pRad, (const uint8_t*) stats, sizeof(wifi_csi_driver_nl_event_data_t));
+        } else {
+            s_enqueueFrame(pSub, pRad, stats, sizeof(wifi_csi_driver_nl_event_data_t));
+            pSub->rawBytes += sizeof(wifi_csi_driver_nl_event_data_t);
+            pSub->wireBytes += sizeof(wifi_csi_driver_nl_event_data_t);
+        }
+        if(!pSub->waitWrite) {
+            s_flushSubscriber(pSub);
+        }
     }
+}
 
-    // parse data table
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    whm_mxl_csiCounters_t* csiCounters = (whm_mxl_csiCounters_t*) data;
-    SAH_TRACEZ_INFO(ME, "SendQosNullCnt %"PRIu64" | RecvFrameCnt %"PRIu64" | SendNlCsiData %"PRIu64" | ReqInfoCnt %"PRIu64"",
-                    csiCounters->csiSendQosNullCount, csiCounters->csiRecvFrameCount,
-                    csiCounters->csiSendNlCsiData, csiCounters->csiReqInfoCount);
+static whm_mxl_csiStats_t* s_getCsiStats(T_Radio* pRad) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, NULL, ME, "NULL");
+    return &pRadVendor->csiStats;
+}
 
-    whm_mxl_csiCounters_t* globCsiCounters = (whm_mxl_csiCounters_t*) priv;
-    ASSERT_NOT_NULL(globCsiCounters, SWL_RC_ERROR, ME, "NULL");
+static uint32_t s_macHash(const swl_macBin_t* pMac) {
+    uint32_t key = ((uint32_t) pMac->bMac[2] << 24) | ((uint32_t) pMac->bMac[3] << 16) |
+        ((uint32_t) pMac->bMac[4] << 8) | pMac->bMac[5];
+    return (key * 2654435761u) >> 26; /* 6 bits: MXL_CSI_COUNTERS_INDEX_SIZE */
+}
 
-    globCsiCounters->csiSendQosNullCount += csiCounters->csiSendQosNullCount;
-    globCsiCounters->csiRecvFrameCount += csiCounters->csiRecvFrameCount;
-    globCsiCounters->csiSendNlCsiData += csiCounters->csiSendNlCsiData;
-    globCsiCounters->csiReqInfoCount += csiCounters->csiReqInfoCount;
+static whm_mxl_csiClientCounters_t* s_findClientCounters(whm_mxl_csiStats_t* pCsiStats, const swl_macBin_t* pMac) {
+    uint32_t pos = s_macHash(pMac);
+    for(uint32_t i = 0; i < MXL_CSI_COUNTERS_INDEX_SIZE; i++) {
+        uint8_t slot = pCsiStats->index[(pos + i) & (MXL_CSI_COUNTERS_INDEX_SIZE - 1)];
+        if(slot == 0) {
+            return NULL;
+        }
+        whm_mxl_csiClientCounters_t* pClient = &pCsiStats->clients[slot - 1];
+        if(memcmp(pClient->mac.bMac, pMac->bMac, ETHER_ADDR_LEN) == 0) {
+            return pClient;
+        }
+    }
+    return NULL;
+}
 
-    return rc;
+static void s_indexClientCounters(whm_mxl_csiStats_t* pCsiStats, uint32_t slot) {
+    uint32_t pos = s_macHash(&pCsiStats->clients[slot].mac);
+    while(pCsiStats->index[pos] != 0) {
+        pos = (pos + 1) & (MXL_CSI_COUNTERS_INDEX_SIZE - 1);
+    }
+    pCsiStats->index[pos] = slot + 1;
 }
 
-swl_rc_ne whm_mxl_rad_sensingCsiStats(T_Radio* pRad, wld_csiState_t* csimonState) {
-    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+static whm_mxl_csiClientCounters_t* s_addClientCounters(whm_mxl_csiStats_t* pCsiStats, const swl_macBin_t* pMac) {
+    ASSERT_TRUE(pCsiStats->nrClients < MXL_CSI_COUNTERS_MAX_CLIENTS, NULL, ME, "no counters slot left for client [" SWL_MAC_FMT "]",
+                SWL_MAC_ARG(pMac->bMac));
+    whm_mxl_csiClientCounters_t* pClient = &pCsiStats->clients[pCsiStats->nrClients];
+    memset(pClient, 0, sizeof(*pClient));
+    memcpy(pClient->mac.bMac, pMac->bMac, ETHER_ADDR_LEN);
+    s_indexClientCounters(pCsiStats, pCsiStats->nrClients++);
+    return pClient;
+}
+
+/*
+ * Update the client table in place from the current CSI clients of the radio:
+ * clients gone are dropped, the clients already known keep their baseline and last counters.
+ */
+static void s_syncClientCounters(T_Radio* pRad, whm_mxl_csiStats_t* pCsiStats) {
+    bool keep[MXL_CSI_COUNTERS_MAX_CLIENTS] = {false};
+    amxc_llist_for_each(it, &pRad->csiClientList) {
+        wld_csiClient_t* client = amxc_llist_it_get_data(it, wld_csiClient_t, it);
+        swl_macBin_t clientMacBin = SWL_MAC_BIN_NEW();
+        SWL_MAC_CHAR_TO_BIN(&clientMacBin, &client->macAddr);
+        whm_mxl_csiClientCounters_t* pClient = s_findClientCounters(pCsiStats, &clientMacBin);
+        if(pClient != NULL) {
+            keep[pClient - pCsiStats->clients] = true;
+        }
+    }
 
-    whm_mxl_csiCounters_t csiCounters = {0};
+    uint32_t nrKept = 0;
+    memset(pCsiStats->index, 0, sizeof(pCsiStats->index));
+    for(uint32_t i = 0; i < pCsiStats->nrClients; i++) {
+        if(!keep[i]) {
+            continue;
+        }
+        if(nrKept != i) {
+            pCsiStats->clients[nrKept] = pCsiStats->clients[i];
+        }
+        pCsiStats->clients[nrKept].valid = false;
+        s_indexClientCounters(pCsiStats, nrKept++);
+    }
+    pCsiStats->nrClients = nrKept;
 
     amxc_llist_for_each(it, &pRad->csiClientList) {
         wld_csiClient_t* client = amxc_llist_it_get_data(it, wld_csiClient_t, it);
         swl_macBin_t clientMacBin = SWL_MAC_BIN_NEW();
         SWL_MAC_CHAR_TO_BIN(&clientMacBin, &client->macAddr);
+        if(s_findClientCounters(pCsiStats, &clientMacBin) != NULL) {
+            continue;
+        }
+        if(s_addClientCounters(pCsiStats, &clientMacBin) == NULL) {
+            break;
+        }
+    }
+}
 
-        T_AccessPoint* pAP = wld_rad_get_associated_ap(pRad, clientMacBin.bMac);
-        ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
-        ASSERTI_TRUE(mxl_isApReadyToProcessVendorCmd(pAP), SWL_RC_INVALID_STATE, ME, "AP not ready to process Vendor cmd");
+/* Driver counters since the baseline, restarting from the driver value when the driver counter went back */
+static uint64_t s_counterSince(uint64_t cur, uint64_t* pBase) {
+    if(cur < *pBase) {
+        *pBase = 0;
+    }
+    return cur - *pBase;
+}
 
-        SAH_TRACEZ_INFO(ME, "%s: Get stats for client : [" SWL_MAC_FMT "]", pRad->Name, SWL_MAC_ARG(clientMacBin.bMac));
+static void s_updateClientCounters(whm_mxl_csiClientCounters_t* pClient, const whm_mxl_csiCounters_t* pDrvCounters) {
+    pClient->last = *pDrvCounters;
+    pClient->counters.csiSendQosNullCount = s_counterSince(pDrvCounters->csiSendQosNullCount, &pClient->base.csiSendQosNullCount);
+    pClient->counters.csiRecvFrameCount = s_counterSince(pDrvCounters->csiRecvFrameCount, &pClient->base.csiRecvFrameCount);
+    pClient->counters.csiSendNlCsiData = s_counterSince(pDrvCounters->csiSendNlCsiData, &pClient->base.csiSendNlCsiData);
+    pClient->counters.csiReqInfoCount = s_counterSince(pDrvCounters->csiReqInfoCount, &pClient->base.csiReqInfoCount);
+    pClient->valid = true;
+}
+
+static swl_rc_ne s_startCsiSnapshot(T_Radio* pRad, whm_mxl_csiStats_t* pCsiStats, bool reset);
 
-        uint32_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_CSI_COUNTERS;
-        wld_ap_nl80211_sendVendorSubCmd(pAP, OUI_MXL, subcmd, clientMacBin.bMac, ETHER_ADDR_LEN,
-                                        VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_getCsiCountersCb, &csiCounters);
+/* Drop the counters published by the last snapshot: nothing counted since the reset yet */
+static void s_clearPublishedCounters(whm_mxl_csiStats_t* pCsiStats) {
+    memset(&pCsiStats->counters, 0, sizeof(pCsiStats->counters));
+    for(uint32_t i = 0; i < pCsiStats->nrClients; i++) {
+        memset(&pCsiStats->clients[i].counters, 0, sizeof(pCsiStats->clients[i].counters));
     }
+    swl_timespec_getMono(&pCsiStats->snapshotTs);
+    pCsiStats->hasSnapshot = true;
+    pCsiStats->reported = false;
+}
 
-    ASSERT_NOT_NULL(pRad, SWL_RC_ERROR, ME, "NULL");
-    amxc_var_set_type(csimonState->vendorCounters, AMXC_VAR_ID_HTABLE);
-    amxc_var_add_key(uint32_t, csimonState->vendorCounters, "SendQosNullCnt", csiCounters.csiSendQosNullCount);
-    amxc_var_add_key(uint32_t, csimonState->vendorCounters, "RecvFrameCnt", csiCounters.csiRecvFrameCount);
-    amxc_var_add_key(uint32_t, csimonState->vendorCounters, "SendNlCsiData", csiCounters.csiSendNlCsiData);
-    amxc_var_add_key(uint32_t, csimonState->vendorCounters, "ReqInfoCnt", csiCounters.csiReqInfoCount);
+/* Publish the completed snapshot, a reset snapshot moves the baseline of every client read and publishes zeroes */
+static void s_completeCsiSnapshot(T_Radio* pRad, whm_mxl_csiStats_t* pCsiStats) {
+    memset(&pCsiStats->counters, 0, sizeof(pCsiStats->counters));
+    for(uint32_t i = 0; i < pCsiStats->nrClients; i++) {
+        whm_mxl_csiClientCounters_t* pClient = &pCsiStats->clients[i];
+        if(!pClient->valid) {
+            continue;
+        }
+        if(pCsiStats->reset) {
+            pClient->base = pClient->last;
+            memset(&pClient->counters, 0, sizeof(pClient->counters));
+        }
+        pCsiStats->counters.csiSendQosNullCount += pClient->counters.csiSendQosNullCount;
+        pCsiStats->counters.csiRecvFrameCount += pClient->counters.csiRecvFrameCount;
+        pCsiStats->counters.csiSendNlCsiData += pClient->counters.csiSendNlCsiData;
+        pCsiStats->counters.csiReqInfoCount += pClient->counters.csiReqInfoCount;
+    }
+    swl_timespec_getMono(&pCsiStats->snapshotTs);
+    pCsiStats->hasSnapshot = true;
+    pCsiStats->reported = false;
+    pCsiStats->nrSnapshots++;
+    if(pCsiStats->reset) {
+        pCsiStats->nrResets++;
+        pCsiStats->reset = false;
+    }
+    if(pCsiStats->resetRequested) {
+        /* counters read before the reset request must not be reported anymore */
+        pCsiStats->resetRequested = false;
+        s_clearPublishedCounters(pCsiStats);
+        s_startCsiSnapshot(pRad, pCsiStats, true);
+    }
+}
 
-    return SWL_RC_OK;
+typedef struct {
+    T_Radio* pRad;
+    swl_macBin_t mac;
+} whm_mxl_csiCountersReq_t;
+
+/* Completion of one queued GET_CSI_COUNTERS request, the last one completes the snapshot */
+static void s_csiCountersDone(swl_rc_ne rc, const whm_mxl_nlVendorView_t* pView, void* userData) {
+    whm_mxl_csiCountersReq_t* pReq = (whm_mxl_csiCountersReq_t*) userData;
+    ASSERT_NOT_NULL(pReq, , ME, "NULL");
+    T_Radio* pRad = pReq->pRad;
+    whm_mxl_csiStats_t* pCsiStats = s_getCsiStats(pRad);
+    if((pCsiStats == NULL) || (pCsiStats->nrPending == 0)) {
+        SAH_TRACEZ_ERROR(ME, "%s: no csi counters request pending", pRad->Name);
+        free(pReq);
+        return;
+    }
+
+    whm_mxl_csiClientCounters_t* pClient = s_findClientCounters(pCsiStats, &pReq->mac);
+    if((rc >= SWL_RC_OK) && (pView != NULL) && (pClient != NULL)) {
+        const whm_mxl_csiCounters_t* csiCounters = WHM_MXL_NL_VENDOR_VIEW(pView, whm_mxl_csiCounters_t);
+        SAH_TRACEZ_INFO(ME, "[" SWL_MAC_FMT "] SendQosNullCnt %"PRIu64" | RecvFrameCnt %"PRIu64" | SendNlCsiData %"PRIu64" | ReqInfoCnt %"PRIu64"",
+                        SWL_MAC_ARG(pReq->mac.bMac), csiCounters->csiSendQosNullCount, csiCounters->csiRecvFrameCount,
+                        csiCounters->csiSendNlCsiData, csiCounters->csiReqInfoCount);
+        s_updateClientCounters(pClient, csiCounters);
+    } else {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to get csi counters of [" SWL_MAC_FMT "] (%d)", pRad->Name, SWL_MAC_ARG(pReq->mac.bMac), rc);
+    }
+    free(pReq);
+
+    if(--pCsiStats->nrPending == 0) {
+        s_completeCsiSnapshot(pRad, pCsiStats);
+    }
 }
 
-swl_rc_ne whm_mxl_rad_sensingResetStats(T_Radio* pRad) {
-    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+/*
+ * Map each CSI client to the AP it is associated to, with one pass over the stations of the radio.
+ * Clients not associated keep a NULL AP.
+ */
+static void s_mapClientsToAps(T_Radio* pRad, whm_mxl_csiStats_t* pCsiStats, T_AccessPoint** clientAPs) {
+    T_AccessPoint* pAP = NULL;
+    wld_rad_forEachAp(pAP, pRad) {
+        for(int i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
+            T_AssociatedDevice* pAD = pAP->AssociatedDevice[i];
+            if(pAD == NULL) {
+                continue;
+            }
+            swl_macBin_t staMac;
+            memcpy(staMac.bMac, pAD->MACAddress, ETHER_ADDR_LEN);
+            whm_mxl_csiClientCounters_t* pClient = s_findClientCounters(pCsiStats, &staMac);
+            if(pClient != NULL) {
+                clientAPs[pClient - pCsiStats->clients] = pAP;
+            }
+        }
+    }
+}
 
-    amxc_llist_for_each(it, &pRad->csiClientList) {
-        wld_csiClient_t* client = amxc_llist_it_get_data(it, wld_csiClient_t, it);
-        swl_macBin_t clientMacBin = SWL_MAC_BIN_NEW();
-        SWL_MAC_CHAR_TO_BIN(&clientMacBin, &client->macAddr);
+/*
+ * Request the counters of all CSI clients of the radio as one burst of vendor requests,
+ * pipelined through the radio vendor queue. The driver has no multi station counters subcmd.
+ */
+static swl_rc_ne s_startCsiSnapshot(T_Radio* pRad, whm_mxl_csiStats_t* pCsiStats, bool reset) {
+    ASSERTI_EQUALS(pCsiStats->nrPending, 0, SWL_RC_CONTINUE, ME, "%s: csi counters snapshot in progress", pRad->Name);
+    s_syncClientCounters(pRad, pCsiStats);
+    pCsiStats->reset = reset;
+    T_AccessPoint* clientAPs[MXL_CSI_COUNTERS_MAX_CLIENTS] = {NULL};
+    s_mapClientsToAps(pRad, pCsiStats, clientAPs);
 
-        T_AccessPoint* pAP = wld_rad_get_associated_ap(pRad, clientMacBin.bMac);
-        ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
-        ASSERTI_TRUE(mxl_isApReadyToProcessVendorCmd(pAP), SWL_RC_INVALID_STATE, ME, "AP not ready to process Vendor cmd");
+    for(uint32_t i = 0; i < pCsiStats->nrClients; i++) {
+        whm_mxl_csiClientCounters_t* pClient = &pCsiStats->clients[i];
+        T_AccessPoint* pAP = clientAPs[i];
+        if((pAP == NULL) || !mxl_isApReadyToProcessVendorCmd(pAP)) {
+            SAH_TRACEZ_INFO(ME, "%s: no ready AP for client : [" SWL_MAC_FMT "]", pRad->Name, SWL_MAC_ARG(pClient->mac.bMac));
+            continue;
+        }
+        whm_mxl_csiCountersReq_t* pReq = calloc(1, sizeof(*pReq));
+        ASSERT_NOT_NULL(pReq, SWL_RC_ERROR, ME, "%s: fail to allocate csi counters request", pRad->Name);
+        pReq->pRad = pRad;
+        pReq->mac = pClient->mac;
 
-        SAH_TRACEZ_INFO(ME, "%s: Reset stats for client : [" SWL_MAC_FMT "]", pRad->Name, SWL_MAC_ARG(clientMacBin.bMac));
+        whm_mxl_vendorReqArgs_t args = {
+            .pAP = pAP,
+            .subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_CSI_COUNTERS,
+            .data = pClient->mac.bMac,
+            .dataLen = ETHER_ADDR_LEN,
+            .expectReply = true,
+            .doneCb = s_csiCountersDone,
+            .userData = pReq,
+        };
+        if(whm_mxl_vendorQueue_send(pRad, &args, NULL) < SWL_RC_OK) {
+            free(pReq);
+            continue;
+        }
+        pCsiStats->nrPending++;
+    }
+    if(pCsiStats->nrPending == 0) {
+        /* nothing to wait for: complete with the clients left unread */
+        s_completeCsiSnapshot(pRad, pCsiStats);
+    }
+    return SWL_RC_OK;
+}
 
-        struct intel_vendor_reset_statistics data;
-        data.category = MXL_RESET_STATS_CATEGORY_STA;
-        memcpy(data.addr, clientMacBin.bMac, ETHER_ADDR_LEN);
+/*
+ * Report the counters of the last snapshot, and start a new one:
+ * each call reports the counters collected by the previous call.
+ * Until a first snapshot completes, only Ready false is reported, rather than zero counters.
+ * SnapshotAge tells how old the reported counters are (ms),
+ * Stale that they were already reported, no snapshot having completed since.
+ */
+swl_rc_ne whm_mxl_rad_sensingCsiStats(T_Radio* pRad, wld_csiState_t* csimonState) {
+    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(csimonState, SWL_RC_INVALID_PARAM, ME, "NULL");
+    whm_mxl_csiStats_t* pCsiStats = s_getCsiStats(pRad);
+    ASSERT_NOT_NULL(pCsiStats, SWL_RC_ERROR, ME, "NULL");
 
-        uint32_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_RESET_STATISTICS;
-        wld_ap_nl80211_sendVendorSubCmd(pAP, OUI_MXL, subcmd, &data, sizeof(struct intel_vendor_reset_statistics),
-                                        VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, NULL, NULL);
+    amxc_var_set_type(csimonState->vendorCounters, AMXC_VAR_ID_HTABLE);
+    amxc_var_add_key(bool, csimonState->vendorCounters, "Ready", pCsiStats->hasSnapshot);
+    if(!pCsiStats->hasSnapshot) {
+        SAH_TRACEZ_INFO(ME, "%s: no csi counters snapshot yet", pRad->Name);
+        s_startCsiSnapshot(pRad, pCsiStats, false);
+        return SWL_RC_OK;
     }
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    int64_t ageMs = SWL_MAX(swl_timespec_diffToMillisec(&pCsiStats->snapshotTs, &now), (int64_t) 0);
+    amxc_var_add_key(uint64_t, csimonState->vendorCounters, "SnapshotAge", (uint64_t) ageMs);
+    amxc_var_add_key(bool, csimonState->vendorCounters, "Stale", pCsiStats->reported);
+    pCsiStats->reported = true;
+    amxc_var_add_key(uint32_t, csimonState->vendorCounters, "SendQosNullCnt", pCsiStats->counters.csiSendQosNullCount);
+    amxc_var_add_key(uint32_t, csimonState->vendorCounters, "RecvFrameCnt", pCsiStats->counters.csiRecvFrameCount);
+    amxc_var_add_key(uint32_t, csimonState->vendorCounters, "SendNlCsiData", pCsiStats->counters.csiSendNlCsiData);
+    amxc_var_add_key(uint32_t, csimonState->vendorCounters, "ReqInfoCnt", pCsiStats->counters.csiReqInfoCount);
+    amxc_var_t* pClientList = amxc_var_add_key(amxc_llist_t, csimonState->vendorCounters, "Clients", NULL);
+    for(uint32_t i = 0; i < pCsiStats->nrClients; i++) {
+        whm_mxl_csiClientCounters_t* pClient = &pCsiStats->clients[i];
+        if(!pClient->valid) {
+            continue;
+        }
+        swl_macChar_t macStr = SWL_MAC_CHAR_NEW();
+        SWL_MAC_BIN_TO_CHAR(&macStr, pClient->mac.bMac);
+        amxc_var_t* pClientMap = amxc_var_add(amxc_htable_t, pClientList, NULL);
+        amxc_var_add_key(cstring_t, pClientMap, "MACAddress", macStr.cMac);
+        amxc_var_add_key(uint64_t, pClientMap, "SendQosNullCnt", pClient->counters.csiSendQosNullCount);
+        amxc_var_add_key(uint64_t, pClientMap, "RecvFrameCnt", pClient->counters.csiRecvFrameCount);
+        amxc_var_add_key(uint64_t, pClientMap, "SendNlCsiData", pClient->counters.csiSendNlCsiData);
+        amxc_var_add_key(uint64_t, pClientMap, "ReqInfoCnt", pClient->counters.csiReqInfoCount);
+    }
+
+    s_startCsiSnapshot(pRad, pCsiStats, false);
     return SWL_RC_OK;
 }
 
+/*
+ * Snapshot and reset the counters of all CSI clients of the radio.
+ * The reset moves the software baseline to the counters read by the snapshot,
+ * so the frames counted meanwhile are reported by the next snapshot.
+ * The counters published so far are cleared right away.
+ */
+swl_rc_ne whm_mxl_rad_sensingResetStats(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+    whm_mxl_csiStats_t* pCsiStats = s_getCsiStats(pRad);
+    ASSERT_NOT_NULL(pCsiStats, SWL_RC_ERROR, ME, "NULL");
+
+    s_clearPublishedCounters(pCsiStats);
+    if(pCsiStats->nrPending > 0) {
+        SAH_TRACEZ_INFO(ME, "%s: reset csi counters after the snapshot in progress", pRad->Name);
+        pCsiStats->resetRequested = true;
+        return SWL_RC_OK;
+    }
+    return s_startCsiSnapshot(pRad, pCsiStats, true);
+}
+
 uint8_t s_msInterval2SamplingRate(uint32_t msInterval) {
     if(msInterval <= 0) {
         return MXL_CSI_MIN_SRATE;
@@ -190,40 +855,293 @@ uint8_t s_msInterval2SamplingRate(uint32_t msInterval) {
     return (uint8_t) samplingRate;
 }
 
-static swl_rc_ne s_setCsiAutoRate(T_Radio* pRad, wld_csiClient_t* client, bool enable) {
-    swl_macBin_t clientMacBin = SWL_MAC_BIN_NEW();
-    SWL_MAC_CHAR_TO_BIN(&clientMacBin, &client->macAddr);
-
-    T_AccessPoint* pAP = wld_rad_get_associated_ap(pRad, clientMacBin.bMac);
-    ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
-    ASSERTI_TRUE(mxl_isApReadyToProcessVendorCmd(pAP), SWL_RC_INVALID_STATE, ME, "AP not ready to process Vendor cmd");
+/* Fill the auto rate command of a client, return the AP it is associated to */
+static T_AccessPoint* s_buildCsiAutoRate(T_Radio* pRad, const swl_macBin_t* pClientMac, uint8_t rate, bool enable, whm_mxl_csiAutoRate_t* pData) {
+    T_AccessPoint* pAP = wld_rad_get_associated_ap(pRad, (unsigned char*) pClientMac->bMac);
+    ASSERT_NOT_NULL(pAP, NULL, ME, "NULL");
+    ASSERTI_TRUE(mxl_isApReadyToProcessVendorCmd(pAP), NULL, ME, "AP not ready to process Vendor cmd");
     T_SSID* pSSID = pAP->pSSID;
-    ASSERT_NOT_NULL(pSSID, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(pSSID, NULL, ME, "NULL");
 
-    whm_mxl_csiAutoRate_t data;
-    memset(&data, 0, sizeof(data));
-    data.saFamily = 1;
-    memcpy(data.staMac, clientMacBin.bMac, ETHER_ADDR_LEN);
-    memcpy(data.assocApMac, pSSID->BSSID, ETHER_ADDR_LEN);
-    data.rate = s_msInterval2SamplingRate(client->monitorInterval);
-    data.enable = enable;
+    memset(pData, 0, sizeof(*pData));
+    pData->saFamily = 1;
+    memcpy(pData->staMac, pClientMac->bMac, ETHER_ADDR_LEN);
+    memcpy(pData->assocApMac, pSSID->BSSID, ETHER_ADDR_LEN);
+    pData->rate = rate;
+    pData->enable = enable;
 
-    SAH_TRACEZ_INFO(ME, "%s: %s CSI for client : [" SWL_MAC_FMT "]", pRad->Name,
-                    (data.enable) ? "Enable" : "Disable",
-                    SWL_MAC_ARG(data.staMac));
+    SAH_TRACEZ_INFO(ME, "%s: %s CSI for client : [" SWL_MAC_FMT "] at %u Hz", pRad->Name,
+                    (pData->enable) ? "Enable" : "Disable",
+                    SWL_MAC_ARG(pData->staMac), pData->rate);
+    return pAP;
+}
+
+/* Client add / delete: the driver result is returned to the caller */
+static swl_rc_ne s_sendCsiAutoRate(T_Radio* pRad, const swl_macBin_t* pClientMac, uint8_t rate, bool enable) {
+    whm_mxl_csiAutoRate_t data;
+    T_AccessPoint* pAP = s_buildCsiAutoRate(pRad, pClientMac, rate, enable, &data);
+    ASSERTS_NOT_NULL(pAP, SWL_RC_INVALID_STATE, ME, "%s: no ready AP for client", pRad->Name);
 
     uint32_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_SET_CSI_AUTO_RATE;
     return wld_ap_nl80211_sendVendorSubCmd(pAP, OUI_MXL, subcmd, &data, sizeof(whm_mxl_csiAutoRate_t),
                                            VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, NULL, NULL);
 }
 
+static whm_mxl_csiClientRate_t* s_findClientRate(whm_mxl_csiRateCtrl_t* pRateCtrl, const swl_macBin_t* pClientMac) {
+    for(uint32_t i = 0; i < MXL_CSI_RATE_CTRL_MAX_CLIENTS; i++) {
+        whm_mxl_csiClientRate_t* pClientRate = &pRateCtrl->clients[i];
+        if(pClientRate->used && (memcmp(pClientRate->mac.bMac, pClientMac->bMac, ETHER_ADDR_LEN) == 0)) {
+            return pClientRate;
+        }
+    }
+    return NULL;
+}
+
+typedef struct {
+    T_Radio* pRad;
+    swl_macBin_t mac;
+    uint8_t rate;
+} whm_mxl_csiRateReq_t;
+
+/* Completion of a rate change: the rate is only committed once the driver applied it */
+static void s_csiRateDone(swl_rc_ne rc, const whm_mxl_nlVendorView_t* pView _UNUSED, void* userData) {
+    whm_mxl_csiRateReq_t* pReq = (whm_mxl_csiRateReq_t*) userData;
+    ASSERT_NOT_NULL(pReq, , ME, "NULL");
+    whm_mxl_csiRateCtrl_t* pRateCtrl = s_getCsiRateCtrl(pReq->pRad);
+    whm_mxl_csiClientRate_t* pClientRate = (pRateCtrl != NULL) ? s_findClientRate(pRateCtrl, &pReq->mac) : NULL;
+    if((pClientRate == NULL) || (pClientRate->pendingRate != pReq->rate)) {
+        /* client deleted, or its rate set again by a client update meanwhile */
+        SAH_TRACEZ_INFO(ME, "drop rate %u Hz completion of [" SWL_MAC_FMT "]", pReq->rate, SWL_MAC_ARG(pReq->mac.bMac));
+        free(pReq);
+        return;
+    }
+    pClientRate->pendingRate = 0;
+    if(rc < SWL_RC_OK) {
+        SAH_TRACEZ_ERROR(ME, "fail to set csi rate %u Hz of [" SWL_MAC_FMT "] (%d)", pReq->rate, SWL_MAC_ARG(pReq->mac.bMac), rc);
+        pClientRate->nrRejected++;
+        free(pReq);
+        return;
+    }
+    if(pReq->rate < pClientRate->rate) {
+        pClientRate->nrDecreases++;
+        pRateCtrl->nrDecreases++;
+    } else {
+        pClientRate->nrIncreases++;
+        pRateCtrl->nrIncreases++;
+    }
+    pClientRate->rate = pReq->rate;
+    free(pReq);
+}
+
+/* Rate controller change: queued, so that the event loop never waits for the driver */
+static swl_rc_ne s_queueCsiRate(T_Radio* pRad, whm_mxl_csiClientRate_t* pClientRate, uint8_t rate) {
+    whm_mxl_csiAutoRate_t data;
+    T_AccessPoint* pAP = s_buildCsiAutoRate(pRad, &pClientRate->mac, rate, true, &data);
+    ASSERTS_NOT_NULL(pAP, SWL_RC_INVALID_STATE, ME, "%s: no ready AP for client", pRad->Name);
+    whm_mxl_csiRateReq_t* pReq = calloc(1, sizeof(*pReq));
+    ASSERT_NOT_NULL(pReq, SWL_RC_ERROR, ME, "%s: fail to allocate csi rate request", pRad->Name);
+    pReq->pRad = pRad;
+    pReq->mac = pClientRate->mac;
+    pReq->rate = rate;
+
+    whm_mxl_vendorReqArgs_t args = {
+        .pAP = pAP,
+        .subcmd = LTQ_NL80211_VENDOR_SUBCMD_SET_CSI_AUTO_RATE,
+        .data = &data,
+        .dataLen = sizeof(whm_mxl_csiAutoRate_t),
+        .doneCb = s_csiRateDone,
+        .userData = pReq,
+    };
+    swl_rc_ne rc = whm_mxl_vendorQueue_send(pRad, &args, NULL);
+    if(rc < SWL_RC_OK) {
+        free(pReq);
+        return rc;
+    }
+    pClientRate->pendingRate = rate;
+    return rc;
+}
+
+/* Track a client at the rate applied by the driver, from its requested rate */
+static void s_addClientRate(whm_mxl_csiRateCtrl_t* pRateCtrl, const swl_macBin_t* pClientMac, uint8_t targetRate, uint8_t rate) {
+    whm_mxl_csiClientRate_t* pClientRate = s_findClientRate(pRateCtrl, pClientMac);
+    for(uint32_t i = 0; (pClientRate == NULL) && (i < MXL_CSI_RATE_CTRL_MAX_CLIENTS); i++) {
+        if(!pRateCtrl->clients[i].used) {
+            pClientRate = &pRateCtrl->clients[i];
+            memset(pClientRate, 0, sizeof(*pClientRate));
+            memcpy(pClientRate->mac.bMac, pClientMac->bMac, ETHER_ADDR_LEN);
+            pClientRate->used = true;
+        }
+    }
+    ASSERT_NOT_NULL(pClientRate, , ME, "no rate control slot left for client [" SWL_MAC_FMT "]", SWL_MAC_ARG(pClientMac->bMac));
+    pClientRate->targetRate = targetRate;
+    pClientRate->rate = rate;
+    /* a rate change still in flight is superseded */
+    pClientRate->pendingRate = 0;
+}
+
+static swl_rc_ne s_setCsiAutoRate(T_Radio* pRad, wld_csiClient_t* client, bool enable) {
+    swl_macBin_t clientMacBin = SWL_MAC_BIN_NEW();
+    SWL_MAC_CHAR_TO_BIN(&clientMacBin, &client->macAddr);
+    uint8_t targetRate = s_msInterval2SamplingRate(client->monitorInterval);
+    uint8_t rate = targetRate;
+
+    whm_mxl_csiRateCtrl_t* pRateCtrl = s_getCsiRateCtrl(pRad);
+    whm_mxl_csiClientRate_t* pClientRate = (pRateCtrl != NULL) ? s_findClientRate(pRateCtrl, &clientMacBin) : NULL;
+    if(enable && (pClientRate != NULL)) {
+        /* keep the rate already learned for a known client */
+        rate = SWL_MIN(pClientRate->rate, targetRate);
+    }
+    swl_rc_ne rc = s_sendCsiAutoRate(pRad, &clientMacBin, rate, enable);
+    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: fail to %s CSI for client [" SWL_MAC_FMT "] (%d)", pRad->Name,
+                 enable ? "enable" : "disable", SWL_MAC_ARG(clientMacBin.bMac), rc);
+    ASSERTS_NOT_NULL(pRateCtrl, rc, ME, "NULL");
+    if(enable) {
+        s_addClientRate(pRateCtrl, &clientMacBin, targetRate, rate);
+    } else if(pClientRate != NULL) {
+        pClientRate->used = false;
+    }
+    return rc;
+}
+
+static uint32_t s_getNrSubscribers(void) {
+    uint32_t nrSubs = 0;
+    for(uint32_t i = 0; i < MXL_CSI_MAX_SUBSCRIBERS; i++) {
+        if(s_csiServer.subscribers[i].fd >= 0) {
+            nrSubs++;
+        }
+    }
+    return nrSubs;
+}
+
+/*
+ * Measure the drain of the radio frames over the last controller period:
+ * dropped share and backlog in the slowest subscriber queue, and the events
+ * delivered for each client, from the driver per client counters of the last snapshot.
+ */
+static void s_updateRateMeasures(T_Radio* pRad, whm_mxl_csiRateCtrl_t* pRateCtrl) {
+    uint64_t nrEvents = pRateCtrl->nrEvents - pRateCtrl->lastNrEvents;
+    pRateCtrl->lastNrEvents = pRateCtrl->nrEvents;
+    pRateCtrl->eventRate = (uint32_t) ((nrEvents * 1000) / MXL_CSI_RATE_CTRL_PERIOD_MS);
+
+    uint64_t nrSent = pRateCtrl->nrSentFrames - pRateCtrl->lastSentFrames;
+    uint64_t nrDropped = pRateCtrl->nrDroppedFrames - pRateCtrl->lastDroppedFrames;
+    pRateCtrl->lastSentFrames = pRateCtrl->nrSentFrames;
+    pRateCtrl->lastDroppedFrames = pRateCtrl->nrDroppedFrames;
+    pRateCtrl->dropPermille = ((nrSent + nrDropped) > 0) ? (uint32_t) ((nrDropped * 1000) / (nrSent + nrDropped)) : 0;
+
+    pRateCtrl->maxBacklog = 0;
+    for(uint32_t i = 0; i < MXL_CSI_MAX_SUBSCRIBERS; i++) {
+        whm_mxl_csiSubscriber_t* pSub = &s_csiServer.subscribers[i];
+        uint32_t backlog = 0;
+        for(uint32_t j = 0; (pSub->fd >= 0) && (j < pSub->count); j++) {
+            if(pSub->queue[(pSub->head + j) % MXL_CSI_SUBSCRIBER_QUEUE_LEN].radioIndex == pRad->ref_index) {
+                backlog++;
+            }
+        }
+        pRateCtrl->maxBacklog = SWL_MAX(pRateCtrl->maxBacklog, backlog);
+    }
+
+    whm_mxl_csiStats_t* pCsiStats = s_getCsiStats(pRad);
+    for(uint32_t i = 0; i < MXL_CSI_RATE_CTRL_MAX_CLIENTS; i++) {
+        whm_mxl_csiClientRate_t* pClientRate = &pRateCtrl->clients[i];
+        if(!pClientRate->used) {
+            continue;
+        }
+        whm_mxl_csiClientCounters_t* pClient = (pCsiStats != NULL) ? s_findClientCounters(pCsiStats, &pClientRate->mac) : NULL;
+        bool hasCounters = (pClient != NULL) && pClient->valid;
+        uint64_t nlCsiData = hasCounters ? pClient->last.csiSendNlCsiData : 0;
+        pClientRate->measured = hasCounters && (pClientRate->lastNlCsiData > 0) && (nlCsiData >= pClientRate->lastNlCsiData);
+        pClientRate->eventRate = pClientRate->measured ?
+            (uint32_t) (((nlCsiData - pClientRate->lastNlCsiData) * 1000) / MXL_CSI_RATE_CTRL_PERIOD_MS) : 0;
+        pClientRate->lastNlCsiData = nlCsiData;
+    }
+}
+
+/* Decision of one client, from the drain of its radio frames and its own delivered events */
+static whm_mxl_csiRateDecision_e s_getClientRateDecision(whm_mxl_csiRateCtrl_t* pRateCtrl, whm_mxl_csiClientRate_t* pClientRate,
+                                                         uint32_t nrSubs, uint32_t fairShare) {
+    if(nrSubs == 0) {
+        return MXL_CSI_RATE_MIN;
+    }
+    if((pRateCtrl->dropPermille > MXL_CSI_RATE_DROP_HIGH_PERMILLE) || ((pRateCtrl->maxBacklog * 4) > (MXL_CSI_SUBSCRIBER_QUEUE_LEN * 3))) {
+        /* back off the clients loading the queues, the ones below their share have little to shed */
+        return (!pClientRate->measured || (pClientRate->eventRate >= fairShare)) ? MXL_CSI_RATE_DECREASE : MXL_CSI_RATE_HOLD;
+    }
+    if((pRateCtrl->dropPermille == 0) && ((pRateCtrl->maxBacklog * 4) < MXL_CSI_SUBSCRIBER_QUEUE_LEN)) {
+        /* the driver delivers well below the current rate (idle client): raising it adds no data */
+        if(pClientRate->measured && ((pClientRate->eventRate * 2) < pClientRate->rate)) {
+            return MXL_CSI_RATE_HOLD;
+        }
+        return MXL_CSI_RATE_INCREASE;
+    }
+    return MXL_CSI_RATE_HOLD;
+}
+
+static void s_applyRateDecisions(T_Radio* pRad, whm_mxl_csiRateCtrl_t* pRateCtrl, uint32_t nrSubs) {
+    uint32_t nrClients = 0;
+    for(uint32_t i = 0; i < MXL_CSI_RATE_CTRL_MAX_CLIENTS; i++) {
+        nrClients += pRateCtrl->clients[i].used ? 1 : 0;
+    }
+    ASSERTS_NOT_EQUALS(nrClients, 0, , ME, "%s: no csi client", pRad->Name);
+    uint32_t fairShare = pRateCtrl->eventRate / nrClients;
+
+    for(uint32_t i = 0; i < MXL_CSI_RATE_CTRL_MAX_CLIENTS; i++) {
+        whm_mxl_csiClientRate_t* pClientRate = &pRateCtrl->clients[i];
+        if(!pClientRate->used) {
+            continue;
+        }
+        pClientRate->decision = s_getClientRateDecision(pRateCtrl, pClientRate, nrSubs, fairShare);
+        if((pClientRate->decision == MXL_CSI_RATE_HOLD) || (pClientRate->pendingRate != 0)) {
+            /* one rate change in flight per client */
+            continue;
+        }
+        uint8_t rate = pClientRate->rate;
+        if(pClientRate->decision == MXL_CSI_RATE_MIN) {
+            rate = MXL_CSI_MIN_SRATE;
+        } else if(pClientRate->decision == MXL_CSI_RATE_DECREASE) {
+            rate = SWL_MAX((uint8_t) ((rate * 3) / 4), (uint8_t) MXL_CSI_MIN_SRATE);
+        } else {
+            rate = SWL_MIN((uint8_t) (rate + MXL_CSI_RATE_STEP), pClientRate->targetRate);
+        }
+        if(rate != pClientRate->rate) {
+            s_queueCsiRate(pRad, pClientRate, rate);
+        }
+    }
+}
+
+/*
+ * Closed loop on the CSI sampling rates: each period and for each radio, the rates of the clients
+ * loading the socket are lowered when the radio frames are dropped or lag behind in the slowest
+ * subscriber queue, and raised back towards the requested rates while the subscribers keep up.
+ * The driver counters of the clients are refreshed for the next period.
+ */
+static void s_rateCtrlTimerCb(amxp_timer_t* timer _UNUSED, void* userdata _UNUSED) {
+    uint32_t nrSubs = s_getNrSubscribers();
+    T_Radio* pRad;
+    wld_for_eachRad(pRad) {
+        if((pRad == NULL) || !pRad->csiEnable) {
+            continue;
+        }
+        whm_mxl_csiRateCtrl_t* pRateCtrl = s_getCsiRateCtrl(pRad);
+        whm_mxl_csiStats_t* pCsiStats = s_getCsiStats(pRad);
+        if((pRateCtrl == NULL) || (pCsiStats == NULL)) {
+            continue;
+        }
+        s_updateRateMeasures(pRad, pRateCtrl);
+        s_applyRateDecisions(pRad, pRateCtrl, nrSubs);
+        s_startCsiSnapshot(pRad, pCsiStats, false);
+    }
+}
+
 static wld_csiClient_t* s_findCsiClient(T_Radio* pRad, swl_macChar_t clientMacAddr) {
+    swl_macBin_t macBin = SWL_MAC_BIN_NEW();
+    SWL_MAC_CHAR_TO_BIN(&macBin, &clientMacAddr);
     amxc_llist_for_each(it, &pRad->csiClientList) {
         wld_csiClient_t* client = amxc_llist_it_get_data(it, wld_csiClient_t, it);
-        if(swl_str_matches(client->macAddr.cMac, clientMacAddr.cMac)) {
+        swl_macBin_t clientMacBin = SWL_MAC_BIN_NEW();
+        SWL_MAC_CHAR_TO_BIN(&clientMacBin, &client->macAddr);
+        if(memcmp(clientMacBin.bMac, macBin.bMac, ETHER_ADDR_LEN) == 0) {
             return client;
-        } else {
-            continue;
         }
     }
     return NULL;
@@ -247,19 +1165,6 @@ swl_rc_ne whm_mxl_rad_sensingAddClient(T_Radio* pRad, wld_csiClient_t* client) {
     return s_setCsiAutoRate(pRad, client, true);
 }
 
-static int s_setSocketNonBlocking(int sockfd) {
-    int flags = fcntl(sockfd, F_GETFL, 0);
-    if(flags == -1) {
-        SAH_TRACEZ_ERROR(ME, "Get sockfd flags failed: error:%d:%s", errno, strerror(errno));
-        return -1;
-    }
-    if(fcntl(sockfd, F_SETFL, flags | O_NONBLOCK) == -1) {
-        SAH_TRACEZ_ERROR(ME, "Set non-blocking flag failed: error:%d:%s", errno, strerror(errno));
-        return -1;
-    }
-    return 0;
-}
-
 static int s_createStatsSocket() {
     int32_t sockfd;
     struct sockaddr_un socket_addr;
@@ -276,7 +1181,7 @@ static int s_createStatsSocket() {
         goto error;
     }
 
-    if(listen(sockfd, 1) < 0) {
+    if(listen(sockfd, MXL_CSI_MAX_SUBSCRIBERS) < 0) {
         SAH_TRACEZ_ERROR(ME, "Listen connection failed: error:%d:%s", errno, strerror(errno));
         goto error;
     }
@@ -284,6 +1189,11 @@ static int s_createStatsSocket() {
     if(s_setSocketNonBlocking(sockfd) == -1) {
         goto error;
     }
+    // Accept remote peers from the event loop
+    if(amxo_connection_add(get_wld_plugin_parser(), sockfd, s_serverAcceptCb, NULL, AMXO_CUSTOM, NULL) != 0) {
+        SAH_TRACEZ_ERROR(ME, "Fail to add server socket to event loop");
+        goto error;
+    }
 
     SAH_TRACEZ_INFO(ME, "Unix Stream Socket created and bound to %s", CONFIG_MOD_WHM_CSI_SOCKET_PATH);
     return sockfd;
@@ -322,10 +1232,14 @@ swl_rc_ne whm_mxl_rad_sensingCmd(T_Radio* pRad) {
 
     if(pRad->csiEnable) {
         // Create Unix socket to send csi stats
-        if(conn.serverfd < 0) {
-            conn.serverfd = s_createStatsSocket();
-            if(conn.serverfd < 0) {
+        if(s_csiServer.serverfd < 0) {
+            s_initSubscribers();
+            s_csiServer.serverfd = s_createStatsSocket();
+            if(s_csiServer.serverfd < 0) {
                 SAH_TRACEZ_ERROR(ME, "Create Unix socket failed");
+            } else if(amxp_timer_new(&s_csiServer.rateCtrlTimer, s_rateCtrlTimerCb, NULL) == 0) {
+                amxp_timer_set_interval(s_csiServer.rateCtrlTimer, MXL_CSI_RATE_CTRL_PERIOD_MS);
+                amxp_timer_start(s_csiServer.rateCtrlTimer, MXL_CSI_RATE_CTRL_PERIOD_MS);
             }
         }
         // Restart all existing csi clients on this radio
@@ -334,14 +1248,16 @@ swl_rc_ne whm_mxl_rad_sensingCmd(T_Radio* pRad) {
         // Stop all existing csi clients on this radio
         s_enableExistingCsiClients(pRad, false);
         // Close and clean Unix socket when csi is disabled for all radios
-        if(conn.serverfd != -1) {
+        if(s_csiServer.serverfd != -1) {
             if(!s_sensingEnabledOnOtherRadios(pRad)) {
-                if(conn.clientfd != -1) {
-                    close(conn.clientfd);
-                    conn.clientfd = -1;
+                for(uint32_t i = 0; i < MXL_CSI_MAX_SUBSCRIBERS; i++) {
+                    s_closeSubscriber(&s_csiServer.subscribers[i]);
                 }
-                close(conn.serverfd);
-                conn.serverfd = -1;
+                amxp_timer_delete(&s_csiServer.rateCtrlTimer);
+                s_csiServer.rateCtrlTimer = NULL;
+                amxo_connection_remove(get_wld_plugin_parser(), s_csiServer.serverfd);
+                close(s_csiServer.serverfd);
+                s_csiServer.serverfd = -1;
                 unlink(CONFIG_MOD_WHM_CSI_SOCKET_PATH);
             }
         }
@@ -354,11 +1270,54 @@ amxd_status_t _whm_mxl_csi_getCsiSocketStatus(amxd_object_t* object,
                                               amxd_function_t* func _UNUSED,
                                               amxc_var_t* args _UNUSED,
                                               amxc_var_t* retval) {
-    amxd_object_t* pRad = amxd_object_get_parent(object);
-    ASSERT_NOT_NULL(pRad, amxd_status_unknown_error, ME, "NULL");
+    amxd_object_t* pRadObj = amxd_object_get_parent(object);
+    ASSERT_NOT_NULL(pRadObj, amxd_status_unknown_error, ME, "NULL");
 
     amxc_var_set_type(retval, AMXC_VAR_ID_HTABLE);
-    amxc_var_add_key(bool, retval, "Active", (conn.serverfd < 0) ? false : true);
+    amxc_var_add_key(bool, retval, "Active", (s_csiServer.serverfd < 0) ? false : true);
     amxc_var_add_key(cstring_t, retval, "SocketPath", CONFIG_MOD_WHM_CSI_SOCKET_PATH);
+    amxc_var_t* pSubList = amxc_var_add_key(amxc_llist_t, retval, "Subscribers", NULL);
+    for(uint32_t i = 0; (s_csiServer.serverfd >= 0) && (i < MXL_CSI_MAX_SUBSCRIBERS); i++) {
+        whm_mxl_csiSubscriber_t* pSub = &s_csiServer.subscribers[i];
+        if(pSub->fd < 0) {
+            continue;
+        }
+        amxc_var_t* pSubStats = amxc_var_add(amxc_htable_t, pSubList, NULL);
+        amxc_var_add_key(uint32_t, pSubStats, "QueuedFrames", pSub->count);
+        amxc_var_add_key(uint64_t, pSubStats, "SentFrames", pSub->sentFrames);
+        amxc_var_add_key(uint64_t, pSubStats, "DroppedFrames", pSub->droppedFrames);
+        amxc_var_add_key(bool, pSubStats, "FormatSettled", s_isConfigured(pSub));
+        amxc_var_add_key(bool, pSubStats, "Framed", pSub->framed);
+        amxc_var_add_key(cstring_t, pSubStats, "Format",
+                         (pSub->conf.format == MXL_CSI_WIRE_FMT_COMPACT) ? (pSub->conf.delta ? "CompactDelta" : "Compact") : "Raw");
+        amxc_var_add_key(uint64_t, pSubStats, "RawBytes", pSub->rawBytes);
+        amxc_var_add_key(uint64_t, pSubStats, "WireBytes", pSub->wireBytes);
+    }
+    whm_mxl_csiRateCtrl_t* pRateCtrl = s_getCsiRateCtrl(wld_rad_fromObj(pRadObj));
+    ASSERTS_NOT_NULL(pRateCtrl, amxd_status_ok, ME, "No Radio Mapped");
+    amxc_var_t* pRateMap = amxc_var_add_key(amxc_htable_t, retval, "RateControl", NULL);
+    amxc_var_add_key(uint32_t, pRateMap, "EventRate", pRateCtrl->eventRate);
+    amxc_var_add_key(uint32_t, pRateMap, "DropPermille", pRateCtrl->dropPermille);
+    amxc_var_add_key(uint32_t, pRateMap, "Backlog", pRateCtrl->maxBacklog);
+    amxc_var_add_key(uint64_t, pRateMap, "Decreases", pRateCtrl->nrDecreases);
+    amxc_var_add_key(uint64_t, pRateMap, "Increases", pRateCtrl->nrIncreases);
+    amxc_var_t* pClientList = amxc_var_add_key(amxc_llist_t, pRateMap, "Clients", NULL);
+    for(uint32_t i = 0; i < MXL_CSI_RATE_CTRL_MAX_CLIENTS; i++) {
+        whm_mxl_csiClientRate_t* pClientRate = &pRateCtrl->clients[i];
+        if(!pClientRate->used) {
+            continue;
+        }
+        swl_macChar_t macStr = SWL_MAC_CHAR_NEW();
+        SWL_MAC_BIN_TO_CHAR(&macStr, pClientRate->mac.bMac);
+        amxc_var_t* pClientMap = amxc_var_add(amxc_htable_t, pClientList, NULL);
+        amxc_var_add_key(cstring_t, pClientMap, "MACAddress", macStr.cMac);
+        amxc_var_add_key(uint32_t, pClientMap, "Rate", pClientRate->rate);
+        amxc_var_add_key(uint32_t, pClientMap, "TargetRate", pClientRate->targetRate);
+        amxc_var_add_key(uint32_t, pClientMap, "PendingRate", pClientRate->pendingRate);
+        amxc_var_add_key(uint32_t, pClientMap, "EventRate", pClientRate->eventRate);
+        amxc_var_add_key(uint64_t, pClientMap, "Decreases", pClientRate->nrDecreases);
+        amxc_var_add_key(uint64_t, pClientMap, "Increases", pClientRate->nrIncreases);
+        amxc_var_add_key(uint64_t, pClientMap, "Rejected", pClientRate->nrRejected);
+    }
     return amxd_status_ok;
 }
@@ -29,6 +29,7 @@
 #include "whm_mxl_ep.h"
 #include "whm_mxl_cfgActions.h"
 #include "whm_mxl_dmnMngr.h"
+#include "whm_mxl_nlVendor.h"
 
 #define ME "mxlEp"
 
@@ -41,17 +42,10 @@ static swl_rc_ne s_getPeerFlowStatusCb(swl_rc_ne rc, struct nlmsghdr* nlh, void*
 
     struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
     ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
-    // parse data table
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    mtlk_wssa_drv_peer_stats_t* peerFlowStats = (mtlk_wssa_drv_peer_stats_t*) data;
-    ASSERT_NOT_NULL(peerFlowStats, SWL_RC_ERROR, ME, "NULL");
+    whm_mxl_nlVendorView_t view;
+    swl_rc_ne ret = whm_mxl_nlVendor_getReplyView(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_FLOW_STATUS, &view);
+    ASSERT_EQUALS(ret, SWL_RC_OK, ret, ME, "fail to decode peer flow status");
+    const mtlk_wssa_drv_peer_stats_t* peerFlowStats = WHM_MXL_NL_VENDOR_VIEW(&view, mtlk_wssa_drv_peer_stats_t);
     stats->LastDataDownlinkRate = peerFlowStats->tr181_stats.LastDataDownlinkRate;
     stats->LastDataUplinkRate = peerFlowStats->tr181_stats.LastDataUplinkRate;
     stats->RSSI = peerFlowStats->tr181_stats.SignalStrength;
@@ -60,14 +54,6 @@ static swl_rc_ne s_getPeerFlowStatusCb(swl_rc_ne rc, struct nlmsghdr* nlh, void*
     return rc;
 }
 
-static swl_rc_ne s_getPeerFlowStatus(T_EndPoint* pEP, T_EndPointStats* stats) {
-    swl_rc_ne rc;
-    uint32_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_FLOW_STATUS;
-    rc = wld_rad_nl80211_sendVendorSubCmd(pEP->pRadio, OUI_MXL, subcmd, pEP->pSSID->BSSID, ETHER_ADDR_LEN,
-                                          VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_getPeerFlowStatusCb, stats);
-    return rc;
-}
-
 static swl_rc_ne s_getPeerCapabilitiesCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
     ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "Request error");
     ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
@@ -76,17 +62,10 @@ static swl_rc_ne s_getPeerCapabilitiesCb(swl_rc_ne rc, struct nlmsghdr* nlh, voi
 
     struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
     ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
-    // parse data table
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    mtlk_wssa_drv_peer_capabilities_t* peerCapabilities = (mtlk_wssa_drv_peer_capabilities_t*) data;
-    ASSERT_NOT_NULL(peerCapabilities, SWL_RC_ERROR, ME, "NULL");
+    whm_mxl_nlVendorView_t view;
+    swl_rc_ne ret = whm_mxl_nlVendor_getReplyView(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_CAPABILITIES, &view);
+    ASSERT_EQUALS(ret, SWL_RC_OK, ret, ME, "fail to decode peer capabilities");
+    const mtlk_wssa_drv_peer_capabilities_t* peerCapabilities = WHM_MXL_NL_VENDOR_VIEW(&view, mtlk_wssa_drv_peer_capabilities_t);
     stats->assocCaps.htCapabilities |= (peerCapabilities->SGI20Supported ? M_SWL_STACAP_HT_SGI20 : 0);
     stats->assocCaps.htCapabilities |= (peerCapabilities->SGI40Supported ? M_SWL_STACAP_HT_SGI40 : 0);
     stats->assocCaps.htCapabilities |= (peerCapabilities->Intolerant_40MHz ? M_SWL_STACAP_HT_40MHZ_INTOL : 0);
@@ -94,14 +73,6 @@ static swl_rc_ne s_getPeerCapabilitiesCb(swl_rc_ne rc, struct nlmsghdr* nlh, voi
     return rc;
 }
 
-static swl_rc_ne s_getPeerCapabilities(T_EndPoint* pEP, T_EndPointStats* stats) {
-    swl_rc_ne rc;
-    uint32_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_CAPABILITIES;
-    rc = wld_rad_nl80211_sendVendorSubCmd(pEP->pRadio, OUI_MXL, subcmd, pEP->pSSID->BSSID, ETHER_ADDR_LEN,
-                                          VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_getPeerCapabilitiesCb, stats);
-    return rc;
-}
-
 static swl_rc_ne s_getPerClientStatsCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
     ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "Request error");
     ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
@@ -110,30 +81,179 @@ static swl_rc_ne s_getPerClientStatsCb(swl_rc_ne rc, struct nlmsghdr* nlh, void*
 
     struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
     ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
-    // parse data table
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    perClientStats_t* perClientStats = (perClientStats_t*) data;
-    ASSERT_NOT_NULL(perClientStats, SWL_RC_ERROR, ME, "NULL");
+    whm_mxl_nlVendorView_t view;
+    swl_rc_ne ret = whm_mxl_nlVendor_getReplyView(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_PER_CLIENT_STATS, &view);
+    ASSERT_EQUALS(ret, SWL_RC_OK, ret, ME, "fail to decode per client stats");
+    const perClientStats_t* perClientStats = WHM_MXL_NL_VENDOR_VIEW(&view, perClientStats_t);
     stats->rxRetries = perClientStats->mpduRetryCount;
 
     return rc;
 }
 
-static swl_rc_ne s_getPerClientStats(T_EndPoint* pEP, T_EndPointStats* stats) {
-    swl_rc_ne rc;
-    uint32_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_PER_CLIENT_STATS;
-    rc = wld_rad_nl80211_sendVendorSubCmd(pEP->pRadio, OUI_MXL, subcmd, pEP->pSSID->BSSID, ETHER_ADDR_LEN,
-                                          VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_getPerClientStatsCb, stats);
-    return rc;
+typedef enum {
+    MXL_EP_STATS_REQ_PEER_FLOW,     /* GET_PEER_FLOW_STATUS */
+    MXL_EP_STATS_REQ_PER_CLIENT,    /* GET_PER_CLIENT_STATS */
+    MXL_EP_STATS_REQ_PEER_CAPS,     /* GET_PEER_CAPABILITIES, only when not cached */
+    MXL_EP_STATS_REQ_MAX
+} whm_mxl_epStatsReqType_e;
+
+typedef struct whm_mxl_epStatsRound whm_mxl_epStatsRound_t;
+
+typedef struct {
+    whm_mxl_epStatsRound_t* pRound;
+    whm_mxl_epStatsReqType_e type;
+    bool done;
+} whm_mxl_epStatsReq_t;
+
+/* Per endpoint stats cache, the peer capabilities are kept for the whole association */
+typedef struct {
+    amxc_llist_it_t it;
+    T_EndPoint* pEP;
+    swl_macBin_t bssid;                     /* peer of the cached values */
+    wld_epConnectionStatus_e connStatus;    /* connection state of the cached values */
+    bool capsValid;
+    T_EndPointStats caps;                   /* assocCaps of the peer */
+    bool flowValid;                         /* dyn holds the last flow status */
+    bool perClientValid;                    /* dyn holds the last per client stats */
+    T_EndPointStats dyn;                    /* last flow status and per client stats */
+    whm_mxl_epStatsRound_t* pRound;         /* requests in flight, NULL when idle */
+} whm_mxl_epStatsCache_t;
+
+struct whm_mxl_epStatsRound {
+    whm_mxl_epStatsCache_t* pCache;         /* NULL when the endpoint is gone */
+    swl_timeMono_t startSec;
+    T_EndPointStats stats;
+    bool replied[MXL_EP_STATS_REQ_MAX];
+    uint32_t nrPending;                     /* pending replies, plus one ref held while issuing */
+    uint32_t nrReqs;
+    whm_mxl_epStatsReq_t reqs[MXL_EP_STATS_REQ_MAX];
+};
+
+/* A round older than this is abandoned and a new burst is issued */
+#define MXL_EP_STATS_ROUND_TIMEOUT_SEC 5
+
+static amxc_llist_t s_epStatsCaches = {NULL, NULL};
+
+static whm_mxl_epStatsCache_t* s_getEpStatsCache(T_EndPoint* pEP, bool create) {
+    amxc_llist_for_each(it, &s_epStatsCaches) {
+        whm_mxl_epStatsCache_t* pCache = amxc_container_of(it, whm_mxl_epStatsCache_t, it);
+        if(pCache->pEP == pEP) {
+            return pCache;
+        }
+    }
+    ASSERTS_TRUE(create, NULL, ME, "no stats cache");
+    whm_mxl_epStatsCache_t* pCache = calloc(1, sizeof(whm_mxl_epStatsCache_t));
+    ASSERT_NOT_NULL(pCache, NULL, ME, "%s: fail to allocate stats cache", pEP->Name);
+    pCache->pEP = pEP;
+    amxc_llist_append(&s_epStatsCaches, &pCache->it);
+    return pCache;
+}
+
+static void s_deleteEpStatsCache(T_EndPoint* pEP) {
+    whm_mxl_epStatsCache_t* pCache = s_getEpStatsCache(pEP, false);
+    ASSERTS_NOT_NULL(pCache, , ME, "no stats cache");
+    if(pCache->pRound != NULL) {
+        /* pending replies still release the round, which then frees itself */
+        pCache->pRound->pCache = NULL;
+    }
+    amxc_llist_it_take(&pCache->it);
+    free(pCache);
 }
 
+static void s_releaseEpStatsRound(whm_mxl_epStatsRound_t* pRound) {
+    if(--pRound->nrPending > 0) {
+        return;
+    }
+    whm_mxl_epStatsCache_t* pCache = pRound->pCache;
+    if(pCache != NULL) {
+        pCache->pRound = NULL;
+        /* only take the fields filled by the successful replies */
+        if(pRound->replied[MXL_EP_STATS_REQ_PEER_FLOW]) {
+            pCache->dyn.LastDataDownlinkRate = pRound->stats.LastDataDownlinkRate;
+            pCache->dyn.LastDataUplinkRate = pRound->stats.LastDataUplinkRate;
+            pCache->dyn.RSSI = pRound->stats.RSSI;
+            pCache->dyn.txRetries = pRound->stats.txRetries;
+            pCache->flowValid = true;
+        }
+        if(pRound->replied[MXL_EP_STATS_REQ_PER_CLIENT]) {
+            pCache->dyn.rxRetries = pRound->stats.rxRetries;
+            pCache->perClientValid = true;
+        }
+        if(pRound->replied[MXL_EP_STATS_REQ_PEER_CAPS]) {
+            pCache->caps = pRound->stats; /* struct copy */
+            pCache->capsValid = true;
+        }
+    }
+    free(pRound);
+}
+
+/* Single reply handler of the stats burst, terminating the request on its first call */
+static swl_rc_ne s_epStatsReplyCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
+    whm_mxl_epStatsReq_t* pReq = (whm_mxl_epStatsReq_t*) priv;
+    ASSERT_NOT_NULL(pReq, SWL_RC_ERROR, ME, "NULL");
+    ASSERTS_FALSE(pReq->done, SWL_RC_DONE, ME, "request already done");
+    whm_mxl_epStatsRound_t* pRound = pReq->pRound;
+    swl_rc_ne ret = SWL_RC_ERROR;
+    if((rc == SWL_RC_OK) && (nlh != NULL)) {
+        switch(pReq->type) {
+        case MXL_EP_STATS_REQ_PEER_FLOW: ret = s_getPeerFlowStatusCb(rc, nlh, &pRound->stats); break;
+        case MXL_EP_STATS_REQ_PER_CLIENT: ret = s_getPerClientStatsCb(rc, nlh, &pRound->stats); break;
+        case MXL_EP_STATS_REQ_PEER_CAPS: ret = s_getPeerCapabilitiesCb(rc, nlh, &pRound->stats); break;
+        default: break;
+        }
+    }
+    pRound->replied[pReq->type] = (ret >= SWL_RC_OK);
+    pReq->done = true;
+    s_releaseEpStatsRound(pRound);
+    return SWL_RC_DONE;
+}
+
+static void s_sendEpStatsReq(whm_mxl_epStatsRound_t* pRound, T_EndPoint* pEP, whm_mxl_epStatsReqType_e type, uint32_t subcmd) {
+    whm_mxl_epStatsReq_t* pReq = &pRound->reqs[pRound->nrReqs++];
+    pReq->pRound = pRound;
+    pReq->type = type;
+    pRound->nrPending++;
+    swl_rc_ne rc = wld_rad_nl80211_sendVendorSubCmd(pEP->pRadio, OUI_MXL, subcmd, pEP->pSSID->BSSID, ETHER_ADDR_LEN,
+                                                    VENDOR_SUBCMD_IS_ASYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_epStatsReplyCb, pReq);
+    if((rc < SWL_RC_OK) && !pReq->done) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to send stats request (type %d)", pEP->Name, type);
+        pReq->done = true;
+        s_releaseEpStatsRound(pRound);
+    }
+}
+
+static void s_startEpStatsRound(whm_mxl_epStatsCache_t* pCache, T_EndPoint* pEP) {
+    if(pCache->pRound != NULL) {
+        uint32_t elapsed = swl_time_getMonoSec() - pCache->pRound->startSec;
+        ASSERTI_TRUE(elapsed >= MXL_EP_STATS_ROUND_TIMEOUT_SEC, , ME, "%s: stats round in progress", pEP->Name);
+        SAH_TRACEZ_WARNING(ME, "%s: abandon stats round after %us", pEP->Name, elapsed);
+        pCache->pRound->pCache = NULL;
+        pCache->pRound = NULL;
+    }
+    whm_mxl_epStatsRound_t* pRound = calloc(1, sizeof(whm_mxl_epStatsRound_t));
+    ASSERT_NOT_NULL(pRound, , ME, "%s: fail to allocate stats round", pEP->Name);
+    pRound->pCache = pCache;
+    pRound->startSec = swl_time_getMonoSec();
+    pRound->nrPending = 1;
+    pCache->pRound = pRound;
+
+    // - LastDataDownlinkRate, LastDataUplinkRate, RSSI, Tx_Retransmissions
+    s_sendEpStatsReq(pRound, pEP, MXL_EP_STATS_REQ_PEER_FLOW, LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_FLOW_STATUS);
+    // - Rx_Retransmissions
+    s_sendEpStatsReq(pRound, pEP, MXL_EP_STATS_REQ_PER_CLIENT, LTQ_NL80211_VENDOR_SUBCMD_GET_PER_CLIENT_STATS);
+    if(!pCache->capsValid) {
+        // - HtCapabilities
+        s_sendEpStatsReq(pRound, pEP, MXL_EP_STATS_REQ_PEER_CAPS, LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_CAPABILITIES);
+    }
+    s_releaseEpStatsRound(pRound);
+}
+
+/*
+ * Endpoint vendor stats are fetched with one burst of async driver requests per poll,
+ * each poll returning the values of the previous burst.
+ * Peer capabilities are only requested again when the connection state or the remote BSSID changes.
+ * An error is returned while some vendor values were never received from the current peer.
+ */
 int whm_mxl_epStats(T_EndPoint* pEP, T_EndPointStats* stats) {
     SAH_TRACEZ_IN(ME);
     ASSERT_NOT_NULL(pEP, SWL_RC_INVALID_PARAM, ME, "NULL");
@@ -147,25 +267,41 @@ int whm_mxl_epStats(T_EndPoint* pEP, T_EndPointStats* stats) {
     ASSERTI_FALSE(swl_mac_binIsNull((swl_macBin_t*) pEP->pSSID->BSSID),
                   SWL_RC_OK, ME, "%s: seems not connected (no remote bssid)", pEP->Name);
 
-    // execute LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_FLOW_STATUS to get
-    // - LastDataDownlinkRate
-    // - LastDataUplinkRate
-    // - RSSI
-    // - Tx_Retransmissions
-    rc = s_getPeerFlowStatus(pEP, stats);
-    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "fail to get peer flow status");
-
-    // execute LTQ_NL80211_VENDOR_SUBCMD_GET_PER_CLIENT_STATS to get
-    // - Rx_Retransmissions
-    rc = s_getPerClientStats(pEP, stats);
-    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "fail to get per client stats");
+    whm_mxl_epStatsCache_t* pCache = s_getEpStatsCache(pEP, true);
+    ASSERT_NOT_NULL(pCache, SWL_RC_ERROR, ME, "%s: no stats cache", pEP->Name);
+    if((pCache->connStatus != pEP->connectionStatus) ||
+       (memcmp(pCache->bssid.bMac, pEP->pSSID->BSSID, ETHER_ADDR_LEN) != 0)) {
+        SAH_TRACEZ_INFO(ME, "%s: peer changed, flush cached stats", pEP->Name);
+        pCache->connStatus = pEP->connectionStatus;
+        memcpy(pCache->bssid.bMac, pEP->pSSID->BSSID, ETHER_ADDR_LEN);
+        pCache->capsValid = false;
+        pCache->flowValid = false;
+        pCache->perClientValid = false;
+        if(pCache->pRound != NULL) {
+            /* replies of the previous peer are dropped */
+            pCache->pRound->pCache = NULL;
+            pCache->pRound = NULL;
+        }
+    }
 
-    // execute LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_CAPABILITIES to get
-    // - HtCapabilities
-    rc = s_getPeerCapabilities(pEP, stats);
-    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "fail to get peer capabilities");
+    if(pCache->flowValid) {
+        stats->LastDataDownlinkRate = pCache->dyn.LastDataDownlinkRate;
+        stats->LastDataUplinkRate = pCache->dyn.LastDataUplinkRate;
+        stats->RSSI = pCache->dyn.RSSI;
+        stats->txRetries = pCache->dyn.txRetries;
+    }
+    if(pCache->perClientValid) {
+        stats->rxRetries = pCache->dyn.rxRetries;
+    }
+    if(pCache->capsValid) {
+        stats->assocCaps.htCapabilities |= pCache->caps.assocCaps.htCapabilities;
+    }
+    s_startEpStatsRound(pCache, pEP);
 
-    return rc;
+    ASSERTI_TRUE(pCache->flowValid && pCache->perClientValid && pCache->capsValid, SWL_RC_ERROR, ME,
+                 "%s: vendor stats not available yet (flow %d, per client %d, caps %d)", pEP->Name,
+                 pCache->flowValid, pCache->perClientValid, pCache->capsValid);
+    return SWL_RC_OK;
 }
 
 int whm_mxl_ep_createHook(T_EndPoint* pEP) {
@@ -180,6 +316,7 @@ int whm_mxl_ep_createHook(T_EndPoint* pEP) {
 int whm_mxl_ep_destroyHook(T_EndPoint* pEP) {
     ASSERT_NOT_NULL(pEP, SWL_RC_INVALID_PARAM, ME, "NULL");
     swl_rc_ne rc;
+    s_deleteEpStatsCache(pEP);
     CALL_NL80211_FTA_RET(rc, mfn_wendpoint_destroy_hook, pEP);
     ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "fail in generic call");
     mxl_dmnMngrCtx_t* pDmnCtx = whm_mxl_dmnMngr_getDmnCtx(MXL_WPASUPPLICANT);
@@ -18,6 +18,7 @@
 #include "swla/swla_chanspec.h"
 
 #include "wld/wld_radio.h"
+#include "wld/wld_accesspoint.h"
 #include "wld/wld_nl80211_compat.h"
 #include "wld/wld_nl80211_api.h"
 #include "wld/wld_nl80211_attr.h"
@@ -68,22 +69,26 @@ static void s_vendorEvtCb(void* pRef, void* pData _UNUSED, struct nlmsghdr* nlh,
         SAH_TRACEZ_INFO(ME, "%s: subcmd %"PRId64"", pRad->Name, subcmd);
     }
 
+    whm_mxl_nlVendorView_t view;
     switch(subcmd) {
     case LTQ_NL80211_VENDOR_EVENT_UNCONNECTED_STA: {
         SAH_TRACEZ_INFO(ME, "%s: parse NaSta event", pRad->Name);
-        if(mxl_parseNaStaStats(pRad, tb, NASTA_STATS_REQ_ASYNC, true) == SWL_RC_OK) {
+        ASSERT_EQUALS(whm_mxl_nlVendor_getEvtView(tb[NL80211_ATTR_VENDOR_DATA], subcmd, &view), SWL_RC_OK, , ME, "%s: invalid NaSta event", pRad->Name);
+        if(mxl_parseNaStaStats(pRad, &view, NASTA_STATS_REQ_ASYNC, true) == SWL_RC_OK) {
             whm_mxl_monitor_checkRunNaStaList(pRad);
         }
         break;
     }
     case LTQ_NL80211_VENDOR_EVENT_CHAN_DATA: {
         SAH_TRACEZ_INFO(ME, "%s: received chan data event", pRad->Name);
-        mxl_parseChanDataEvt(pRad, tb);
+        ASSERT_EQUALS(whm_mxl_nlVendor_getEvtView(tb[NL80211_ATTR_VENDOR_DATA], subcmd, &view), SWL_RC_OK, , ME, "%s: invalid chan data event", pRad->Name);
+        mxl_parseChanDataEvt(pRad, &view);
         break;
     }
     case LTQ_NL80211_VENDOR_EVENT_CSI_STATS: {
         SAH_TRACEZ_INFO(ME, "%s: received csi stats event", pRad->Name);
-        mxl_parseCsiStatsEvt(pRad, tb);
+        ASSERT_EQUALS(whm_mxl_nlVendor_getEvtView(tb[NL80211_ATTR_VENDOR_DATA], subcmd, &view), SWL_RC_OK, , ME, "%s: invalid csi stats event", pRad->Name);
+        mxl_parseCsiStatsEvt(pRad, &view);
         break;
     }
     default: {
@@ -116,6 +121,82 @@ static T_Radio* s_mxl_fetchRadio(void* userData, char* ifname) {
     return NULL;
 }
 
+/*
+ * Split event params into key/value slices, in place and in one pass.
+ * Tokens without '=' are kept as positional values (eg station MAC address).
+ */
+static void s_tokenizeEvtParams(whm_mxl_wpaEvt_t* pEvt) {
+    pEvt->nrArgs = 0;
+    const char* pos = pEvt->params;
+    while ((pos != NULL) && (*pos != '\0') && (pEvt->nrArgs < WPA_MSG_MAX_EVENT_ARGS)) {
+        while (*pos == ' ') {
+            pos++;
+        }
+        if (*pos == '\0') {
+            break;
+        }
+        const char* tokEnd = pos;
+        const char* sep = NULL;
+        while ((*tokEnd != '\0') && (*tokEnd != ' ')) {
+            if ((*tokEnd == '=') && (sep == NULL)) {
+                sep = tokEnd;
+            }
+            tokEnd++;
+        }
+        whm_mxl_wpaEvtArg_t* pArg = &pEvt->args[pEvt->nrArgs++];
+        if (sep != NULL) {
+            pArg->key = pos;
+            pArg->keyLen = sep - pos;
+            pArg->val = sep + 1;
+        } else {
+            pArg->key = NULL;
+            pArg->keyLen = 0;
+            pArg->val = pos;
+        }
+        pArg->valLen = tokEnd - pArg->val;
+        pos = tokEnd;
+    }
+}
+
+static const whm_mxl_wpaEvtArg_t* s_getEvtArg(const whm_mxl_wpaEvt_t* pEvt, const char* key) {
+    size_t keyLen = strlen(key);
+    for (uint32_t i = 0; i < pEvt->nrArgs; i++) {
+        const whm_mxl_wpaEvtArg_t* pArg = &pEvt->args[i];
+        if ((pArg->keyLen == keyLen) && (memcmp(pArg->key, key, keyLen) == 0)) {
+            return pArg;
+        }
+    }
+    return NULL;
+}
+
+static bool s_getEvtArgInt32(const whm_mxl_wpaEvt_t* pEvt, const char* key, int32_t* pVal) {
+    const whm_mxl_wpaEvtArg_t* pArg = s_getEvtArg(pEvt, key);
+    ASSERTS_NOT_NULL(pArg, false, ME, "no arg %s", key);
+    ASSERTS_TRUE(pArg->valLen > 0, false, ME, "empty arg %s", key);
+    char* end = NULL;
+    long val = strtol(pArg->val, &end, 0);
+    ASSERTS_EQUALS(end, pArg->val + pArg->valLen, false, ME, "invalid int arg %s", key);
+    *pVal = (int32_t) val;
+    return true;
+}
+
+static int32_t s_getEvtArgInt32Def(const whm_mxl_wpaEvt_t* pEvt, const char* key, int32_t defVal) {
+    int32_t val = defVal;
+    s_getEvtArgInt32(pEvt, key, &val);
+    return val;
+}
+
+static bool s_getEvtArgStr(const whm_mxl_wpaEvt_t* pEvt, const char* key, char* buf, size_t bufSize) {
+    const whm_mxl_wpaEvtArg_t* pArg = s_getEvtArg(pEvt, key);
+    ASSERTS_NOT_NULL(pArg, false, ME, "no arg %s", key);
+    swl_str_ncopy(buf, bufSize, pArg->val, pArg->valLen);
+    return true;
+}
+
+static bool s_evtNameMatches(const whm_mxl_wpaEvt_t* pEvt, const char* name) {
+    return (strlen(name) == pEvt->nameLen) && (memcmp(pEvt->name, name, pEvt->nameLen) == 0);
+}
+
 static void mxl_6ghz_chanspec_from_centreFreq(swl_chanspec_t* chanSpec, int32_t centrFreq) {
     int32_t centrChannel = 0;
 
@@ -135,7 +216,7 @@ static void mxl_6ghz_chanspec_from_centreFreq(swl_chanspec_t* chanSpec, int32_t
     }
 }
 
-static void s_mxl_ACSCompletedEvt(void* userData, char* ifName, char* event _UNUSED, char* params) {
+static void s_mxl_ACSCompletedEvt(void* userData, char* ifName, const whm_mxl_wpaEvt_t* pEvt) {
     T_Radio* pRad = s_mxl_fetchRadio(userData, ifName);
     ASSERT_NOT_NULL(pRad, , ME, "Could not get radio from ifname(%s)", ifName);
     ASSERTI_NOT_EQUALS(pRad, mxl_rad_getZwDfsRadio(), , ME, "ignore acs event on zwdfs radio (ifname:%s, radName:%s)",
@@ -152,7 +233,7 @@ static void s_mxl_ACSCompletedEvt(void* userData, char* ifName, char* event _UNU
     ASSERTW_EQUALS(pRad->autoChannelEnable, true, , ME, "%s: ACS event when ACS not enabled", pRad->Name);
 
     chanSpec.band = pRad->operatingFrequencyBand;
-    if (!wld_wpaCtrl_getValueIntExt(params, "freq", &freq)) {
+    if (!s_getEvtArgInt32(pEvt, "freq", &freq)) {
         SAH_TRACEZ_ERROR(ME, "%s: cannot get frequency", pRad->Name);
         return;
     }
@@ -160,17 +241,17 @@ static void s_mxl_ACSCompletedEvt(void* userData, char* ifName, char* event _UNU
     swl_chanspec_channelFromMHz(&chanSpec, freq);
     ASSERT_EQUALS(pRad->operatingFrequencyBand, chanSpec.band, , ME, "%s: unmatched radio freqBand(%s)", pRad->Name, swl_freqBandExt_str[chanSpec.band]);
 
-    if (!wld_wpaCtrl_getValueIntExt(params, "channel", &channel) || !channel) {
+    if (!s_getEvtArgInt32(pEvt, "channel", &channel) || !channel) {
         SAH_TRACEZ_ERROR(ME, "%s: cannot get channel", pRad->Name);
         return;
     }
 
-    if (!wld_wpaCtrl_getValueIntExt(params, "OperatingChannelBandwidt", &operCbw) || !operCbw) {
+    if (!s_getEvtArgInt32(pEvt, "OperatingChannelBandwidt", &operCbw) || !operCbw) {
         SAH_TRACEZ_ERROR(ME, "%s: cannot get bandwidth", pRad->Name);
         return;
     }
 
-    if (!wld_wpaCtrl_getValueIntExt(params, "cf1", &centreFreq)) {
+    if (!s_getEvtArgInt32(pEvt, "cf1", &centreFreq)) {
         SAH_TRACEZ_ERROR(ME, "%s: cannot get frequency", pRad->Name);
         return;
     }
@@ -195,7 +276,7 @@ static void s_mxl_ACSCompletedEvt(void* userData, char* ifName, char* event _UNU
  * - zwdfs CAC started   => notify BG DFS clear started and set ChannelMgt RadioStatus to BG_CAC/BG_CAC_NS
  * - zwdfs CAC completed => notify BG DFS clear ended and set ChannelMgt RadioStatus to Up
  */
-static void s_mxl_DfsCacEvts(void* userData _UNUSED, char* ifName, char* event, char* params) {
+static void s_mxl_DfsCacEvts(void* userData _UNUSED, char* ifName, const whm_mxl_wpaEvt_t* pEvt) {
     T_Radio* pRadZwDfs = mxl_rad_getZwDfsRadio();
     ASSERTS_NOT_NULL(pRadZwDfs, , ME, "NULL");
     ASSERTS_TRUE(swl_str_matches(ifName, pRadZwDfs->Name), ,ME, "%s: not zwdfs radio", ifName);
@@ -203,7 +284,7 @@ static void s_mxl_DfsCacEvts(void* userData _UNUSED, char* ifName, char* event,
     T_Radio* pRad5GHzData = wld_getRadioByFrequency(SWL_FREQ_BAND_5GHZ);
     ASSERT_NOT_NULL(pRad5GHzData, , ME, "NULL");
 
-    if(swl_str_matches(event, "DFS-CAC-START")) {
+    if(s_evtNameMatches(pEvt, "DFS-CAC-START")) {
         ASSERTI_TRUE((wld_rad_isUpAndReady(pRad5GHzData) && !wld_rad_isDoingDfsScan(pRad5GHzData)), ,ME,
                       "%s: not ready", pRad5GHzData->Name);
         wld_bgdfs_notifyClearStarted(pRad5GHzData, pRadZwDfs->targetChanspec.chanspec.channel,
@@ -213,16 +294,24 @@ static void s_mxl_DfsCacEvts(void* userData _UNUSED, char* ifName, char* event,
         } else {
             pRad5GHzData->detailedState = CM_RAD_BG_CAC_NS;
         }
-    } else if(swl_str_matches(event, "DFS-CAC-COMPLETED")) {
+    } else if(s_evtNameMatches(pEvt, "DFS-CAC-COMPLETED")) {
         ASSERTI_TRUE(((pRad5GHzData->detailedState  == CM_RAD_BG_CAC) || (pRad5GHzData->detailedState  == CM_RAD_BG_CAC_NS)), ,ME,
                       "%s: detailedState %s", pRad5GHzData->Name, cstr_chanmgt_rad_state[pRad5GHzData->detailedState]);
-        bool success = wld_wpaCtrl_getValueInt(params, "success");
+        bool success = s_getEvtArgInt32Def(pEvt, "success", 0);
         wld_bgdfs_notifyClearEnded(pRad5GHzData, (success ? DFS_RESULT_OK : DFS_RESULT_OTHER));
         pRad5GHzData->detailedState = CM_RAD_UP;
     }
     wld_rad_updateState(pRad5GHzData, false);
 }
 
+/* hostapd events resuming a reconf FSM waiting for the BSS to come back */
+static void s_mxl_notifyReconfFsm(void* userData _UNUSED, char* ifName, const whm_mxl_wpaEvt_t* pEvt _UNUSED) {
+    T_AccessPoint* pAP = wld_vap_from_name(ifName);
+    ASSERTS_NOT_NULL(pAP, , ME, "%s: no vap", ifName);
+    whm_mxl_reconfFsm_notifyEvent(pAP->pRadio);
+}
+
+/* Events handled on top of pwhm own processing */
 SWL_TABLE(mxl_WpaCtrlEvents,
           ARR(char* evtName; void* evtParser; ),
           ARR(swl_type_charPtr, swl_type_voidPtr),
@@ -230,35 +319,10 @@ SWL_TABLE(mxl_WpaCtrlEvents,
               {"ACS-COMPLETED", &s_mxl_ACSCompletedEvt},
               {"DFS-CAC-START", &s_mxl_DfsCacEvts},
               {"DFS-CAC-COMPLETED", &s_mxl_DfsCacEvts},
+              {"AP-ENABLED", &s_mxl_notifyReconfFsm},
+              {"INTERFACE-ENABLED", &s_mxl_notifyReconfFsm},
               ));
 
-static evtParser_f s_mxl_getEventParser(char* eventName) {
-    evtParser_f* pfEvtHdlr = (evtParser_f*) swl_table_getMatchingValue(&mxl_WpaCtrlEvents, 1, 0, eventName);
-    ASSERTS_NOT_NULL(pfEvtHdlr, NULL, ME, "no handler defined for evt(%s)", eventName);
-    return *pfEvtHdlr;
-}
-
-static void s_mxl_WpaCtrlEvtMsg(void* userData, char* ifName, char* msgData) {
-    ASSERTS_STR(msgData, , ME, "NULL or no content msgData");
-    char* pEvent = strstr(msgData, WPA_MSG_LEVEL_INFO);
-    ASSERTS_NOT_NULL(pEvent, , ME, "Not a valid WPA ctrl event");
-    pEvent += sizeof(WPA_MSG_LEVEL_INFO) - 1;
-
-    uint32_t eventNameLen = strlen(pEvent);
-    char* pParams = strchr(pEvent, ' ');
-    if (pParams) {
-        eventNameLen = pParams - pEvent;
-        pParams++;
-    }
-    char eventName[eventNameLen + 1];
-    swl_str_copy(eventName, sizeof(eventName), pEvent);
-    evtParser_f fEvtHdlr = s_mxl_getEventParser(eventName);
-    ASSERTS_NOT_NULL(fEvtHdlr, , ME, "%s: No parser for evt(%s)", ifName, eventName);
-
-    SAH_TRACEZ_INFO(ME, "%s: receive msg '%s'", ifName, msgData);
-    fEvtHdlr(userData, ifName, eventName, pParams);
-}
-
 static void s_mxl_ObssCoexBwChngd(T_Radio* pRad, uint32_t channel, uint32_t operCbw) {
     ASSERT_NOT_NULL(pRad, , ME, "pRad is NULL");
     swl_chanspec_t newChanSpec = SWL_CHANSPEC_EMPTY;
@@ -273,21 +337,22 @@ static void s_mxl_ObssCoexBwChngd(T_Radio* pRad, uint32_t channel, uint32_t oper
     s_updateNewChanspec(pRad, &newChanSpec, CHAN_REASON_OBSS_COEX);
 }
 
-static void s_mxl_apBwChanged(void* userData, char* ifName _UNUSED, char* event _UNUSED, char* params _UNUSED) {
+static void s_mxl_apBwChanged(void* userData, char* ifName _UNUSED, const whm_mxl_wpaEvt_t* pEvt) {
     /* Expected msg format:
      * <3>AP-BW-CHANGED freq=%d Channel=%d OperatingChannelBandwidth=%d ExtensionChannel=%d cf1=%d cf2=%d reason=%s dfs_chan=%d
      */
     T_Radio* pRad = (T_Radio*) userData;
-    uint32_t channel = wld_wpaCtrl_getValueInt(params, "Channel");
-    uint32_t operCbw = wld_wpaCtrl_getValueInt(params, "OperatingChannelBandwidth");
+    uint32_t channel = s_getEvtArgInt32Def(pEvt, "Channel", 0);
+    uint32_t operCbw = s_getEvtArgInt32Def(pEvt, "OperatingChannelBandwidth", 0);
     char reason[64] = {0};
-    if (wld_wpaCtrl_getValueStr(params, "reason", reason, sizeof(reason)) > 0) {
+    if (s_getEvtArgStr(pEvt, "reason", reason, sizeof(reason))) {
         if (swl_str_matches(reason, "OBSS")) {
             s_mxl_ObssCoexBwChngd(pRad, channel, operCbw);
         }
     }
 }
 
+/* Events handled instead of pwhm own processing */
 SWL_TABLE(mxl_CustomWpaCtrlEvents,
           ARR(char* evtName; void* evtParser; ),
           ARR(swl_type_charPtr, swl_type_voidPtr),
@@ -295,32 +360,109 @@ SWL_TABLE(mxl_CustomWpaCtrlEvents,
               {"AP-BW-CHANGED", &s_mxl_apBwChanged},
               ));
 
-static evtParser_f s_mxl_getCustomEventParser(char* eventName) {
-    evtParser_f* pfEvtHdlr = (evtParser_f*) swl_table_getMatchingValue(&mxl_CustomWpaCtrlEvents, 1, 0, eventName);
-    ASSERTS_NOT_NULL(pfEvtHdlr, NULL, ME, "no handler defined for evt(%s)", eventName);
-    return *pfEvtHdlr;
+/*
+ * Hashed index of the event tables, built on first event:
+ * most received events have no vendor handler, and are rejected with one hash lookup.
+ */
+#define MXL_WPA_EVT_INDEX_SIZE 32 /* power of 2, at least twice the number of handled events */
+
+typedef struct {
+    const char* name;
+    uint32_t nameLen;
+    evtParser_f fParser;
+    bool custom;
+} mxl_wpaEvtIndexEntry_t;
+
+static mxl_wpaEvtIndexEntry_t s_evtIndex[MXL_WPA_EVT_INDEX_SIZE];
+static bool s_evtIndexBuilt = false;
+
+static uint32_t s_hashEvtName(const char* name, uint32_t len) {
+    uint32_t hash = 2166136261u; /* FNV-1a */
+    for (uint32_t i = 0; i < len; i++) {
+        hash ^= (uint8_t) name[i];
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
-static swl_rc_ne s_mxl_WpaCustomCtrlEvtMsg(void* userData, char* ifName, char* msgData) {
+static void s_addEvtIndexEntries(swl_table_t* pTable, bool custom) {
+    for (size_t i = 0; i < pTable->nrTuples; i++) {
+        const char** pName = (const char**) swl_table_getValue(pTable, i, 0);
+        evtParser_f* pfParser = (evtParser_f*) swl_table_getValue(pTable, i, 1);
+        if ((pName == NULL) || (pfParser == NULL)) {
+            continue;
+        }
+        uint32_t nameLen = strlen(*pName);
+        uint32_t slot = s_hashEvtName(*pName, nameLen) & (MXL_WPA_EVT_INDEX_SIZE - 1);
+        uint32_t nrProbes = 0;
+        while ((s_evtIndex[slot].name != NULL) && (nrProbes++ < MXL_WPA_EVT_INDEX_SIZE)) {
+            slot = (slot + 1) & (MXL_WPA_EVT_INDEX_SIZE - 1);
+        }
+        if (s_evtIndex[slot].name != NULL) {
+            SAH_TRACEZ_ERROR(ME, "event index full, skip %s", *pName);
+            continue;
+        }
+        s_evtIndex[slot].name = *pName;
+        s_evtIndex[slot].nameLen = nameLen;
+        s_evtIndex[slot].fParser = *pfParser;
+        s_evtIndex[slot].custom = custom;
+    }
+}
+
+static const mxl_wpaEvtIndexEntry_t* s_findEvtIndexEntry(const char* name, uint32_t nameLen) {
+    if (!s_evtIndexBuilt) {
+        s_addEvtIndexEntries(&mxl_WpaCtrlEvents, false);
+        s_addEvtIndexEntries(&mxl_CustomWpaCtrlEvents, true);
+        s_evtIndexBuilt = true;
+    }
+    uint32_t slot = s_hashEvtName(name, nameLen) & (MXL_WPA_EVT_INDEX_SIZE - 1);
+    for (uint32_t i = 0; (i < MXL_WPA_EVT_INDEX_SIZE) && (s_evtIndex[slot].name != NULL); i++) {
+        if ((s_evtIndex[slot].nameLen == nameLen) && (memcmp(s_evtIndex[slot].name, name, nameLen) == 0)) {
+            return &s_evtIndex[slot];
+        }
+        slot = (slot + 1) & (MXL_WPA_EVT_INDEX_SIZE - 1);
+    }
+    return NULL;
+}
+
+/*
+ * Locate the event name in the message and look up its handler.
+ * Params are only tokenized for events that have a handler of the requested kind.
+ */
+static swl_rc_ne s_mxl_dispatchWpaCtrlEvt(void* userData, char* ifName, char* msgData, bool custom) {
     ASSERTS_STR(msgData, SWL_RC_ERROR, ME, "NULL or no content msgData");
-    char* pEvent = strstr(msgData, WPA_MSG_LEVEL_INFO);
-    ASSERTS_NOT_NULL(pEvent, SWL_RC_ERROR, ME, "Not a valid WPA ctrl event");
-    pEvent += sizeof(WPA_MSG_LEVEL_INFO) - 1;
-    uint32_t eventNameLen = strlen(pEvent);
-    char* pParams = strchr(pEvent, ' ');
-    if (pParams) {
-        eventNameLen = pParams - pEvent;
-        pParams++;
+    const char* pEvent = msgData;
+    if (strncmp(msgData, WPA_MSG_LEVEL_INFO, sizeof(WPA_MSG_LEVEL_INFO) - 1) != 0) {
+        pEvent = strstr(msgData, WPA_MSG_LEVEL_INFO);
+        ASSERTS_NOT_NULL(pEvent, SWL_RC_ERROR, ME, "Not a valid WPA ctrl event");
     }
-    char eventName[eventNameLen + 1];
-    swl_str_copy(eventName, sizeof(eventName), pEvent);
-    evtParser_f fEvtHdlr = s_mxl_getCustomEventParser(eventName);
-    ASSERTS_NOT_NULL(fEvtHdlr, SWL_RC_ERROR, ME, "%s: No parser for evt(%s)", ifName, eventName)
+    pEvent += sizeof(WPA_MSG_LEVEL_INFO) - 1;
+
+    whm_mxl_wpaEvt_t evt;
+    evt.name = pEvent;
+    const char* pParams = strchr(pEvent, ' ');
+    evt.nameLen = (pParams != NULL) ? (uint32_t) (pParams - pEvent) : strlen(pEvent);
+    evt.params = (pParams != NULL) ? (pParams + 1) : NULL;
+    evt.nrArgs = 0;
+
+    const mxl_wpaEvtIndexEntry_t* pEntry = s_findEvtIndexEntry(evt.name, evt.nameLen);
+    ASSERTS_NOT_NULL(pEntry, SWL_RC_ERROR, ME, "%s: no handler defined for evt(%.*s)", ifName, (int) evt.nameLen, evt.name);
+    ASSERTS_EQUALS(pEntry->custom, custom, SWL_RC_ERROR, ME, "%s: evt(%s) not handled here", ifName, pEntry->name);
+
+    s_tokenizeEvtParams(&evt);
     SAH_TRACEZ_INFO(ME, "%s: receive msg '%s'", ifName, msgData);
-    fEvtHdlr(userData, ifName, eventName, pParams);
+    pEntry->fParser(userData, ifName, &evt);
     return SWL_RC_OK;
 }
 
+static void s_mxl_WpaCtrlEvtMsg(void* userData, char* ifName, char* msgData) {
+    s_mxl_dispatchWpaCtrlEvt(userData, ifName, msgData, false);
+}
+
+static swl_rc_ne s_mxl_WpaCustomCtrlEvtMsg(void* userData, char* ifName, char* msgData) {
+    return s_mxl_dispatchWpaCtrlEvt(userData, ifName, msgData, true);
+}
+
 static swl_rc_ne s_mxl_setRadioWpaCtrlEvtHandlers(T_Radio* pRad) {
     void* userdata = NULL;
     wld_wpaCtrl_radioEvtHandlers_cb handlers = {0};
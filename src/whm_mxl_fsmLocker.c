@@ -16,6 +16,7 @@
 #include "whm_mxl_fsmLocker.h"
 #include "whm_mxl_reconfMngr.h"
 #include "whm_mxl_rad.h"
+#include "whm_mxl_utils.h"
 
 #define ME "mxlLck"
 
@@ -23,6 +24,9 @@
 #define RADIO_INDEX_MASK                    (0x00FF)
 #define GENERIC_FSM_OFFSET_IN_LOCK_BITMAP   (0x0)
 #define RECONF_FSM_OFFSET_IN_LOCK_BITMAP    (0x4)
+#define NUM_OF_FSM_BITS_IN_LOCK_BITMAP      (0x8)
+/* Cross radio waiter not retrying within this time is considered gone */
+#define CROSS_RADIO_WAIT_VALIDITY_MS        (2000)
 
 /*
 *   Locking bitmap is as follows:
@@ -30,52 +34,132 @@
 *   |----------------------------------------------------------------------------------------------------------|
 *   | BIT               | b'8  |   b'7   |   b'6   |   b'5   |  b'4    |   b'3   |   b'2   |   b'1   |   b'0   |
 *   |----------------------------------------------------------------------------------------------------------|
-*   |   Per FMS         |      | Reconf  | Reconf  | Reconf  | Reconf  | Generic | Generic | Generic | Generic |
-*   |   Radio           | LOCK | FSM     | FSM     | FSM     | FSM     | FSM     | FSM     | FSM     | FSM     |
-*   |   Bit Index       |      | radio 3 | radio 2 | radio 1 | radio 0 | radio 3 | radio 2 | radio 1 | radio 0 |
+*   |   Per FMS         | CROSS| Reconf  | Reconf  | Reconf  | Reconf  | Generic | Generic | Generic | Generic |
+*   |   Radio           | RAD  | FSM     | FSM     | FSM     | FSM     | FSM     | FSM     | FSM     | FSM     |
+*   |   Bit Index       | LOCK | radio 3 | radio 2 | radio 1 | radio 0 | radio 3 | radio 2 | radio 1 | radio 0 |
 *   |----------------------------------------------------------------------------------------------------------|
-*	
+*
+*   Each radio is its own lock domain: the generic FSM and the reconf FSM of a radio
+*   exclude each other, while FSMs of different radios may run in parallel.
+*   Operations spanning several radios (shared hostapd restart/reconf, 6G co-located
+*   beacon updates) take the cross radio lock, which is exclusive with all domains.
+*   While a cross radio lock request is waiting, no new radio domain lock is granted,
+*   so that the cross radio request is not starved.
 */
 
 static int s_radFSMLockBitMap = 0;
 static int s_radFSMWaiting = 0;
+static int s_crossRadFSMWaiting = 0;
+static swl_timeSpecMono_t s_crossRadFSMWaitTime[NUM_OF_FSM_BITS_IN_LOCK_BITMAP];
+
+static int s_getRadDomainMask(T_Radio* pRad) {
+    return (((1 << pRad->ref_index) << GENERIC_FSM_OFFSET_IN_LOCK_BITMAP) |
+            ((1 << pRad->ref_index) << RECONF_FSM_OFFSET_IN_LOCK_BITMAP));
+}
+
+static void s_setCrossRadWaiting(int bitmask) {
+    s_crossRadFSMWaiting |= bitmask;
+    for (int i = 0; i < NUM_OF_FSM_BITS_IN_LOCK_BITMAP; i++) {
+        if (bitmask & (1 << i)) {
+            swl_timespec_getMono(&s_crossRadFSMWaitTime[i]);
+        }
+    }
+}
 
-static bool s_lock(T_Radio* pRad, int bitmask) {
-    if ((s_radFSMLockBitMap & RADIO_INDEX_MASK) == bitmask) {
-        SAH_TRACEZ_ERROR(ME, "%s: requesting lock while has lock 0x%x", pRad->Name, s_radFSMLockBitMap);
+static bool s_hasOtherCrossRadWaiting(int bitmask) {
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    for (int i = 0; i < NUM_OF_FSM_BITS_IN_LOCK_BITMAP; i++) {
+        if (!(s_crossRadFSMWaiting & (1 << i)) || (bitmask & (1 << i))) {
+            continue;
+        }
+        if (swl_timespec_diffToMillisec(&s_crossRadFSMWaitTime[i], &now) > CROSS_RADIO_WAIT_VALIDITY_MS) {
+            /* Waiter stopped retrying */
+            s_crossRadFSMWaiting &= ~(1 << i);
+            continue;
+        }
         return true;
     }
+    return false;
+}
+
+static bool s_lock(T_Radio* pRad, int bitmask, bool crossRadio) {
+    int lockedFsms = (s_radFSMLockBitMap & RADIO_INDEX_MASK);
+
+    if (lockedFsms & bitmask) {
+        if (!crossRadio || (s_radFSMLockBitMap & RADIO_LOCK)) {
+            SAH_TRACEZ_INFO(ME, "%s: requesting lock while has lock 0x%x", pRad->Name, s_radFSMLockBitMap);
+            return true;
+        }
+        /* Upgrade radio domain lock to cross radio lock, only when no other FSM holds a lock */
+        if (lockedFsms != bitmask) {
+            s_setCrossRadWaiting(bitmask);
+            return false;
+        }
+        s_radFSMLockBitMap |= RADIO_LOCK;
+        s_crossRadFSMWaiting &= ~(bitmask);
+        return true;
+    }
+
+    bool available;
+    if (crossRadio) {
+        available = (s_radFSMLockBitMap == 0);
+    } else {
+        available = !(s_radFSMLockBitMap & RADIO_LOCK) &&
+                    !(lockedFsms & s_getRadDomainMask(pRad)) &&
+                    !s_hasOtherCrossRadWaiting(bitmask);
+    }
 
-    if (s_radFSMLockBitMap) {
+    if (!available) {
+        if (crossRadio) {
+            s_setCrossRadWaiting(bitmask);
+        }
         s_radFSMWaiting |= bitmask;
         return false;
-    } else {
-        s_radFSMLockBitMap = RADIO_LOCK | bitmask;
-        s_radFSMWaiting &= ~(bitmask);
-        return true;
     }
+
+    s_radFSMLockBitMap |= (crossRadio ? (RADIO_LOCK | bitmask) : bitmask);
+    s_radFSMWaiting &= ~(bitmask);
+    s_crossRadFSMWaiting &= ~(bitmask);
+    return true;
 }
 
 static void s_unLock(T_Radio* pRad, int bitmask) {
-    if ((s_radFSMLockBitMap & RADIO_INDEX_MASK) != bitmask) {
+    /* FSM giving up on the lock is no more waiting for it */
+    s_radFSMWaiting &= ~(bitmask);
+    s_crossRadFSMWaiting &= ~(bitmask);
+    if (!(s_radFSMLockBitMap & bitmask)) {
         SAH_TRACEZ_ERROR(ME, "%s: freeing lock while not has lock 0x%0x", pRad->Name, s_radFSMLockBitMap);
         return;
     }
-    s_radFSMLockBitMap = 0;
+    s_radFSMLockBitMap &= ~(bitmask);
+    /* Cross radio lock is exclusive - release it along with its owner */
+    if (!(s_radFSMLockBitMap & RADIO_INDEX_MASK)) {
+        s_radFSMLockBitMap = 0;
+    }
 }
 
 static void s_ensureLock(T_Radio* pRad, int bitmask) {
-    if ((s_radFSMLockBitMap & RADIO_INDEX_MASK) != bitmask) {
+    if (!(s_radFSMLockBitMap & bitmask)) {
         SAH_TRACEZ_ERROR(ME, "%s: Checking lock while not has lock 0x%0x", pRad->Name, s_radFSMLockBitMap);
     }
 }
 
+/*
+ * Generic FSM starts/stops hostapd: when the daemon is shared between radios,
+ * the action impacts all group members, hence it requires the cross radio lock.
+ */
+static bool s_genericFsmNeedsCrossRadLock(T_Radio* pRad) {
+    return (whm_mxl_utils_numOfGrpMembers(pRad) > 1);
+}
+
 static bool s_genericFsmLock_ext(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRad, false, ME, "NULL");
     int radFsmIdx = ((1 << pRad->ref_index) << GENERIC_FSM_OFFSET_IN_LOCK_BITMAP);
-    bool lockStatus = s_lock(pRad, radFsmIdx);
-    SAH_TRACEZ_INFO(ME, "%s: Generic FSM Lock Req for idx:0x%x lockStatus %d lockBitmap:0x%x WaitingBitmap:0x%x",
-                                                                            pRad->Name, radFsmIdx, lockStatus,
+    bool crossRadio = s_genericFsmNeedsCrossRadLock(pRad);
+    bool lockStatus = s_lock(pRad, radFsmIdx, crossRadio);
+    SAH_TRACEZ_INFO(ME, "%s: Generic FSM Lock Req for idx:0x%x cross:%d lockStatus %d lockBitmap:0x%x WaitingBitmap:0x%x",
+                                                                            pRad->Name, radFsmIdx, crossRadio, lockStatus,
                                                                             s_radFSMLockBitMap, s_radFSMWaiting);
     return lockStatus;
 }
@@ -95,12 +179,19 @@ static void s_genericFsmEnsureLock_ext(T_Radio* pRad) {
     s_ensureLock(pRad, radFsmIdx);
 }
 
-bool whm_mxl_reconfFsmLock(T_Radio* pRad) {
+/**
+ * @brief Try to lock the reconf FSM of a radio
+ *
+ * @param pRad Pointer to radio context
+ * @param crossRadio true if the requested actions impact other radios
+ * @return true if lock is acquired (or already held), false otherwise
+ */
+bool whm_mxl_reconfFsmLock(T_Radio* pRad, bool crossRadio) {
     ASSERT_NOT_NULL(pRad, false, ME, "NULL");
     int radFsmIdx = ((1 << pRad->ref_index) << RECONF_FSM_OFFSET_IN_LOCK_BITMAP);
-    bool lockStatus = s_lock(pRad, radFsmIdx);
-    SAH_TRACEZ_INFO(ME, "%s: Reconf FSM Lock Req for idx:0x%x lockStatus %d lockBitmap:0x%x WaitingBitmap:0x%x",
-                                                                            pRad->Name, radFsmIdx, lockStatus,
+    bool lockStatus = s_lock(pRad, radFsmIdx, crossRadio);
+    SAH_TRACEZ_INFO(ME, "%s: Reconf FSM Lock Req for idx:0x%x cross:%d lockStatus %d lockBitmap:0x%x WaitingBitmap:0x%x",
+                                                                            pRad->Name, radFsmIdx, crossRadio, lockStatus,
                                                                             s_radFSMLockBitMap, s_radFSMWaiting);
     return lockStatus;
 }
@@ -124,6 +215,7 @@ void whm_mxl_reconfFsmEnsureLock(T_Radio* pRad) {
 static void s_resetLocker(void) {
     s_radFSMLockBitMap = 0;
     s_radFSMWaiting = 0;
+    s_crossRadFSMWaiting = 0;
 }
 
 /**
@@ -0,0 +1,303 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : whm_mxl_hapdConf.c                                    *
+*         Description  : Incremental writer of the hostapd config file         *
+*                                                                              *
+*  *****************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "swl/swl_common.h"
+#include "wld/wld.h"
+#include "wld/wld_hostapd_cfgFile.h"
+
+#include "whm_mxl_hapdConf.h"
+#include "whm_mxl_rad.h"
+#include "whm_mxl_cfgActions.h"
+
+#define ME "mxlHapd"
+
+#define MXL_HAPD_CONF_BSS_KEY "bss="
+#define MXL_HAPD_CONF_TMP_SUFFIX ".tmp"
+
+static whm_mxl_hapdConf_t* s_getHapdConf(T_Radio* pRad) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, NULL, ME, "NULL");
+    return &pRadVendor->hapdConf;
+}
+
+static uint32_t s_hashContent(const char* buf, size_t len) {
+    uint32_t hash = 2166136261u; /* FNV-1a */
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t) buf[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static char* s_readFile(const char* path, struct stat* pSt) {
+    FILE* fp = fopen(path, "r");
+    ASSERTS_NOT_NULL(fp, NULL, ME, "Error opening file %s", path);
+    if ((fstat(fileno(fp), pSt) < 0) || (pSt->st_size < 0)) {
+        SAH_TRACEZ_ERROR(ME, "Fail to stat %s", path);
+        fclose(fp);
+        return NULL;
+    }
+    char* buf = malloc(pSt->st_size + 1);
+    if (buf == NULL) {
+        SAH_TRACEZ_ERROR(ME, "Fail to allocate buffer for %s", path);
+        fclose(fp);
+        return NULL;
+    }
+    size_t len = fread(buf, 1, pSt->st_size, fp);
+    fclose(fp);
+    buf[len] = '\0';
+    return buf;
+}
+
+static bool s_fileMatches(whm_mxl_hapdConf_t* pConf, const struct stat* pSt) {
+    return pConf->valid &&
+           (pConf->ino == pSt->st_ino) &&
+           (pConf->size == pSt->st_size) &&
+           (pConf->mtime.tv_sec == pSt->st_mtim.tv_sec) &&
+           (pConf->mtime.tv_nsec == pSt->st_mtim.tv_nsec);
+}
+
+static void s_saveFileId(whm_mxl_hapdConf_t* pConf, const struct stat* pSt) {
+    pConf->ino = pSt->st_ino;
+    pConf->size = pSt->st_size;
+    pConf->mtime = pSt->st_mtim;
+    pConf->valid = true;
+}
+
+static whm_mxl_hapdConfSection_t* s_addSection(whm_mxl_hapdConf_t* pConf) {
+    if (pConf->nrSections == pConf->maxSections) {
+        uint32_t maxSections = pConf->maxSections ? (pConf->maxSections * 2) : 8;
+        whm_mxl_hapdConfSection_t* newSections = realloc(pConf->sections, maxSections * sizeof(*newSections));
+        ASSERT_NOT_NULL(newSections, NULL, ME, "Fail to allocate config sections");
+        pConf->sections = newSections;
+        pConf->maxSections = maxSections;
+    }
+    whm_mxl_hapdConfSection_t* pSection = &pConf->sections[pConf->nrSections++];
+    memset(pSection, 0, sizeof(*pSection));
+    return pSection;
+}
+
+/*
+ * Split the config file into the radio header and one section per "bss=" line,
+ * and hash every section.
+ */
+static bool s_parseSections(whm_mxl_hapdConf_t* pConf, const char* buf, size_t len) {
+    pConf->nrSections = 0;
+    whm_mxl_hapdConfSection_t* pSection = s_addSection(pConf);
+    ASSERT_NOT_NULL(pSection, false, ME, "NULL");
+    size_t pos = 0;
+    while (pos < len) {
+        const char* line = &buf[pos];
+        const char* eol = memchr(line, '\n', len - pos);
+        size_t lineLen = (eol != NULL) ? (size_t) (eol - line + 1) : (len - pos);
+        if ((pos > 0) && (strncmp(line, MXL_HAPD_CONF_BSS_KEY, strlen(MXL_HAPD_CONF_BSS_KEY)) == 0)) {
+            pSection->len = pos - pSection->offset;
+            pSection->hash = s_hashContent(&buf[pSection->offset], pSection->len);
+            pSection = s_addSection(pConf);
+            ASSERT_NOT_NULL(pSection, false, ME, "NULL");
+            pSection->offset = pos;
+            size_t nameLen = lineLen - strlen(MXL_HAPD_CONF_BSS_KEY) - ((eol != NULL) ? 1 : 0);
+            swl_str_ncopy(pSection->name, sizeof(pSection->name), line + strlen(MXL_HAPD_CONF_BSS_KEY), nameLen);
+        }
+        pos += lineLen;
+    }
+    pSection->len = len - pSection->offset;
+    pSection->hash = s_hashContent(&buf[pSection->offset], pSection->len);
+    return true;
+}
+
+static const whm_mxl_hapdConfSection_t* s_findSection(const whm_mxl_hapdConf_t* pConf, const char* name) {
+    for (uint32_t i = 0; i < pConf->nrSections; i++) {
+        if (swl_str_matches(pConf->sections[i].name, name)) {
+            return &pConf->sections[i];
+        }
+    }
+    return NULL;
+}
+
+/* Count sections added, removed or changed from pOld to pNew */
+static uint32_t s_countChangedSections(const whm_mxl_hapdConf_t* pOld, const whm_mxl_hapdConf_t* pNew) {
+    uint32_t nrChanged = 0;
+    for (uint32_t i = 0; i < pNew->nrSections; i++) {
+        const whm_mxl_hapdConfSection_t* pNewSection = &pNew->sections[i];
+        const whm_mxl_hapdConfSection_t* pOldSection = s_findSection(pOld, pNewSection->name);
+        if ((pOldSection == NULL) || (pOldSection->hash != pNewSection->hash) || (pOldSection->len != pNewSection->len)) {
+            SAH_TRACEZ_INFO(ME, "config section [%s] changed", pNewSection->name);
+            nrChanged++;
+        }
+    }
+    for (uint32_t i = 0; i < pOld->nrSections; i++) {
+        if (s_findSection(pNew, pOld->sections[i].name) == NULL) {
+            SAH_TRACEZ_INFO(ME, "config section [%s] removed", pOld->sections[i].name);
+            nrChanged++;
+        }
+    }
+    return nrChanged;
+}
+
+/* Refresh the cached layout when the config file was written by someone else since our last write */
+static void s_syncWithFile(whm_mxl_hapdConf_t* pConf, const char* path) {
+    struct stat st;
+    if (stat(path, &st) < 0) {
+        pConf->valid = false;
+        pConf->nrSections = 0;
+        return;
+    }
+    if (s_fileMatches(pConf, &st)) {
+        return;
+    }
+    char* buf = s_readFile(path, &st);
+    if (buf == NULL) {
+        pConf->valid = false;
+        pConf->nrSections = 0;
+        return;
+    }
+    if (s_parseSections(pConf, buf, strlen(buf))) {
+        s_saveFileId(pConf, &st);
+    } else {
+        pConf->valid = false;
+    }
+    free(buf);
+}
+
+/* Direct write of the config file, when the generate and compare path fails */
+static void s_createExt(T_Radio* pRad) {
+    whm_mxl_cfgShadow_setRecording(true);
+    wld_hostapd_cfgFile_createExt(pRad);
+    whm_mxl_cfgShadow_setRecording(false);
+}
+
+/**
+ * @brief Write the hostapd config file of the radio, only when its content changed
+ *
+ * The full config is generated into a temporary file, compared section by section
+ * with the current config file, then either dropped when identical
+ * or atomically renamed over the current config file.
+ *
+ * @param pRad radio
+ * @return true when the config file is up to date, false on error
+ */
+bool whm_mxl_hapdConf_write(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, false, ME, "NULL");
+    ASSERT_NOT_NULL(pRad->hostapd, false, ME, "%s: no hostapd", pRad->Name);
+    whm_mxl_hapdConf_t* pConf = s_getHapdConf(pRad);
+    ASSERT_NOT_NULL(pConf, false, ME, "NULL");
+    const char* path = pRad->hostapd->cfgFile;
+    ASSERT_FALSE(swl_str_isEmpty(path), false, ME, "%s: no hostapd config file", pRad->Name);
+
+    char tmpPath[256] = {0};
+    swl_str_catFormat(tmpPath, sizeof(tmpPath), "%s%s", path, MXL_HAPD_CONF_TMP_SUFFIX);
+    /* the generated config ends up in the config file, unless replaced by the fallback write */
+    whm_mxl_cfgShadow_setRecording(true);
+    wld_hostapd_cfgFile_create(pRad, tmpPath);
+    whm_mxl_cfgShadow_setRecording(false);
+
+    struct stat tmpSt;
+    char* buf = s_readFile(tmpPath, &tmpSt);
+    if (buf == NULL) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to generate config, write %s directly", pRad->Name, path);
+        unlink(tmpPath);
+        pConf->valid = false;
+        s_createExt(pRad);
+        return true;
+    }
+
+    whm_mxl_hapdConf_t newConf;
+    memset(&newConf, 0, sizeof(newConf));
+    bool parsed = s_parseSections(&newConf, buf, strlen(buf));
+    free(buf);
+
+    s_syncWithFile(pConf, path);
+    uint32_t nrChanged = (parsed && pConf->valid) ? s_countChangedSections(pConf, &newConf) : newConf.nrSections;
+    if (parsed && pConf->valid && (nrChanged == 0)) {
+        SAH_TRACEZ_INFO(ME, "%s: config unchanged, keep %s", pRad->Name, path);
+        unlink(tmpPath);
+        free(newConf.sections);
+        pConf->nrSkipped++;
+        return true;
+    }
+
+    if (rename(tmpPath, path) < 0) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to rename %s to %s (%s)", pRad->Name, tmpPath, path, strerror(errno));
+        unlink(tmpPath);
+        free(newConf.sections);
+        pConf->valid = false;
+        s_createExt(pRad);
+        return true;
+    }
+    SAH_TRACEZ_INFO(ME, "%s: replaced %s, %u/%u sections changed", pRad->Name, path, nrChanged, newConf.nrSections);
+
+    free(pConf->sections);
+    pConf->sections = newConf.sections;
+    pConf->nrSections = newConf.nrSections;
+    pConf->maxSections = newConf.maxSections;
+    pConf->valid = parsed;
+    if (parsed) {
+        /* after the rename, the config file is the temporary file we generated */
+        struct stat st;
+        if (stat(path, &st) == 0) {
+            s_saveFileId(pConf, &st);
+        } else {
+            pConf->valid = false;
+        }
+    }
+    pConf->nrWrites++;
+    pConf->lastNrChanged = nrChanged;
+    return true;
+}
+
+/**
+ * @brief Check that the hostapd config file is still the one we last wrote or checked
+ *
+ * @param pRad radio
+ * @return false when the config file was written by someone else, or when our last write failed
+ */
+bool whm_mxl_hapdConf_isCurrent(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, false, ME, "NULL");
+    ASSERTS_NOT_NULL(pRad->hostapd, false, ME, "%s: no hostapd", pRad->Name);
+    whm_mxl_hapdConf_t* pConf = s_getHapdConf(pRad);
+    ASSERTS_NOT_NULL(pConf, false, ME, "NULL");
+    struct stat st;
+    ASSERTS_EQUALS(stat(pRad->hostapd->cfgFile, &st), 0, false, ME, "%s: no config file", pRad->Name);
+    return s_fileMatches(pConf, &st);
+}
+
+/**
+ * @brief Refresh the saved layout and identity of the hostapd config file from the file itself
+ *
+ * @param pRad radio
+ * @return true when the config file could be read
+ */
+bool whm_mxl_hapdConf_sync(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, false, ME, "NULL");
+    ASSERTS_NOT_NULL(pRad->hostapd, false, ME, "%s: no hostapd", pRad->Name);
+    whm_mxl_hapdConf_t* pConf = s_getHapdConf(pRad);
+    ASSERTS_NOT_NULL(pConf, false, ME, "NULL");
+    s_syncWithFile(pConf, pRad->hostapd->cfgFile);
+    return pConf->valid;
+}
+
+void whm_mxl_hapdConf_cleanup(T_Radio* pRad) {
+    whm_mxl_hapdConf_t* pConf = s_getHapdConf(pRad);
+    ASSERTS_NOT_NULL(pConf, , ME, "NULL");
+    free(pConf->sections);
+    memset(pConf, 0, sizeof(*pConf));
+}
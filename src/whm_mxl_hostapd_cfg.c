@@ -39,33 +39,204 @@
 *                           Radio Related Configurations                       *
 *                                                                              *
 *  *****************************************************************************/
+
+static void s_loadStr(char** pDst, amxd_object_t* obj, const char* paramName) {
+    free(*pDst);
+    *pDst = amxd_object_get_value(cstring_t, obj, paramName, NULL);
+}
+
+static void s_loadMainCfg(whm_mxl_radVendorCfg_t* pCfg, amxd_object_t* pVendorObj) {
+    whm_mxl_radMainCfg_t* pMain = &pCfg->main;
+    pMain->bfMode = amxd_object_get_value(int32_t, pVendorObj, "SetBfMode", NULL);
+    pMain->heDebugMode = amxd_object_get_value(bool, pVendorObj, "HeDebugMode", NULL);
+    pMain->heBeacon = amxd_object_get_value(bool, pVendorObj, "HeBeacon", NULL);
+    pMain->disableMbssid = amxd_object_get_value(bool, pVendorObj, "OverrideMBSSID", NULL);
+    pMain->duplicateBeacon = amxd_object_get_value(bool, pVendorObj, "DuplicateBeaconEnabled", NULL);
+    pMain->backgroundCac = amxd_object_get_value(bool, pVendorObj, "BackgroundCac", NULL);
+    pMain->ignore40MhzIntolerant = amxd_object_get_value(bool, pVendorObj, "Ignore40MhzIntolerant", NULL);
+    pMain->probeReqCltMode = amxd_object_get_value(bool, pVendorObj, "SetProbeReqCltMode", NULL);
+    pMain->dynamicEdca = amxd_object_get_value(bool, pVendorObj, "DynamicEdca", NULL);
+    pMain->qamPlus = amxd_object_get_value(bool, pVendorObj, "SetQAMplus", NULL);
+    pMain->duplicateBeaconBw = amxd_object_get_value(uint32_t, pVendorObj, "DuplicateBeaconBw", NULL);
+    pMain->twtResponderSupport = amxd_object_get_value(uint32_t, pVendorObj, "TwtResponderSupport", NULL);
+    pMain->heMacTwtResponderSupport = amxd_object_get_value(uint32_t, pVendorObj, "HeMacTwtResponderSupport", NULL);
+    pMain->probeReqListTimer = amxd_object_get_value(uint32_t, pVendorObj, "ProbeReqListTimer", NULL);
+    pMain->subBandDFS = amxd_object_get_value(uint32_t, pVendorObj, "SubBandDFS", NULL);
+    pMain->apMaxSta = amxd_object_get_value(uint16_t, pVendorObj, "ApMaxNumSta", NULL);
+    pMain->punctureBitMap = amxd_object_get_value(uint16_t, pVendorObj, "PunctureBitMap", NULL);
+    pMain->obssBeaconRssiThreshold = amxd_object_get_value(int32_t, pVendorObj, "ObssBeaconRssiThreshold", NULL);
+    pMain->powerSelection = amxd_object_get_value(int32_t, pVendorObj, "SetPowerSelection", NULL);
+    pMain->radarRssiTh = amxd_object_get_value(int8_t, pVendorObj, "SetRadarRssiTh", NULL);
+#ifdef CONFIG_VENDOR_MXL_PROPRIETARY
+    pMain->dfsDebugChan = amxd_object_get_value(int32_t, pVendorObj, "DfsDebugChan", NULL);
+    pMain->zwdfsDebugChan = amxd_object_get_value(int32_t, pVendorObj, "ZwdfsDebugChan", NULL);
+#endif /* CONFIG_VENDOR_MXL_PROPRIETARY */
+    s_loadStr(&pMain->dfsChStateFile, pVendorObj, "DfsChStateFile");
+    s_loadStr(&pMain->ccaTh, pVendorObj, "SetCcaTh");
+}
+
+static void s_loadAfcCfg(whm_mxl_radVendorCfg_t* pCfg, amxd_object_t* afcObj) {
+    whm_mxl_radAfcCfg_t* pAfc = &pCfg->afc;
+    s_loadStr(&pAfc->afcdSock, afcObj, "AfcdSock");
+    s_loadStr(&pAfc->opClass, afcObj, "AfcOpClass");
+    s_loadStr(&pAfc->frequencyRange, afcObj, "AfcFrequencyRange");
+    s_loadStr(&pAfc->certIds, afcObj, "AfcCertIds");
+    s_loadStr(&pAfc->serialNumber, afcObj, "AfcSerialNumber");
+    s_loadStr(&pAfc->linearPolygon, afcObj, "AfcLinearPolygon");
+    s_loadStr(&pAfc->requestId, afcObj, "AfcRequestId");
+    s_loadStr(&pAfc->requestVersion, afcObj, "AfcRequestVersion");
+    pAfc->locationType = amxd_object_get_value(int32_t, afcObj, "AfcLocationType", NULL);
+}
+
+static void s_loadBssColorCfg(whm_mxl_radVendorCfg_t* pCfg, amxd_object_t* bssColorObj) {
+    whm_mxl_radBssColorCfg_t* pBssColor = &pCfg->bssColor;
+    pBssColor->autonomousColorChange = amxd_object_get_value(bool, bssColorObj, "AutonomousColorChange", NULL);
+    pBssColor->changeTimeout = amxd_object_get_value(int32_t, bssColorObj, "ChangeTimeout", NULL);
+    pBssColor->numCollisionsThreshold = amxd_object_get_value(int32_t, bssColorObj, "NumCollisionsThreshold", NULL);
+    pBssColor->collAgeThresh = amxd_object_get_value(int32_t, bssColorObj, "CollAgeThresh", NULL);
+    pBssColor->usedColorTableAgeing = amxd_object_get_value(int32_t, bssColorObj, "UsedColorTableAgeing", NULL);
+    pBssColor->heBssColor = amxd_object_get_value(int32_t, bssColorObj, "HeBssColor", NULL);
+}
+
+static void s_loadDelayedStartCfg(whm_mxl_radVendorCfg_t* pCfg, amxd_object_t* delayedStartObj) {
+    whm_mxl_radDelayedStartCfg_t* pDelayedStart = &pCfg->delayedStart;
+    s_loadStr(&pDelayedStart->startAfter, delayedStartObj, "StartAfter");
+    pDelayedStart->startAfterDelay = amxd_object_get_value(uint32_t, delayedStartObj, "StartAfterDelay", NULL);
+    pDelayedStart->startAfterWatchdogTime = amxd_object_get_value(uint32_t, delayedStartObj, "StartAfterWatchdogTime", NULL);
+}
+
+static void s_loadObssCfg(whm_mxl_radVendorCfg_t* pCfg, amxd_object_t* obssObj) {
+    whm_mxl_radObssCfg_t* pObss = &pCfg->obss;
+    pObss->obssInterval = amxd_object_get_value(int32_t, obssObj, "ObssInterval", NULL);
+    pObss->scanPassiveDwell = amxd_object_get_value(uint32_t, obssObj, "ScanPassiveDwell", NULL);
+    pObss->scanActiveDwell = amxd_object_get_value(uint32_t, obssObj, "ScanActiveDwell", NULL);
+    pObss->scanPassiveTotalPerChannel = amxd_object_get_value(uint32_t, obssObj, "ScanPassiveTotalPerChannel", NULL);
+    pObss->scanActiveTotalPerChannel = amxd_object_get_value(uint32_t, obssObj, "ScanActiveTotalPerChannel", NULL);
+    pObss->channelTransitionDelayFactor = amxd_object_get_value(uint32_t, obssObj, "ChannelTransitionDelayFactor", NULL);
+    pObss->scanActivityThreshold = amxd_object_get_value(uint32_t, obssObj, "ScanActivityThreshold", NULL);
+}
+
+static void s_loadAcsCfg(whm_mxl_radVendorCfg_t* pCfg, amxd_object_t* acsObj) {
+    whm_mxl_radAcsCfg_t* pAcs = &pCfg->acs;
+    pAcs->scanMode = amxd_object_get_value(bool, acsObj, "AcsScanMode", NULL);
+    pAcs->updateDoSwitch = amxd_object_get_value(bool, acsObj, "AcsUpdateDoSwitch", NULL);
+    pAcs->fils = amxd_object_get_value(bool, acsObj, "AcsFils", NULL);
+    pAcs->punct6gMode = amxd_object_get_value(bool, acsObj, "Acs6gPunctMode", NULL);
+    s_loadStr(&pAcs->fallbackChan, acsObj, "AcsFallbackChan");
+    s_loadStr(&pAcs->optChList6g, acsObj, "Acs6gOptChList");
+}
+
+typedef void (* whm_mxl_radCfgLoader_f) (whm_mxl_radVendorCfg_t* pCfg, amxd_object_t* obj);
+
+SWL_TABLE(sRadCfgSections,
+          ARR(uint32_t section; char* objName; void* loader; ),
+          ARR(swl_type_uint32, swl_type_charPtr, swl_type_voidPtr, ),
+          ARR({MXL_RAD_CFG_SECTION_MAIN,          "",               s_loadMainCfg},
+              {MXL_RAD_CFG_SECTION_AFC,           "AFC",            s_loadAfcCfg},
+              {MXL_RAD_CFG_SECTION_BSS_COLOR,     "BssColor",       s_loadBssColorCfg},
+              {MXL_RAD_CFG_SECTION_DELAYED_START, "DelayedStart",   s_loadDelayedStartCfg},
+              {MXL_RAD_CFG_SECTION_OBSS,          "ObssScanParams", s_loadObssCfg},
+              {MXL_RAD_CFG_SECTION_ACS,           "ACS",            s_loadAcsCfg},
+              ));
+
+/*
+ * Reload the vendor config sections whose object changed since the last config map generation.
+ * Clean sections are serialized from the typed copy without any data model lookup.
+ */
+static void s_refreshVendorCfg(T_Radio* pRad, mxl_VendorData_t* pRadVendor) {
+    whm_mxl_radVendorCfg_t* pCfg = &pRadVendor->vendorCfg;
+    for(uint32_t section = 0; section < MXL_RAD_CFG_SECTION_MAX; section++) {
+        if(SWL_BIT_IS_SET(pCfg->validSections, section)) {
+            continue;
+        }
+        const char** pObjName = (const char**) swl_table_getMatchingValue(&sRadCfgSections, 1, 0, &section);
+        whm_mxl_radCfgLoader_f* pfLoader = (whm_mxl_radCfgLoader_f*) swl_table_getMatchingValue(&sRadCfgSections, 2, 0, &section);
+        if((pObjName == NULL) || (pfLoader == NULL)) {
+            continue;
+        }
+        amxd_object_t* obj = swl_str_isEmpty(*pObjName) ? pRadVendor->pBus : amxd_object_get(pRadVendor->pBus, *pObjName);
+        if(obj == NULL) {
+            SAH_TRACEZ_ERROR(ME, "%s: No %s vendor obj", pRad->Name, *pObjName);
+            continue;
+        }
+        (*pfLoader)(pCfg, obj);
+        W_SWL_BIT_SET(pCfg->validSections, section);
+        pCfg->nrReloads++;
+        SAH_TRACEZ_INFO(ME, "%s: reloaded vendor cfg section %u", pRad->Name, section);
+    }
+}
+
+/**
+ * @brief Mark a radio vendor config section as changed, to be reloaded on next config map generation
+ *
+ * @param pRad radio
+ * @param section vendor config section
+ * @return None
+ */
+void whm_mxl_rad_invalidateVendorCfg(T_Radio* pRad, whm_mxl_radCfgSection_e section) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    ASSERT_TRUE(section < MXL_RAD_CFG_SECTION_MAX, , ME, "invalid section %u", section);
+    W_SWL_BIT_CLEAR(pRadVendor->vendorCfg.validSections, section);
+}
+
+/**
+ * @brief Mark a radio vendor config section as changed from the data model event of its object
+ *
+ * @param data event data of WiFi.Radio.{}.Vendor. or one of its direct sub-objects
+ * @param section vendor config section of the object
+ * @return None
+ */
+void whm_mxl_rad_invalidateVendorCfgFromSignal(const amxc_var_t* const data, whm_mxl_radCfgSection_e section) {
+    amxd_object_t* object = amxd_dm_signal_get_object(get_wld_plugin_dm(), data);
+    ASSERTS_NOT_NULL(object, , ME, "No object");
+    amxd_object_t* vendorObj = (section == MXL_RAD_CFG_SECTION_MAIN) ? object : amxd_object_get_parent(object);
+    T_Radio* pRad = wld_rad_fromObj(amxd_object_get_parent(vendorObj));
+    ASSERTS_NOT_NULL(pRad, , ME, "No radio mapped");
+    whm_mxl_rad_invalidateVendorCfg(pRad, section);
+}
+
+/**
+ * @brief Free the typed copy of radio vendor objects
+ *
+ * @param pRad radio
+ * @return None
+ */
+void whm_mxl_rad_cleanupVendorCfg(T_Radio* pRad) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    whm_mxl_radVendorCfg_t* pCfg = &pRadVendor->vendorCfg;
+    char** strings[] = {
+        &pCfg->main.dfsChStateFile, &pCfg->main.ccaTh,
+        &pCfg->afc.afcdSock, &pCfg->afc.opClass, &pCfg->afc.frequencyRange, &pCfg->afc.certIds,
+        &pCfg->afc.serialNumber, &pCfg->afc.linearPolygon, &pCfg->afc.requestId, &pCfg->afc.requestVersion,
+        &pCfg->delayedStart.startAfter, &pCfg->acs.fallbackChan, &pCfg->acs.optChList6g,
+    };
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(strings); i++) {
+        free(*strings[i]);
+        *strings[i] = NULL;
+    }
+    pCfg->validSections = 0;
+}
+
 #ifdef CONFIG_VENDOR_MXL_PROPRIETARY
 static swl_rc_ne whm_mxl_rad_acsUpdateConfigMap(T_Radio* pRad, mxl_VendorData_t* pRadVendor, swl_mapChar_t* configMap) {
-    amxd_object_t* acsObj = amxd_object_get(pRadVendor->pBus, "ACS");
-    ASSERT_NOT_NULL(acsObj, SWL_RC_ERROR, ME, "No ACS vendor obj");
-    char *acsFallbackChan = amxd_object_get_value(cstring_t, acsObj, "AcsFallbackChan", NULL);
-    char *acs6gOptChList = amxd_object_get_value(cstring_t, acsObj, "Acs6gOptChList", NULL);
+    whm_mxl_radAcsCfg_t* pAcs = &pRadVendor->vendorCfg.acs;
 
     swl_mapCharFmt_addValStr(configMap, "acs_smart_info_file", "%s%s%s", "/tmp/acs_smart_info_", pRad->Name, ".txt");
     swl_mapCharFmt_addValStr(configMap, "acs_history_file", "%s%s%s", "/tmp/acs_history_", pRad->Name, ".txt");
     swl_mapCharFmt_addValInt32(configMap, "acs_num_scans", 1);
-    swl_mapCharFmt_addValInt32(configMap, "acs_scan_mode", amxd_object_get_value(bool, acsObj, "AcsScanMode", NULL));
-    swl_mapCharFmt_addValInt32(configMap, "acs_update_do_switch", amxd_object_get_value(bool, acsObj, "AcsUpdateDoSwitch", NULL));
-    if (!swl_str_isEmpty(acsFallbackChan)) {
-        swl_mapCharFmt_addValStr(configMap, "acs_fallback_chan", "%s", acsFallbackChan);
-    }
-    free(acsFallbackChan);
-    if (!swl_str_isEmpty(acs6gOptChList)) {
-        swl_mapCharFmt_addValStr(configMap, "acs_6g_opt_ch_list", "%s", acs6gOptChList);
-    }
-    free(acs6gOptChList);
+    swl_mapCharFmt_addValInt32(configMap, "acs_scan_mode", pAcs->scanMode);
+    swl_mapCharFmt_addValInt32(configMap, "acs_update_do_switch", pAcs->updateDoSwitch);
+    WHM_MXL_SET_STRING_PARAM(pAcs->fallbackChan, configMap, "acs_fallback_chan");
+    WHM_MXL_SET_STRING_PARAM(pAcs->optChList6g, configMap, "acs_6g_opt_ch_list");
 
     if (wld_rad_checkEnabledRadStd(pRad, SWL_RADSTD_AX) && wld_rad_is_6ghz(pRad)) {
-        swl_mapCharFmt_addValInt32(configMap, "acs_fils", amxd_object_get_value(bool, acsObj, "AcsFils", NULL));
+        swl_mapCharFmt_addValInt32(configMap, "acs_fils", pAcs->fils);
     }
 
     if (wld_rad_is_6ghz(pRad)) {
-        swl_mapCharFmt_addValInt32(configMap, "acs_6g_punct_mode", amxd_object_get_value(bool, acsObj, "Acs6gPunctMode", NULL));
+        swl_mapCharFmt_addValInt32(configMap, "acs_6g_punct_mode", pAcs->punct6gMode);
     }
 
     if (!swl_str_isEmpty(pRadVendor->acs_exclusion_ch_list)) {
@@ -81,57 +252,45 @@ static swl_rc_ne whm_mxl_rad_acsUpdateConfigMap(T_Radio* pRad, mxl_VendorData_t*
 }
 #endif /* CONFIG_VENDOR_MXL_PROPRIETARY */
 
-static swl_rc_ne whm_mxl_rad_afcUpdateConfigMap(amxd_object_t* pVendorObj, swl_mapChar_t* configMap) {
-    ASSERT_NOT_NULL(pVendorObj, SWL_RC_ERROR, ME, "pVendorObj is NULL");
-    amxd_object_t* afcObj = amxd_object_get(pVendorObj, "AFC");
-    ASSERT_NOT_NULL(afcObj, SWL_RC_ERROR, ME, "afcObj is NULL");
-    char *tmpStr = NULL;
-
-    WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, afcObj, "AfcdSock", configMap, "afcd_sock");
-    WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, afcObj, "AfcOpClass", configMap, "afc_op_class");
-    WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, afcObj, "AfcFrequencyRange", configMap, "afc_freq_range");
-    WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, afcObj, "AfcCertIds", configMap, "afc_cert_ids");
-    WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, afcObj, "AfcSerialNumber", configMap, "afc_serial_number");
-    WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, afcObj, "AfcLinearPolygon", configMap, "afc_linear_polygon");
-    WHM_MXL_NE_SET_PARAM(amxd_object_get_value(int32_t, afcObj, "AfcLocationType", NULL), -1, configMap, "afc_location_type");
-    WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, afcObj, "AfcRequestId", configMap, "afc_request_id");
-    WHM_MXL_GET_AND_SET_STRING_PARAM(tmpStr, afcObj, "AfcRequestVersion", configMap, "afc_request_version");
+static swl_rc_ne whm_mxl_rad_afcUpdateConfigMap(mxl_VendorData_t* pRadVendor, swl_mapChar_t* configMap) {
+    whm_mxl_radAfcCfg_t* pAfc = &pRadVendor->vendorCfg.afc;
+
+    WHM_MXL_SET_STRING_PARAM(pAfc->afcdSock, configMap, "afcd_sock");
+    WHM_MXL_SET_STRING_PARAM(pAfc->opClass, configMap, "afc_op_class");
+    WHM_MXL_SET_STRING_PARAM(pAfc->frequencyRange, configMap, "afc_freq_range");
+    WHM_MXL_SET_STRING_PARAM(pAfc->certIds, configMap, "afc_cert_ids");
+    WHM_MXL_SET_STRING_PARAM(pAfc->serialNumber, configMap, "afc_serial_number");
+    WHM_MXL_SET_STRING_PARAM(pAfc->linearPolygon, configMap, "afc_linear_polygon");
+    WHM_MXL_NE_SET_PARAM(pAfc->locationType, -1, configMap, "afc_location_type");
+    WHM_MXL_SET_STRING_PARAM(pAfc->requestId, configMap, "afc_request_id");
+    WHM_MXL_SET_STRING_PARAM(pAfc->requestVersion, configMap, "afc_request_version");
 
     return SWL_RC_OK;
 }
 
 static swl_rc_ne whm_mxl_rad_bssColorUpdateConfigMap(mxl_VendorData_t* pRadVendor, swl_mapChar_t* configMap) {
-    amxd_object_t* BssColorObj = amxd_object_get(pRadVendor->pBus, "BssColor");
-    ASSERT_NOT_NULL(BssColorObj, SWL_RC_ERROR, ME, "No BssColor vendor obj");
-
-    WHM_MXL_NE_SET_PARAM(amxd_object_get_value(bool, BssColorObj, "AutonomousColorChange", NULL), 1, configMap, "autonomous_color_change");
-    WHM_MXL_NE_SET_PARAM(amxd_object_get_value(int32_t, BssColorObj, "ChangeTimeout", NULL), BSS_COLOR_CHANGE_TIMEOUT_DEFAULT, configMap, "bss_color_change_timeout");
-    WHM_MXL_NE_SET_PARAM(amxd_object_get_value(int32_t, BssColorObj, "NumCollisionsThreshold", NULL), NUM_BSS_COLOR_COLL_THRESH_DEFAULT, configMap, "num_bss_color_coll_thresh");
-    WHM_MXL_NE_SET_PARAM(amxd_object_get_value(int32_t, BssColorObj, "CollAgeThresh", NULL), BSS_COLOR_COLL_AGE_THRESH_DEFAULT, configMap, "bss_color_coll_age_thresh");
-    WHM_MXL_NE_SET_PARAM(amxd_object_get_value(int32_t, BssColorObj, "UsedColorTableAgeing", NULL), USED_COLOR_TABLE_AGEING_DEFAULT, configMap, "used_color_table_ageing");
+    whm_mxl_radBssColorCfg_t* pBssColor = &pRadVendor->vendorCfg.bssColor;
+
+    WHM_MXL_NE_SET_PARAM(pBssColor->autonomousColorChange, 1, configMap, "autonomous_color_change");
+    WHM_MXL_NE_SET_PARAM(pBssColor->changeTimeout, BSS_COLOR_CHANGE_TIMEOUT_DEFAULT, configMap, "bss_color_change_timeout");
+    WHM_MXL_NE_SET_PARAM(pBssColor->numCollisionsThreshold, NUM_BSS_COLOR_COLL_THRESH_DEFAULT, configMap, "num_bss_color_coll_thresh");
+    WHM_MXL_NE_SET_PARAM(pBssColor->collAgeThresh, BSS_COLOR_COLL_AGE_THRESH_DEFAULT, configMap, "bss_color_coll_age_thresh");
+    WHM_MXL_NE_SET_PARAM(pBssColor->usedColorTableAgeing, USED_COLOR_TABLE_AGEING_DEFAULT, configMap, "used_color_table_ageing");
     if(pRadVendor->randomColor) {
         WHM_MXL_NE_SET_PARAM(pRadVendor->randomColor, 0, configMap, "he_bss_color");
         pRadVendor->randomColor = 0;
     } else {
-        WHM_MXL_NE_SET_PARAM(amxd_object_get_value(int32_t, BssColorObj, "HeBssColor", NULL), 0, configMap, "he_bss_color");
+        WHM_MXL_NE_SET_PARAM(pBssColor->heBssColor, 0, configMap, "he_bss_color");
     }
     return SWL_RC_OK;
 }
 
 static swl_rc_ne whm_mxl_rad_delayedStartUpdateConfigMap(mxl_VendorData_t* pRadVendor, swl_mapChar_t* configMap) {
-    amxd_object_t* DelayedStartObj = amxd_object_get(pRadVendor->pBus, "DelayedStart");
-    ASSERT_NOT_NULL(DelayedStartObj, SWL_RC_ERROR, ME, "No DelayedStart vendor obj");
+    whm_mxl_radDelayedStartCfg_t* pDelayedStart = &pRadVendor->vendorCfg.delayedStart;
 
-    char *startAfter = amxd_object_get_value(cstring_t, DelayedStartObj, "StartAfter", NULL);
-    uint32_t startDelay = amxd_object_get_value(uint32_t, DelayedStartObj, "StartAfterDelay", NULL);
-    uint32_t startWdTime = amxd_object_get_value(uint32_t, DelayedStartObj, "StartAfterWatchdogTime", NULL);
-
-    if (!swl_str_isEmpty(startAfter)) {
-        swl_mapCharFmt_addValStr(configMap, "start_after", "%s",startAfter);
-    }
-    free(startAfter);
-    WHM_MXL_GT_SET_PARAM(startDelay, 0, configMap, "start_after_delay");
-    WHM_MXL_GT_SET_PARAM(startWdTime, 0, configMap, "start_after_watchdog_time");
+    WHM_MXL_SET_STRING_PARAM(pDelayedStart->startAfter, configMap, "start_after");
+    WHM_MXL_GT_SET_PARAM(pDelayedStart->startAfterDelay, 0, configMap, "start_after_delay");
+    WHM_MXL_GT_SET_PARAM(pDelayedStart->startAfterWatchdogTime, 0, configMap, "start_after_watchdog_time");
 
     return SWL_RC_OK;
 }
@@ -597,39 +756,29 @@ static void  whm_mxl_rad_configCertification(T_Radio* pRad, amxd_object_t* pVend
     }
 }
 
-static swl_rc_ne s_mxl_rad_configObssScanParams(amxd_object_t* pVendorObj, swl_mapChar_t* configMap, bool coexistanceEnabled)
+static swl_rc_ne s_mxl_rad_configObssScanParams(mxl_VendorData_t* pRadVendor, swl_mapChar_t* configMap, bool coexistanceEnabled)
 {
-    amxd_object_t* obssObj = amxd_object_get(pVendorObj, "ObssScanParams");
-    ASSERT_NOT_NULL(obssObj, SWL_RC_ERROR, ME, "No ObssScanParams vendor obj");
-
-    uint32_t scanPassiveDwell             = amxd_object_get_value(uint32_t, obssObj, "ScanPassiveDwell",             NULL);
-    uint32_t scanActiveDwell              = amxd_object_get_value(uint32_t, obssObj, "ScanActiveDwell",              NULL);
-    uint32_t scanPassiveTotalPerChannel   = amxd_object_get_value(uint32_t, obssObj, "ScanPassiveTotalPerChannel",   NULL);
-    uint32_t scanActiveTotalPerChannel    = amxd_object_get_value(uint32_t, obssObj, "ScanActiveTotalPerChannel",    NULL);
-    uint32_t channelTransitionDelayFactor = amxd_object_get_value(uint32_t, obssObj, "ChannelTransitionDelayFactor", NULL);
-    uint32_t scanActivityThreshold        = amxd_object_get_value(uint32_t, obssObj, "ScanActivityThreshold",        NULL);
+    whm_mxl_radObssCfg_t* pObss = &pRadVendor->vendorCfg.obss;
 
     /* Configure OBSS Interval
            If obss coexistance is enabled then obssInterval = value from DM
        otherwise value is set explicitly to 0
     */
-    int obssInterval = amxd_object_get_value(int32_t, obssObj, "ObssInterval", NULL);
-    swl_mapCharFmt_addValInt32(configMap, "obss_interval", (coexistanceEnabled ? obssInterval : 0));
+    swl_mapCharFmt_addValInt32(configMap, "obss_interval", (coexistanceEnabled ? pObss->obssInterval : 0));
 
     /* OBSS Scan Params */
-    WHM_MXL_NE_SET_PARAM(scanPassiveDwell,             DEF_SCAN_PASSIVE_DWELL,           configMap, "scan_passive_dwell");
-    WHM_MXL_NE_SET_PARAM(scanActiveDwell,              DEF_SCAN_ACTIVE_DWELL,            configMap, "scan_active_dwell");
-    WHM_MXL_NE_SET_PARAM(scanPassiveTotalPerChannel,   DEF_SCAN_PASSIVE_TOTAL_PER_CHAN,  configMap, "scan_passive_total_per_channel");
-    WHM_MXL_NE_SET_PARAM(scanActiveTotalPerChannel,    DEF_SCAN_ACTIVE_TOTAL_PER_CHAN,   configMap, "scan_active_total_per_channel");
-    WHM_MXL_NE_SET_PARAM(channelTransitionDelayFactor, DEF_CHAN_TRANSITION_DELAY_FACTOR, configMap, "channel_transition_delay_factor");
-    WHM_MXL_NE_SET_PARAM(scanActivityThreshold,        DEF_SCAN_ACTIVITY_THRESHOLD,      configMap, "scan_activity_threshold");
+    WHM_MXL_NE_SET_PARAM(pObss->scanPassiveDwell,             DEF_SCAN_PASSIVE_DWELL,           configMap, "scan_passive_dwell");
+    WHM_MXL_NE_SET_PARAM(pObss->scanActiveDwell,              DEF_SCAN_ACTIVE_DWELL,            configMap, "scan_active_dwell");
+    WHM_MXL_NE_SET_PARAM(pObss->scanPassiveTotalPerChannel,   DEF_SCAN_PASSIVE_TOTAL_PER_CHAN,  configMap, "scan_passive_total_per_channel");
+    WHM_MXL_NE_SET_PARAM(pObss->scanActiveTotalPerChannel,    DEF_SCAN_ACTIVE_TOTAL_PER_CHAN,   configMap, "scan_active_total_per_channel");
+    WHM_MXL_NE_SET_PARAM(pObss->channelTransitionDelayFactor, DEF_CHAN_TRANSITION_DELAY_FACTOR, configMap, "channel_transition_delay_factor");
+    WHM_MXL_NE_SET_PARAM(pObss->scanActivityThreshold,        DEF_SCAN_ACTIVITY_THRESHOLD,      configMap, "scan_activity_threshold");
 
     return SWL_RC_OK;
 }
 
-static void s_mxl_rad_setPowerSelectionParam(amxd_object_t* pVendorObj, swl_mapChar_t* configMap) {
-    ASSERT_NOT_NULL(pVendorObj, , ME, "pVendorObj is NULL");
-    int8_t *txPowVal = whm_mxl_rad_txPercentToPower(amxd_object_get_value(int32_t, pVendorObj, "SetPowerSelection", NULL));
+static void s_mxl_rad_setPowerSelectionParam(whm_mxl_radMainCfg_t* pMain, swl_mapChar_t* configMap) {
+    int8_t *txPowVal = whm_mxl_rad_txPercentToPower(pMain->powerSelection);
     ASSERT_NOT_NULL(txPowVal, , ME, "txPowVal is NULL");
     swl_mapCharFmt_addValInt32(configMap, "sPowerSelection", *txPowVal);
 }
@@ -641,22 +790,9 @@ static swl_rc_ne s_mxl_rad_updateConfig(T_Radio* pRad, mxl_VendorData_t* pRadVen
     /*Take pointer to the Vendor Object*/
     amxd_object_t* pVendorObj = pRadVendor->pBus;
     ASSERT_NOT_NULL(pVendorObj, SWL_RC_INVALID_PARAM, ME, "NULL");
-    int bfMode = amxd_object_get_value(int32_t, pVendorObj, "SetBfMode", NULL);
-    bool heDebugMode = amxd_object_get_value(bool, pVendorObj, "HeDebugMode", NULL);
-    bool heBeacon = amxd_object_get_value(bool, pVendorObj, "HeBeacon", NULL);
-    bool disableMbssid = amxd_object_get_value(bool, pVendorObj, "OverrideMBSSID", NULL);
-    bool duplicateBeacon = amxd_object_get_value(bool, pVendorObj, "DuplicateBeaconEnabled", NULL);
-    bool backgroundCac = amxd_object_get_value(bool, pVendorObj, "BackgroundCac", NULL);
-    uint32_t duplicateBeaconBw = amxd_object_get_value(uint32_t, pVendorObj, "DuplicateBeaconBw", NULL);
-    uint32_t twtResponderSupport = amxd_object_get_value(uint32_t, pVendorObj, "TwtResponderSupport", NULL);
-    uint32_t heMacTwtResponderSupport = amxd_object_get_value(uint32_t, pVendorObj, "HeMacTwtResponderSupport", NULL);
-    uint32_t probeReqListTimer = amxd_object_get_value(uint32_t, pVendorObj, "ProbeReqListTimer", NULL);
-    uint32_t subBandDFS = amxd_object_get_value(uint32_t, pVendorObj, "SubBandDFS", NULL);
-    uint16_t apMaxSta = amxd_object_get_value(uint16_t, pVendorObj, "ApMaxNumSta", NULL);
-    uint16_t punctureBitMap = amxd_object_get_value(uint16_t, pVendorObj, "PunctureBitMap", NULL);
+    s_refreshVendorCfg(pRad, pRadVendor);
+    whm_mxl_radMainCfg_t* pMain = &pRadVendor->vendorCfg.main;
     uint32_t max_bss = wld_rad_countMappedAPs(pRad);
-    char *dfsChStateFile = amxd_object_get_value(cstring_t, pVendorObj, "DfsChStateFile", NULL);
-    char *setCcaTh = amxd_object_get_value(cstring_t, pVendorObj, "SetCcaTh", NULL);
 #ifdef CONFIG_VENDOR_MXL_PROPRIETARY
     swl_radBw_e curBandwidth = pRad->operatingChannelBandwidth;
     swl_chanspec_t tgtChspec = wld_chanmgt_getTgtChspec(pRad);
@@ -670,7 +806,7 @@ static swl_rc_ne s_mxl_rad_updateConfig(T_Radio* pRad, mxl_VendorData_t* pRadVen
     /* 6G Band Only Parameters */
     if(wld_rad_is_6ghz(pRad)) {
         /* Prepare hostapd_conf AFC parameters */
-        whm_mxl_rad_afcUpdateConfigMap(pVendorObj, configMap);
+        whm_mxl_rad_afcUpdateConfigMap(pRadVendor, configMap);
         /*
         Currently, PWHM is setting 6G HE Capabilities to a minimun, waiting for proper 6ghz caps parsing to improve configuration
         We will set it back to the default values as per hostapd-ng. 
@@ -678,11 +814,11 @@ static swl_rc_ne s_mxl_rad_updateConfig(T_Radio* pRad, mxl_VendorData_t* pRadVen
         */
         whm_mxl_rad_configHe6gCapabs(pVendorObj, configMap);
 
-        WHM_MXL_NE_SET_PARAM(disableMbssid, 0, configMap, "override_6g_mbssid_default_mode");
-        WHM_MXL_NE_SET_PARAM(heBeacon, 0, configMap, "he_beacon");
-        WHM_MXL_NE_SET_PARAM(duplicateBeacon, 0, configMap, "duplicate_beacon_enabled");
-        if(duplicateBeacon) {
-            swl_mapCharFmt_addValInt32(configMap, "duplicate_beacon_bw", duplicateBeaconBw);
+        WHM_MXL_NE_SET_PARAM(pMain->disableMbssid, 0, configMap, "override_6g_mbssid_default_mode");
+        WHM_MXL_NE_SET_PARAM(pMain->heBeacon, 0, configMap, "he_beacon");
+        WHM_MXL_NE_SET_PARAM(pMain->duplicateBeacon, 0, configMap, "duplicate_beacon_enabled");
+        if(pMain->duplicateBeacon) {
+            swl_mapCharFmt_addValInt32(configMap, "duplicate_beacon_bw", pMain->duplicateBeaconBw);
         }
         /* mod-whm should supply the max_bss count to the hostapd for the MBSSID feature */
         swl_mapCharFmt_addValInt32(configMap, "max_bss", max_bss);
@@ -701,7 +837,7 @@ static swl_rc_ne s_mxl_rad_updateConfig(T_Radio* pRad, mxl_VendorData_t* pRadVen
         }
 #endif /* CONFIG_VENDOR_MXL_PROPRIETARY */
         if(wld_rad_checkEnabledRadStd(pRad, SWL_RADSTD_BE)) {
-            WHM_MXL_NE_SET_PARAM(punctureBitMap, 0, configMap, "punct_bitmap");
+            WHM_MXL_NE_SET_PARAM(pMain->punctureBitMap, 0, configMap, "punct_bitmap");
         }
         if (whm_mxl_isTgtChannelWidthEqual(pRad, SWL_BW_20MHZ)) {
             if ((pRad->autoChannelEnable) || (pRadVendor->firstNonDfs)) {
@@ -710,63 +846,52 @@ static swl_rc_ne s_mxl_rad_updateConfig(T_Radio* pRad, mxl_VendorData_t* pRadVen
         }
     }
     else { /* non 6G Band Parameters */
-        bool ignore40MhzIntolerant = amxd_object_get_value(bool, pVendorObj, "Ignore40MhzIntolerant", NULL);
-        int32_t obssBeaconRssiThreshold = amxd_object_get_value(int32_t, pVendorObj, "ObssBeaconRssiThreshold", NULL);
-
         /* ignore_40_mhz_intolerant:
          * 2.4 and 5 GHz: If set do not perform HT scan and no overlap rules check;
          * 2.4 GHz additional: Ignore 40 MHz intolerant STAs */
-        WHM_MXL_GT_SET_PARAM(ignore40MhzIntolerant, 0, configMap, "ignore_40_mhz_intolerant");
+        WHM_MXL_GT_SET_PARAM(pMain->ignore40MhzIntolerant, 0, configMap, "ignore_40_mhz_intolerant");
         /* obss_beacon_rssi_threshold: Ignore overlapping BSSes whose RSSI is below this threshold */
-        WHM_MXL_NE_SET_PARAM(obssBeaconRssiThreshold, DEF_OBSS_RSSI_THRESHOLD, configMap, "obss_beacon_rssi_threshold");
+        WHM_MXL_NE_SET_PARAM(pMain->obssBeaconRssiThreshold, DEF_OBSS_RSSI_THRESHOLD, configMap, "obss_beacon_rssi_threshold");
     }
 
-    WHM_MXL_NE_SET_PARAM(apMaxSta, DEFAULT_AP_MAX_STA, configMap, "ap_max_num_sta");
-    swl_mapCharFmt_addValInt32(configMap, "sProbeReqCltMode", amxd_object_get_value(bool, pVendorObj, "SetProbeReqCltMode", NULL));
-    swl_mapCharFmt_addValInt32(configMap, "dynamic_edca", amxd_object_get_value(bool, pVendorObj, "DynamicEdca", NULL));
-    WHM_MXL_GT_SET_PARAM(bfMode, -1, configMap, "sBfMode");
-    WHM_MXL_NE_SET_PARAM(twtResponderSupport, 1, configMap, "twt_responder_support");
-    WHM_MXL_GT_SET_PARAM(heMacTwtResponderSupport, 0, configMap, "he_mac_twt_responder_support");
-    WHM_MXL_GT_SET_PARAM(probeReqListTimer, 0, configMap, "ProbeReqListTimer");
+    WHM_MXL_NE_SET_PARAM(pMain->apMaxSta, DEFAULT_AP_MAX_STA, configMap, "ap_max_num_sta");
+    swl_mapCharFmt_addValInt32(configMap, "sProbeReqCltMode", pMain->probeReqCltMode);
+    swl_mapCharFmt_addValInt32(configMap, "dynamic_edca", pMain->dynamicEdca);
+    WHM_MXL_GT_SET_PARAM(pMain->bfMode, -1, configMap, "sBfMode");
+    WHM_MXL_NE_SET_PARAM(pMain->twtResponderSupport, 1, configMap, "twt_responder_support");
+    WHM_MXL_GT_SET_PARAM(pMain->heMacTwtResponderSupport, 0, configMap, "he_mac_twt_responder_support");
+    WHM_MXL_GT_SET_PARAM(pMain->probeReqListTimer, 0, configMap, "ProbeReqListTimer");
 
-    s_mxl_rad_setPowerSelectionParam(pVendorObj, configMap);
+    s_mxl_rad_setPowerSelectionParam(pMain, configMap);
 
     /* 2.4G Band Only Parameters */
     if (wld_rad_is_24ghz(pRad)) {
-        s_mxl_rad_configObssScanParams(pVendorObj, configMap, pRad->obssCoexistenceEnabled);
+        s_mxl_rad_configObssScanParams(pRadVendor, configMap, pRad->obssCoexistenceEnabled);
         if (wld_rad_checkEnabledRadStd(pRad, SWL_RADSTD_N)) {
-            swl_mapCharFmt_addValInt32(configMap, "sQAMplus", amxd_object_get_value(bool, pVendorObj, "SetQAMplus", NULL));
+            swl_mapCharFmt_addValInt32(configMap, "sQAMplus", pMain->qamPlus);
         }
     }
 
     /* 5G Band Only Parameters */
     if (wld_rad_is_5ghz(pRad)) {
-        swl_mapCharFmt_addValInt32(configMap, "sRadarRssiTh", amxd_object_get_value(int8_t, pVendorObj, "SetRadarRssiTh", NULL));
-        WHM_MXL_GT_SET_PARAM(subBandDFS, 0, configMap, "sub_band_dfs");
-        WHM_MXL_GT_SET_PARAM(backgroundCac, 0, configMap, "background_cac");
+        swl_mapCharFmt_addValInt32(configMap, "sRadarRssiTh", pMain->radarRssiTh);
+        WHM_MXL_GT_SET_PARAM(pMain->subBandDFS, 0, configMap, "sub_band_dfs");
+        WHM_MXL_GT_SET_PARAM(pMain->backgroundCac, 0, configMap, "background_cac");
     }
 
-    if(!swl_str_isEmpty(dfsChStateFile)) {
-        swl_mapCharFmt_addValStr(configMap, "dfs_channels_state_file_location", "%s", dfsChStateFile);
-    }
-    free(dfsChStateFile);
-    if(!swl_str_matches(setCcaTh, "-62 -62 -72 -72 -69")) {
-        swl_mapCharFmt_addValStr(configMap, "sCcaTh", "%s", setCcaTh);
+    WHM_MXL_SET_STRING_PARAM(pMain->dfsChStateFile, configMap, "dfs_channels_state_file_location");
+    if(!swl_str_matches(pMain->ccaTh, "-62 -62 -72 -72 -69")) {
+        swl_mapCharFmt_addValStr(configMap, "sCcaTh", "%s", pMain->ccaTh);
     }
-    free(setCcaTh);
 #ifdef CONFIG_VENDOR_MXL_PROPRIETARY
-    if(amxd_object_get_value(int32_t, pVendorObj, "DfsDebugChan", NULL) != -1) {
-        swl_mapCharFmt_addValInt32(configMap, "dfs_debug_chan", amxd_object_get_value(int32_t, pVendorObj, "DfsDebugChan", NULL));
-    }
-    if(amxd_object_get_value(int32_t, pVendorObj, "ZwdfsDebugChan", NULL) != -1) {
-        swl_mapCharFmt_addValInt32(configMap, "zwdfs_debug_chan", amxd_object_get_value(int32_t, pVendorObj, "ZwdfsDebugChan", NULL));
-    }
+    WHM_MXL_NE_SET_PARAM(pMain->dfsDebugChan, -1, configMap, "dfs_debug_chan");
+    WHM_MXL_NE_SET_PARAM(pMain->zwdfsDebugChan, -1, configMap, "zwdfs_debug_chan");
 #endif /* CONFIG_VENDOR_MXL_PROPRIETARY */
     /* Configure 80211AX Only Params */
     if(wld_rad_checkEnabledRadStd(pRad, SWL_RADSTD_AX)) {
         /* Configure AX MxL Params */
         whm_mxl_rad_configAxMxlParams(pRad, configMap);
-        WHM_MXL_GT_SET_PARAM(heDebugMode, 0, configMap, "enable_he_debug_mode");
+        WHM_MXL_GT_SET_PARAM(pMain->heDebugMode, 0, configMap, "enable_he_debug_mode");
     }
     /* Configure 80211N Only Params */
     if(wld_rad_checkEnabledRadStd(pRad, SWL_RADSTD_N)) {
@@ -1266,6 +1391,7 @@ swl_rc_ne whm_mxl_vap_updateConfigMap(T_AccessPoint* pAP, swl_mapChar_t* configM
         /* Configure hostapd conf for operational VAP */
         SAH_TRACEZ_INFO(ME, "%s: Writing mxl config for operational VAP", pAP->alias);
         rc = s_mxl_vap_updateConfig(pAP, configMap);
+        whm_mxl_cfgShadow_update(pAP, configMap);
     }
 
     return rc;
@@ -13,6 +13,9 @@
 *                                                                              *
 *  *****************************************************************************/
 
+#include <net/if.h>
+#include <netlink/genl/genl.h>
+#include <netlink/genl/ctrl.h>
 #include <debug/sahtrace.h>
 
 #include "wld/wld.h"
@@ -23,6 +26,8 @@
 
 #include "swla/swla_exec.h"
 
+#include <nl80211_copy.h>
+
 #include "whm_mxl_utils.h"
 
 #include "whm_mxl_module.h"
@@ -49,6 +54,79 @@ static whm_mxl_module_mode_t mxlModule = {.mode = WHM_MXL_MOD_NORMAL, .wpa3CertM
 static const char* s_defaultIfNames[SWL_FREQ_BAND_MAX] = {"wlan0", "wlan2", "wlan4"};
 static const char* s_defaultZwDfsIfName = "wlan6";
 
+static const char* s_bootPhaseNames[MXL_BOOT_PHASE_MAX] = {
+    "ModuleInit", "VendorRegistered", "WiphysProbed", "IfacesCreated", "RadiosAdded", "FirstVapUp", "AllRadiosUp"
+};
+
+/* Boot timestamps, to measure the time from module init to the first beaconing BSS of each radio */
+typedef struct {
+    swl_timeSpecMono_t phaseTs[MXL_BOOT_PHASE_MAX];
+    bool phaseDone[MXL_BOOT_PHASE_MAX];
+    struct {
+        char name[IFNAMSIZ];
+        swl_timeSpecMono_t upTs;
+        bool up;
+    } radios[MXL_MAXNROF_RADIO];
+    uint32_t nrRadios;
+} whm_mxl_bootTimes_t;
+
+static whm_mxl_bootTimes_t s_bootTimes;
+
+/* Main interface to create on a wiphy */
+typedef struct {
+    uint32_t wiphy;
+    const char* phyName;
+    const char* alias;
+    bool created;
+} whm_mxl_mainIface_t;
+
+/**
+ * @brief Record the first occurrence of a boot phase
+ */
+void whm_mxl_module_markBootPhase(whm_mxl_bootPhase_e phase) {
+    ASSERTS_TRUE(phase < MXL_BOOT_PHASE_MAX, , ME, "invalid boot phase %d", phase);
+    ASSERTS_FALSE(s_bootTimes.phaseDone[phase], , ME, "boot phase %s already done", s_bootPhaseNames[phase]);
+    swl_timespec_getMono(&s_bootTimes.phaseTs[phase]);
+    s_bootTimes.phaseDone[phase] = true;
+    SAH_TRACEZ_WARNING(ME, "boot phase %s at %"PRId64" ms", s_bootPhaseNames[phase],
+                       swl_timespec_diffToMillisec(&s_bootTimes.phaseTs[MXL_BOOT_MODULE_INIT], &s_bootTimes.phaseTs[phase]));
+}
+
+static void s_addBootRadio(const char* name) {
+    for(uint32_t i = 0; i < s_bootTimes.nrRadios; i++) {
+        if(swl_str_matches(s_bootTimes.radios[i].name, name)) {
+            return;
+        }
+    }
+    ASSERTS_TRUE(s_bootTimes.nrRadios < MXL_MAXNROF_RADIO, , ME, "too many radios");
+    swl_str_copy(s_bootTimes.radios[s_bootTimes.nrRadios].name, sizeof(s_bootTimes.radios[0].name), name);
+    s_bootTimes.nrRadios++;
+}
+
+/**
+ * @brief Record the first VAP up of a radio, i.e. its first beacon after boot
+ */
+void whm_mxl_module_markRadioUp(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, , ME, "NULL");
+    ASSERTS_FALSE(s_bootTimes.phaseDone[MXL_BOOT_ALL_RADIOS_UP], , ME, "boot done");
+    bool allUp = true;
+    for(uint32_t i = 0; i < s_bootTimes.nrRadios; i++) {
+        if(!s_bootTimes.radios[i].up && swl_str_matches(s_bootTimes.radios[i].name, pRad->Name)) {
+            swl_timespec_getMono(&s_bootTimes.radios[i].upTs);
+            s_bootTimes.radios[i].up = true;
+            SAH_TRACEZ_WARNING(ME, "%s: first VAP up at %"PRId64" ms", pRad->Name,
+                               swl_timespec_diffToMillisec(&s_bootTimes.phaseTs[MXL_BOOT_MODULE_INIT], &s_bootTimes.radios[i].upTs));
+            if(!s_bootTimes.phaseDone[MXL_BOOT_FIRST_VAP_UP]) {
+                whm_mxl_module_markBootPhase(MXL_BOOT_FIRST_VAP_UP);
+            }
+        }
+        allUp &= s_bootTimes.radios[i].up;
+    }
+    if(allUp && (s_bootTimes.nrRadios > 0)) {
+        whm_mxl_module_markBootPhase(MXL_BOOT_ALL_RADIOS_UP);
+    }
+}
+
 static void s_mxl_addRadio(const char* name, int index) {
     if(swl_str_matches(name, s_defaultZwDfsIfName)) {
         // keep it in vendor module, do not add it to global radio list visible to pwhm
@@ -57,6 +135,7 @@ static void s_mxl_addRadio(const char* name, int index) {
     } else {
         SAH_TRACEZ_WARNING(ME, "Attach interface %s with index %d to vendor %s", name, index, s_vendor->name);
         wld_addRadio(name, s_vendor, index);
+        s_addBootRadio(name);
     }
     // Add background radar capability for 5GHz main radio
     T_Radio* pRadZwDfs = mxl_rad_getZwDfsRadio();
@@ -90,6 +169,72 @@ static int s_checkAndAddRadios() {
     return index;
 }
 
+static swl_rc_ne s_createMainIfaceWithIw(whm_mxl_mainIface_t* pIface) {
+    swl_exec_result_t result;
+    memset(&result, 0, sizeof(swl_exec_result_t));
+    swl_rc_ne rc = SWL_EXEC_BUF_EXT(&result, "iw", "phy %s interface add %s type __ap", pIface->phyName, pIface->alias);
+    if((result.exitInfo.isSignaled) || (result.exitInfo.exitStatus != 0)) {
+        rc = SWL_RC_ERROR;
+    }
+    ASSERT_EQUALS(rc, SWL_RC_OK, rc, ME, "Fail to create main interface %s(%d)", pIface->alias, pIface->wiphy);
+    pIface->created = true;
+    return rc;
+}
+
+/*
+ * Create the main interfaces with nl80211 NEW_INTERFACE requests, all sent on one
+ * netlink socket before collecting the acks, so that creating N interfaces costs
+ * a single kernel round trip batch instead of N forked iw processes.
+ */
+static void s_createMainIfacesWithNl80211(whm_mxl_mainIface_t* ifaces, uint32_t nrIfaces) {
+    struct nl_sock* sock = nl_socket_alloc();
+    ASSERT_NOT_NULL(sock, , ME, "fail to allocate netlink socket");
+    if(genl_connect(sock) < 0) {
+        SAH_TRACEZ_ERROR(ME, "fail to connect netlink socket");
+        nl_socket_free(sock);
+        return;
+    }
+    int familyId = genl_ctrl_resolve(sock, "nl80211");
+    if(familyId < 0) {
+        SAH_TRACEZ_ERROR(ME, "fail to resolve nl80211 family");
+        nl_socket_free(sock);
+        return;
+    }
+    /* acks are matched in sending order */
+    nl_socket_disable_seq_check(sock);
+
+    bool sent[MXL_MAXNROF_RADIO] = {false};
+    for(uint32_t i = 0; i < nrIfaces; i++) {
+        struct nl_msg* msg = nlmsg_alloc();
+        if(msg == NULL) {
+            continue;
+        }
+        if((genlmsg_put(msg, NL_AUTO_PORT, NL_AUTO_SEQ, familyId, 0, NLM_F_ACK, NL80211_CMD_NEW_INTERFACE, 0) != NULL) &&
+           (nla_put_u32(msg, NL80211_ATTR_WIPHY, ifaces[i].wiphy) == 0) &&
+           (nla_put_string(msg, NL80211_ATTR_IFNAME, ifaces[i].alias) == 0) &&
+           (nla_put_u32(msg, NL80211_ATTR_IFTYPE, NL80211_IFTYPE_AP) == 0)) {
+            sent[i] = (nl_send_auto(sock, msg) >= 0);
+        }
+        nlmsg_free(msg);
+        if(!sent[i]) {
+            SAH_TRACEZ_ERROR(ME, "fail to send NEW_INTERFACE for %s(%d)", ifaces[i].alias, ifaces[i].wiphy);
+        }
+    }
+    for(uint32_t i = 0; i < nrIfaces; i++) {
+        if(!sent[i]) {
+            continue;
+        }
+        int err = nl_wait_for_ack(sock);
+        if(err < 0) {
+            SAH_TRACEZ_ERROR(ME, "fail to create main interface %s(%d): %s", ifaces[i].alias, ifaces[i].wiphy, nl_geterror(err));
+            continue;
+        }
+        ifaces[i].created = true;
+        SAH_TRACEZ_WARNING(ME, "Main interface %s added for phy %s(%d)", ifaces[i].alias, ifaces[i].phyName, ifaces[i].wiphy);
+    }
+    nl_socket_free(sock);
+}
+
 swl_rc_ne whm_mxl_module_addRadios(void) {
     swl_rc_ne rc = SWL_RC_INVALID_PARAM;
     ASSERT_NOT_NULL(s_vendor, SWL_RC_INVALID_PARAM, ME, "NULL");
@@ -104,10 +249,12 @@ swl_rc_ne whm_mxl_module_addRadios(void) {
         rc = wld_nl80211_getAllWiphyInfo(wld_nl80211_getSharedState(), MXL_MAXNROF_RADIO, aWiphyIfs, &nrWiphy);
         ASSERT_EQUALS(rc, SWL_RC_OK, rc, ME, "Fail to get all wiphy");
 
-        // create the main interfaces on top of each detected wiphy
-        for(uint32_t i = 0; i < nrWiphy; i++) {
+        // first pass: select the main interface of each detected wiphy
+        whm_mxl_mainIface_t ifaces[MXL_MAXNROF_RADIO];
+        uint32_t nrIfaces = 0;
+        memset(ifaces, 0, sizeof(ifaces));
+        for(uint32_t i = 0; (i < nrWiphy) && (i < MXL_MAXNROF_RADIO); i++) {
             wld_nl80211_wiphyInfo_t* pWiphy = &aWiphyIfs[i];
-            SAH_TRACEZ_WARNING(ME, "Add main interface for phy %s(%d)", pWiphy->name, pWiphy->wiphy);
 
             // retrieve and check the freq band
             swl_freqBand_e freqBand = SWL_FREQ_BAND_MAX;
@@ -123,31 +270,29 @@ swl_rc_ne whm_mxl_module_addRadios(void) {
             }
             SAH_TRACEZ_NOTICE(ME, "%s is %s", pWiphy->name, swl_freqBand_str[freqBand]);
 
-            // initialize vendor nl80211 wiphy info
+            // retrieve vendor wiphy info
             mxl_VendorWiphyInfo_t vendorInfo = {};
             vendorInfo.wiphyId = pWiphy->wiphy;
-
-            // retrieve vendor wiphy info
             wld_nl80211_getVendorWiphyInfo(wld_nl80211_getSharedState(), vendorInfo.wiphyId, mxl_parseWiphyInfo, &vendorInfo);
 
-            // set the main interface alias
-            const char* alias = "";
-            if(vendorInfo.wiphyDfsAntenna) {
-                alias = s_defaultZwDfsIfName;
-            } else {
-                alias = s_defaultIfNames[freqBand];
-            }
+            whm_mxl_mainIface_t* pIface = &ifaces[nrIfaces++];
+            pIface->wiphy = pWiphy->wiphy;
+            pIface->phyName = pWiphy->name;
+            pIface->alias = vendorInfo.wiphyDfsAntenna ? s_defaultZwDfsIfName : s_defaultIfNames[freqBand];
+            SAH_TRACEZ_WARNING(ME, "Add main interface %s for phy %s(%d)", pIface->alias, pWiphy->name, pWiphy->wiphy);
+        }
+        whm_mxl_module_markBootPhase(MXL_BOOT_WIPHYS_PROBED);
 
-            // add the main interface
-            swl_exec_result_t result;
-            memset(&result, 0, sizeof(swl_exec_result_t));
-            rc = SWL_EXEC_BUF_EXT(&result, "iw", "phy %s interface add %s type __ap", pWiphy->name, alias);
-            if((result.exitInfo.isSignaled) || (result.exitInfo.exitStatus != 0)) {
-                rc = SWL_RC_ERROR;
+        // second pass: create all main interfaces, falling back to iw for the failed ones
+        s_createMainIfacesWithNl80211(ifaces, nrIfaces);
+        for(uint32_t i = 0; i < nrIfaces; i++) {
+            if(ifaces[i].created) {
+                continue;
             }
-            ASSERT_EQUALS(rc, SWL_RC_OK, rc, ME, "Fail to create main interface %s(%d)", alias, pWiphy->wiphy);
-            SAH_TRACEZ_WARNING(ME, "Main interface %s added for phy %s(%d)", alias, pWiphy->name, pWiphy->wiphy);
+            rc = s_createMainIfaceWithIw(&ifaces[i]);
+            ASSERT_EQUALS(rc, SWL_RC_OK, rc, ME, "Fail to create all main interfaces");
         }
+        whm_mxl_module_markBootPhase(MXL_BOOT_IFACES_CREATED);
         index = s_checkAndAddRadios();
     }
 
@@ -155,6 +300,9 @@ swl_rc_ne whm_mxl_module_addRadios(void) {
         SAH_TRACEZ_INFO(ME, "NO Wireless interface found");
         return SWL_RC_ERROR;
     }
+    /* no-op when already recorded, e.g. interfaces existing at boot or radios added later on */
+    whm_mxl_module_markBootPhase(MXL_BOOT_IFACES_CREATED);
+    whm_mxl_module_markBootPhase(MXL_BOOT_RADIOS_ADDED);
 
     return SWL_RC_OK;
 }
@@ -162,6 +310,8 @@ swl_rc_ne whm_mxl_module_addRadios(void) {
 bool whm_mxl_module_init(void) {
     ASSERT_FALSE(s_init, false, ME, "already initialized");
     SAH_TRACEZ_INFO(ME, "Mxl init");
+    memset(&s_bootTimes, 0, sizeof(s_bootTimes));
+    whm_mxl_module_markBootPhase(MXL_BOOT_MODULE_INIT);
     const T_CWLD_FUNC_TABLE* nl80211Fta = wld_nl80211_getVendorTable();
     ASSERT_NOT_NULL(nl80211Fta, false, ME, "nl80211 FTA is not initiated");
 
@@ -246,6 +396,7 @@ bool whm_mxl_module_init(void) {
     /* register vendor */
     s_vendor = wld_registerVendor(MXL_VENDOR_NAME, &fta);
     ASSERT_NOT_NULL(s_vendor, false, ME, "fail to register vendor %s", MXL_VENDOR_NAME);
+    whm_mxl_module_markBootPhase(MXL_BOOT_VENDOR_REGISTERED);
 
     /* share the same generic and native fsm manager, of nl80211 wld implementation */
     wld_fsm_init(s_vendor, (wld_fsmMngr_t*) wld_nl80211_getFsmMngr());
@@ -334,3 +485,24 @@ void _whm_mxl_module_modeObj_ocf(const char* const sig_name,
                             void* const priv) {
     swla_dm_procObjEvtOfLocalDm(&sModuleModeDmHdlrs, sig_name, data, priv);
 }
+
+amxd_status_t _whm_mxl_module_getBootTimes(amxd_object_t* object _UNUSED,
+                                           amxd_function_t* func _UNUSED,
+                                           amxc_var_t* args _UNUSED,
+                                           amxc_var_t* retval) {
+    amxc_var_set_type(retval, AMXC_VAR_ID_HTABLE);
+    const swl_timeSpecMono_t* pStartTs = &s_bootTimes.phaseTs[MXL_BOOT_MODULE_INIT];
+    amxc_var_t* pPhaseMap = amxc_var_add_key(amxc_htable_t, retval, "Phases", NULL);
+    for(uint32_t i = 0; i < MXL_BOOT_PHASE_MAX; i++) {
+        if(s_bootTimes.phaseDone[i]) {
+            amxc_var_add_key(int64_t, pPhaseMap, s_bootPhaseNames[i], swl_timespec_diffToMillisec(pStartTs, &s_bootTimes.phaseTs[i]));
+        }
+    }
+    amxc_var_t* pRadMap = amxc_var_add_key(amxc_htable_t, retval, "RadioFirstVapUp", NULL);
+    for(uint32_t i = 0; i < s_bootTimes.nrRadios; i++) {
+        if(s_bootTimes.radios[i].up) {
+            amxc_var_add_key(int64_t, pRadMap, s_bootTimes.radios[i].name, swl_timespec_diffToMillisec(pStartTs, &s_bootTimes.radios[i].upTs));
+        }
+    }
+    return amxd_status_ok;
+}
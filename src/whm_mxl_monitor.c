@@ -28,22 +28,40 @@
 #include "whm_mxl_rad.h"
 #include "whm_mxl_parser.h"
 #include "whm_mxl_monitor.h"
+#include "whm_mxl_nlVendor.h"
 
+#include <stdlib.h>
 #include <vendor_cmds_copy.h>
 
 #define ME "mxlMon"
 
-#define NASTA_ENTRIES_MAX                       (32)
+#define NASTA_CAPACITY_DEFAULT                  (256)
+#define NASTA_CAPACITY_MAX                      (1024)
+#define NASTA_BATCH_SIZE_DEFAULT                (8)
+#define NASTA_BATCH_SIZE_MAX                    (64)
 #define SCAN_TIMEOUT_PER_CHAN_DEFAULT_MS        (20)
-#define SCAN_TIMEOUT_TOTAL_DEFAULT_MS           ((NASTA_ENTRIES_MAX * SCAN_TIMEOUT_PER_CHAN_DEFAULT_MS) + 1000U)
+#define SCAN_TIMEOUT_TOTAL_DEFAULT_MS           ((NASTA_BATCH_SIZE_DEFAULT * SCAN_TIMEOUT_PER_CHAN_DEFAULT_MS) + 1000U)
 #define SCAN_TIMEOUT_PER_CHAN_SAFETY_MULTIPLIER (10)
+#define NASTA_SYNC_HYSTERESIS_DEFAULT           (2)
+#define NASTA_SYNC_INTERVAL_DEFAULT_MS          (1000)
 
+const char* cstr_NASTA_SCHED_POLICY[] = {"Priority", "RoundRobin", 0};
 
-mxl_nastaEntryData_t* whm_mxl_monitor_fetchRunNaStaEntry(T_Radio* pRad, swl_macBin_t* pStaMac) {
+static void s_naStaSyncTimerCb(amxp_timer_t* timer, void* priv);
+
+static uint32_t s_macHash(const swl_macBin_t* pMac) {
+    uint32_t hash = 2166136261U;
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(pMac->bMac); i++) {
+        hash = (hash ^ pMac->bMac[i]) * 16777619U;
+    }
+    return hash % MXL_NASTA_HASH_SIZE;
+}
+
+mxl_nastaEntryData_t* whm_mxl_monitor_fetchNaStaEntry(T_Radio* pRad, swl_macBin_t* pStaMac) {
     ASSERTS_NOT_NULL(pStaMac, NULL, ME, "NULL");
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERTS_NOT_NULL(vendorData, NULL, ME, "NULL");
-    amxc_llist_for_each(it, &vendorData->naSta.scanList) {
+    amxc_llist_for_each(it, &vendorData->naSta.buckets[s_macHash(pStaMac)]) {
         mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, it);
         if(swl_typeMacBin_equalsRef(&pEntry->mac, pStaMac)) {
             return pEntry;
@@ -52,32 +70,85 @@ mxl_nastaEntryData_t* whm_mxl_monitor_fetchRunNaStaEntry(T_Radio* pRad, swl_macB
     return NULL;
 }
 
-mxl_nastaEntryData_t* whm_mxl_monitor_addRunNaStaEntry(T_Radio* pRad, swl_macBin_t* pStaMac) {
-    ASSERTS_NOT_NULL(pStaMac, NULL, ME, "NULL");
+mxl_nastaEntryData_t* whm_mxl_monitor_addNaStaEntry(T_Radio* pRad, T_NonAssociatedDevice* pMD) {
+    ASSERTS_NOT_NULL(pMD, NULL, ME, "NULL");
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERTS_NOT_NULL(vendorData, NULL, ME, "NULL");
-    mxl_nastaEntryData_t* pEntry = whm_mxl_monitor_fetchRunNaStaEntry(pRad, pStaMac);
-    ASSERTS_NULL(pEntry, pEntry, ME, "Found");
+    swl_macBin_t* pStaMac = (swl_macBin_t*) pMD->MACAddress;
+    mxl_nastaEntryData_t* pEntry = whm_mxl_monitor_fetchNaStaEntry(pRad, pStaMac);
+    if(pEntry != NULL) {
+        pEntry->pMD = pMD;
+        return pEntry;
+    }
+    if(vendorData->naSta.nrEntries >= vendorData->naSta.capacity) {
+        SAH_TRACEZ_INFO(ME, "%s: NaSta capacity %u reached, not monitoring %s", pRad->Name,
+                        vendorData->naSta.capacity, swl_typeMacBin_toBuf32Ref(pStaMac).buf);
+        return NULL;
+    }
     pEntry = calloc(1, sizeof(mxl_nastaEntryData_t));
     ASSERT_NOT_NULL(pEntry, pEntry, ME, "NULL");
     memcpy(&pEntry->mac, pStaMac, sizeof(swl_macBin_t));
-    pEntry->startTs = swl_timespec_getMonoVal();
-    amxc_llist_append(&vendorData->naSta.scanList, &(pEntry->it));
+    pEntry->pMD = pMD;
+    pEntry->syncGen = vendorData->naSta.syncGen;
+    pEntry->addTime = swl_time_getMonoSec();
+    amxc_llist_append(&vendorData->naSta.buckets[s_macHash(pStaMac)], &pEntry->it);
+    amxc_llist_append(&vendorData->naSta.schedList, &pEntry->schedIt);
+    vendorData->naSta.nrEntries++;
     return pEntry;
 }
 
-void whm_mxl_monitor_delRunNaStaEntry(mxl_nastaEntryData_t* pEntry) {
+void whm_mxl_monitor_delNaStaEntry(T_Radio* pRad, mxl_nastaEntryData_t* pEntry) {
     ASSERTS_NOT_NULL(pEntry, , ME, "NULL");
+    mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(vendorData, , ME, "NULL");
     amxc_llist_it_take(&pEntry->it);
+    amxc_llist_it_take(&pEntry->schedIt);
+    amxc_llist_it_take(&pEntry->runIt);
+    if(pEntry->dirty) {
+        vendorData->naSta.nrDirty--;
+    }
     free(pEntry);
+    vendorData->naSta.nrEntries--;
+}
+
+static void s_dropAllNaStaEntries(T_Radio* pRad) {
+    mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(vendorData, , ME, "NULL");
+    amxc_llist_for_each(it, &vendorData->naSta.schedList) {
+        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, schedIt);
+        whm_mxl_monitor_delNaStaEntry(pRad, pEntry);
+    }
+}
+
+mxl_nastaEntryData_t* whm_mxl_monitor_fetchRunNaStaEntry(T_Radio* pRad, swl_macBin_t* pStaMac) {
+    mxl_nastaEntryData_t* pEntry = whm_mxl_monitor_fetchNaStaEntry(pRad, pStaMac);
+    ASSERTS_NOT_NULL(pEntry, NULL, ME, "NULL");
+    return amxc_llist_it_is_in_list(&pEntry->runIt) ? pEntry : NULL;
+}
+
+static void s_startRunNaStaEntry(mxl_VendorData_t* vendorData, mxl_nastaEntryData_t* pEntry, uint32_t queuePos) {
+    pEntry->startTs = swl_timespec_getMonoVal();
+    //safety delay, plus the scan time of the requests queued before in the same window
+    pEntry->timeoutMs = (SCAN_TIMEOUT_PER_CHAN_SAFETY_MULTIPLIER + queuePos) * vendorData->naSta.scanTimeout;
+    pEntry->nrRequests++;
+    amxc_llist_append(&vendorData->naSta.scanList, &pEntry->runIt);
+}
+
+void whm_mxl_monitor_completeRunNaStaEntry(mxl_nastaEntryData_t* pEntry, bool measured) {
+    ASSERTS_NOT_NULL(pEntry, , ME, "NULL");
+    amxc_llist_it_take(&pEntry->runIt);
+    if(measured) {
+        pEntry->nrMeasurements++;
+        pEntry->lastMeasTime = swl_time_getMonoSec();
+    }
 }
 
 void whm_mxl_monitor_dropAllRunNaStaEntries(T_Radio* pRad) {
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERTS_NOT_NULL(vendorData, , ME, "NULL");
     amxc_llist_for_each(it, &vendorData->naSta.scanList) {
-        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, it);
-        whm_mxl_monitor_delRunNaStaEntry(pEntry);
+        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, runIt);
+        whm_mxl_monitor_completeRunNaStaEntry(pEntry, false);
     }
 }
 
@@ -90,15 +161,15 @@ uint32_t whm_mxl_monitor_getRunNaStaEntryCount(T_Radio* pRad) {
 void whm_mxl_monitor_checkRunNaStaList(T_Radio* pRad) {
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERTS_NOT_NULL(vendorData, , ME, "NULL");
+    swl_timeSpecMono_t currTs = swl_timespec_getMonoVal();
     amxc_llist_for_each(it, &vendorData->naSta.scanList) {
-        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, it);
-        swl_timeSpecMono_t currTs = swl_timespec_getMonoVal();
+        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, runIt);
         swl_timeSpecMono_t diffTs;
         swl_timespec_diff(&diffTs, &pEntry->startTs, &currTs);
-        //safety delay: at most twice the scan time per channel
-        if(swl_timespec_toMs(&diffTs) > (SCAN_TIMEOUT_PER_CHAN_SAFETY_MULTIPLIER * vendorData->naSta.scanTimeout)) {
+        if(swl_timespec_toMs(&diffTs) > pEntry->timeoutMs) {
             SAH_TRACEZ_WARNING(ME, "expired scan entry %s: clean it up", swl_typeMacBin_toBuf32Ref(&pEntry->mac).buf);
-            whm_mxl_monitor_delRunNaStaEntry(pEntry);
+            pEntry->nrTimeouts++;
+            whm_mxl_monitor_completeRunNaStaEntry(pEntry, false);
         }
     }
     if(amxc_llist_is_empty(&vendorData->naSta.scanList)) {
@@ -106,6 +177,92 @@ void whm_mxl_monitor_checkRunNaStaList(T_Radio* pRad) {
     }
 }
 
+/*
+ * Align the monitored entries with the radio NaSta list:
+ * track new devices (within capacity) and forget removed ones.
+ */
+static void s_syncNaStaEntries(T_Radio* pRad, mxl_VendorData_t* vendorData) {
+    uint32_t gen = ++vendorData->naSta.syncGen;
+    uint32_t nrRejected = 0;
+    amxc_llist_for_each(it, &pRad->naStations) {
+        T_NonAssociatedDevice* pMD = amxc_container_of(it, T_NonAssociatedDevice, it);
+        mxl_nastaEntryData_t* pEntry = whm_mxl_monitor_addNaStaEntry(pRad, pMD);
+        if(pEntry != NULL) {
+            pEntry->syncGen = gen;
+        } else {
+            nrRejected++;
+        }
+    }
+    if(nrRejected != vendorData->naSta.nrRejected) {
+        SAH_TRACEZ_WARNING(ME, "%s: NaSta capacity %u reached, %u stations not monitored", pRad->Name,
+                           vendorData->naSta.capacity, nrRejected);
+    }
+    vendorData->naSta.nrRejected = nrRejected;
+    amxc_llist_for_each(it, &vendorData->naSta.schedList) {
+        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, schedIt);
+        if(pEntry->syncGen != gen) {
+            whm_mxl_monitor_delNaStaEntry(pRad, pEntry);
+        }
+    }
+}
+
+static bool s_isMeasuredBefore(mxl_nastaEntryData_t* pEntry, mxl_nastaEntryData_t* pOther) {
+    if(pEntry->lastMeasTime != pOther->lastMeasTime) {
+        return pEntry->lastMeasTime < pOther->lastMeasTime;
+    }
+    return pEntry->addTime < pOther->addTime;
+}
+
+static int s_cmpWindowChannel(const void* a, const void* b) {
+    const T_NonAssociatedDevice* pMDa = (*(mxl_nastaEntryData_t* const*) a)->pMD;
+    const T_NonAssociatedDevice* pMDb = (*(mxl_nastaEntryData_t* const*) b)->pMD;
+    if(pMDa->operatingClass != pMDb->operatingClass) {
+        return (int) pMDa->operatingClass - (int) pMDb->operatingClass;
+    }
+    return (int) pMDa->channel - (int) pMDb->channel;
+}
+
+/*
+ * Select the next measurement window: up to maxEntries idle entries,
+ * either the ones with the oldest measurement (priority) or the next ones in turn (round robin).
+ * The window is ordered by channel, so that off-channel measurements are grouped.
+ */
+static uint32_t s_selectWindow(mxl_VendorData_t* vendorData, mxl_nastaEntryData_t** window, uint32_t maxEntries) {
+    uint32_t nr = 0;
+    ASSERTS_NOT_EQUALS(maxEntries, 0, 0, ME, "no scan budget left");
+    amxc_llist_for_each(it, &vendorData->naSta.schedList) {
+        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, schedIt);
+        if(amxc_llist_it_is_in_list(&pEntry->runIt)) {
+            continue;
+        }
+        if(vendorData->naSta.policy == MXL_NASTA_SCHED_ROUND_ROBIN) {
+            window[nr++] = pEntry;
+            if(nr == maxEntries) {
+                break;
+            }
+            continue;
+        }
+        uint32_t pos = nr;
+        while((pos > 0) && s_isMeasuredBefore(pEntry, window[pos - 1])) {
+            if(pos < maxEntries) {
+                window[pos] = window[pos - 1];
+            }
+            pos--;
+        }
+        if(pos < maxEntries) {
+            window[pos] = pEntry;
+            nr = SWL_MIN(nr + 1, maxEntries);
+        }
+    }
+    if(vendorData->naSta.policy == MXL_NASTA_SCHED_ROUND_ROBIN) {
+        for(uint32_t i = 0; i < nr; i++) {
+            amxc_llist_append(&vendorData->naSta.schedList, &window[i]->schedIt);
+        }
+    }
+    qsort(window, nr, sizeof(window[0]), s_cmpWindowChannel);
+    return nr;
+}
+
 int whm_mxl_monitor_setupStamon(T_Radio* pRad, bool enable) {
     if(!enable) {
         whm_mxl_monitor_dropAllRunNaStaEntries(pRad);
@@ -137,16 +294,13 @@ static swl_rc_ne s_getStaScanTimeOutCb(swl_rc_ne rc, struct nlmsghdr* nlh, void*
     T_Radio* pRad = (T_Radio*) priv;
     ASSERT_NOT_NULL(pRad, SWL_RC_ERROR, ME, "NULL");
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
-
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERT_NOT_NULL(vendorData, SWL_RC_ERROR, ME, "NULL");
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    uint32_t scanTimeout = nla_get_u32(tb[NL80211_ATTR_VENDOR_DATA]);
+
+    whm_mxl_nlVendorView_t view;
+    swl_rc_ne ret = whm_mxl_nlVendor_getReplyView(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA_SCAN_TIME, &view);
+    ASSERT_EQUALS(ret, SWL_RC_OK, ret, ME, "fail to decode nasta scan timeout");
+    uint32_t scanTimeout = *WHM_MXL_NL_VENDOR_VIEW(&view, uint32_t);
     SAH_TRACEZ_INFO(ME, "%s: Nasta scan timeout is %d", pRad->Name, scanTimeout);
     if(!scanTimeout) {
         vendorData->naSta.scanTimeout = SCAN_TIMEOUT_PER_CHAN_DEFAULT_MS;
@@ -179,7 +333,18 @@ void whm_mxl_monitor_init(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRad, , ME, "NULL");
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERT_NOT_NULL(vendorData, , ME, "NULL");
+    for(uint32_t i = 0; i < MXL_NASTA_HASH_SIZE; i++) {
+        amxc_llist_init(&vendorData->naSta.buckets[i]);
+    }
+    amxc_llist_init(&vendorData->naSta.schedList);
+    amxc_llist_init(&vendorData->naSta.scanList);
+    vendorData->naSta.capacity = NASTA_CAPACITY_DEFAULT;
+    vendorData->naSta.batchSize = NASTA_BATCH_SIZE_DEFAULT;
+    vendorData->naSta.policy = MXL_NASTA_SCHED_PRIORITY;
+    vendorData->naSta.syncHysteresis = NASTA_SYNC_HYSTERESIS_DEFAULT;
+    vendorData->naSta.syncInterval = NASTA_SYNC_INTERVAL_DEFAULT_MS;
     amxp_timer_new(&vendorData->naSta.timer, s_scanTimeoutHandler, pRad);
+    amxp_timer_new(&vendorData->naSta.syncTimer, s_naStaSyncTimerCb, pRad);
     whm_mxl_monitor_getStaScanTimeOut(pRad);
 }
 
@@ -188,7 +353,9 @@ void whm_mxl_monitor_deinit(T_Radio* pRad) {
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERT_NOT_NULL(vendorData, , ME, "NULL");
     whm_mxl_monitor_setupStamon(pRad, false);
+    s_dropAllNaStaEntries(pRad);
     amxp_timer_delete(&vendorData->naSta.timer);
+    amxp_timer_delete(&vendorData->naSta.syncTimer);
 }
 
 static swl_rc_ne s_naStaStatsCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
@@ -200,13 +367,11 @@ static swl_rc_ne s_naStaStatsCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv)
     T_Radio* pRad = (T_Radio*) priv;
     ASSERT_NOT_NULL(pRad, SWL_RC_ERROR, ME, "pRad is NULL");
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
+    whm_mxl_nlVendorView_t view;
+    swl_rc_ne ret = whm_mxl_nlVendor_getReplyView(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA, &view);
+    ASSERT_EQUALS(ret, SWL_RC_OK, ret, ME, "fail to decode nasta stats");
 
-    if (mxl_parseNaStaStats(pRad, tb, NASTA_STATS_REQ_SYNC, false) == SWL_RC_OK) {
+    if (mxl_parseNaStaStats(pRad, &view, NASTA_STATS_REQ_SYNC, false) == SWL_RC_OK) {
         whm_mxl_monitor_checkRunNaStaList(pRad);
     }
 
@@ -264,7 +429,6 @@ int whm_mxl_monitor_updateMonStats(T_Radio* pRad) {
     ASSERT_TRUE(wld_rad_isUpAndReady(pRad), SWL_RC_INVALID_STATE, ME, "%s: radio state not ready for scan", pRad->Name);
 
     swl_rc_ne rc;
-    uint32_t currStaCount = 0;
 
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERT_NOT_NULL(vendorData, SWL_RC_INVALID_PARAM, ME, "NULL");
@@ -281,29 +445,30 @@ int whm_mxl_monitor_updateMonStats(T_Radio* pRad) {
         whm_mxl_monitor_getStaScanTimeOut(pRad);
     }
 
-    amxc_llist_for_each(it, &pRad->naStations) {
-        mxl_nastaEntryData_t* pEntry = NULL;
-        T_NonAssociatedDevice* pMD = amxc_container_of(it, T_NonAssociatedDevice, it);
-        if(!pMD || ((pEntry = whm_mxl_monitor_fetchRunNaStaEntry(pRad, (swl_macBin_t*) pMD->MACAddress)) != NULL)) {
-            continue;
-        }
-        if(currStaCount > NASTA_ENTRIES_MAX) {
-            SAH_TRACEZ_WARNING(ME, "%s: Number of non-associated devices scan limit reached", pRad->Name);
-            break;
-        }
-        pEntry = whm_mxl_monitor_addRunNaStaEntry(pRad, (swl_macBin_t*) pMD->MACAddress);
-        if(pEntry == NULL) {
-            continue;
-        }
+    s_syncNaStaEntries(pRad, vendorData);
+
+    /* Keep the scan budget bounded: at most batchSize measurements in flight */
+    uint32_t runCount = whm_mxl_monitor_getRunNaStaEntryCount(pRad);
+    uint32_t budget = vendorData->naSta.batchSize - SWL_MIN(runCount, vendorData->naSta.batchSize);
+    mxl_nastaEntryData_t* window[NASTA_BATCH_SIZE_MAX];
+    uint32_t nrSelected = s_selectWindow(vendorData, window, SWL_MIN(budget, NASTA_BATCH_SIZE_MAX));
+    if(nrSelected > 0) {
+        vendorData->naSta.nrWindows++;
+    }
 
-        rc = s_getNaStaStats(pRad, pMD, NASTA_STATS_REQ_SYNC);
+    for(uint32_t i = 0; i < nrSelected; i++) {
+        mxl_nastaEntryData_t* pEntry = window[i];
+        s_startRunNaStaEntry(vendorData, pEntry, i);
+        rc = s_getNaStaStats(pRad, pEntry->pMD, NASTA_STATS_REQ_ASYNC);
         if(rc < SWL_RC_OK) {
-            whm_mxl_monitor_delRunNaStaEntry(pEntry);
+            /* driver busy: remaining entries are kept for the next window */
+            SAH_TRACEZ_INFO(ME, "%s: NaSta request failed (%d), %u entries postponed", pRad->Name, rc, nrSelected - i);
+            whm_mxl_monitor_completeRunNaStaEntry(pEntry, false);
+            break;
         }
-        currStaCount++;
     }
 
-    uint32_t runCount = whm_mxl_monitor_getRunNaStaEntryCount(pRad);
+    runCount = whm_mxl_monitor_getRunNaStaEntryCount(pRad);
     uint32_t delay = SWL_MAX((vendorData->naSta.scanTimeout * SCAN_TIMEOUT_PER_CHAN_SAFETY_MULTIPLIER) * runCount, SCAN_TIMEOUT_TOTAL_DEFAULT_MS);
     if(runCount > 0) {
         amxp_timer_start(vendorData->naSta.timer, delay /* ms */);
@@ -312,26 +477,28 @@ int whm_mxl_monitor_updateMonStats(T_Radio* pRad) {
     return SWL_RC_OK;
 }
 
-int whm_mxl_monitor_updateNaStaObj(T_Radio* pRad){
-
-    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
-
-    amxd_trans_t trans;
-    ASSERT_TRANSACTION_INIT(pRad->pBus, &trans, SWL_RC_ERROR, ME, "%s : trans init failure", pRad->Name);
-
+/*
+ * Write the dirty entries to their NonAssociatedDevice instance, in one transaction.
+ * The entries written are marked writing, and only marked synced by the caller once the transaction is applied.
+ */
+static swl_rc_ne s_writeNaStaObj(T_Radio* pRad, mxl_VendorData_t* vendorData) {
     amxd_object_t* naStaMonObject = amxd_object_findf(get_wld_object(), "Radio.%u.NaStaMonitor", pRad->ref_index+1);
     ASSERT_NOT_NULL(naStaMonObject, SWL_RC_ERROR, ME, "No naStaMonObject object found");
-    
     amxd_object_t* naDevObject = amxd_object_get(naStaMonObject, "NonAssociatedDevice");
     ASSERT_NOT_NULL(naDevObject, SWL_RC_ERROR, ME, "No naDevObject object found");
 
+    amxd_trans_t trans;
+    ASSERT_TRANSACTION_INIT(pRad->pBus, &trans, SWL_RC_ERROR, ME, "%s : trans init failure", pRad->Name);
+
+    uint32_t nrWritten = 0;
     amxd_object_for_each(instance, it, naDevObject) {
         amxd_object_t* instance = amxc_container_of(it, amxd_object_t, it);
-        if(instance == NULL) {
+        wld_nasta_t* pMD = (instance != NULL) ? (wld_nasta_t*) instance->priv : NULL;
+        if(pMD == NULL) {
             continue;
         }
-        wld_nasta_t* pMD = (wld_nasta_t*) instance->priv;
-        if(!pMD) {
+        mxl_nastaEntryData_t* pEntry = whm_mxl_monitor_fetchNaStaEntry(pRad, (swl_macBin_t*) pMD->MACAddress);
+        if((pEntry == NULL) || !pEntry->dirty) {
             continue;
         }
         amxd_trans_select_object(&trans, instance);
@@ -339,10 +506,125 @@ int whm_mxl_monitor_updateNaStaObj(T_Radio* pRad){
         amxd_trans_set_uint8_t(&trans, "Channel", pMD->channel);
         amxd_trans_set_uint8_t(&trans, "OperatingClass", pMD->operatingClass);
         swl_typeTimeMono_toTransParam(&trans, "TimeStamp", pMD->TimeStamp);
+        pEntry->writing = true;
+        nrWritten++;
+    }
+    if(nrWritten == 0) {
+        amxd_trans_clean(&trans);
+        return SWL_RC_OK;
     }
 
     ASSERT_TRANSACTION_LOCAL_DM_END(&trans, SWL_RC_ERROR, ME, "%s : trans apply failure", pRad->Name);
+    vendorData->naSta.nrSyncFlushes++;
+    vendorData->naSta.nrSyncWrites += nrWritten;
+    SAH_TRACEZ_INFO(ME, "%s: synced %u NaSta instances", pRad->Name, nrWritten);
+    return SWL_RC_OK;
+}
 
+static swl_rc_ne s_flushNaStaObj(T_Radio* pRad) {
+    mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(vendorData, SWL_RC_ERROR, ME, "NULL");
+    ASSERTS_NOT_EQUALS(vendorData->naSta.nrDirty, 0, SWL_RC_OK, ME, "%s: no NaSta change to sync", pRad->Name);
+    swl_timespec_getMono(&vendorData->naSta.lastSyncTs);
+
+    swl_rc_ne rc = s_writeNaStaObj(pRad, vendorData);
+
+    amxc_llist_for_each(it, &vendorData->naSta.schedList) {
+        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, schedIt);
+        if(pEntry->writing) {
+            pEntry->writing = false;
+            if(rc < SWL_RC_OK) {
+                /* transaction not applied: keep the entry dirty for the next flush */
+                continue;
+            }
+            pEntry->syncRssi = pEntry->pMD->SignalStrength;
+            pEntry->syncChannel = pEntry->pMD->channel;
+            pEntry->syncOperClass = pEntry->pMD->operatingClass;
+            pEntry->syncTime = pEntry->pMD->TimeStamp;
+            pEntry->synced = true;
+        } else if(!pEntry->dirty) {
+            continue;
+        }
+        /* written, or left dirty without writable instance: marked again on its next change */
+        pEntry->dirty = false;
+        vendorData->naSta.nrDirty--;
+    }
+    if((rc < SWL_RC_OK) && (vendorData->naSta.nrDirty > 0)) {
+        amxp_timer_start(vendorData->naSta.syncTimer, vendorData->naSta.syncInterval);
+    }
+    return rc;
+}
+
+static void s_naStaSyncTimerCb(amxp_timer_t* timer _UNUSED, void* priv) {
+    T_Radio* pRad = (T_Radio*) priv;
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    s_flushNaStaObj(pRad);
+}
+
+/*
+ * Whether the measurement of the entry moved beyond the hysteresis since it was last written.
+ * With a hysteresis, the TimeStamp of a stable entry is still refreshed once per sync interval.
+ */
+static bool s_isNaStaChanged(mxl_nastaData_t* pNaSta, mxl_nastaEntryData_t* pEntry) {
+    T_NonAssociatedDevice* pMD = pEntry->pMD;
+    if(!pEntry->synced) {
+        return true;
+    }
+    if((pMD->channel != pEntry->syncChannel) || (pMD->operatingClass != pEntry->syncOperClass)) {
+        return true;
+    }
+    if(pNaSta->syncHysteresis == 0) {
+        return (pMD->SignalStrength != pEntry->syncRssi) || (pMD->TimeStamp != pEntry->syncTime);
+    }
+    if((pMD->TimeStamp > pEntry->syncTime) && ((uint64_t) (pMD->TimeStamp - pEntry->syncTime) * 1000 >= pNaSta->syncInterval)) {
+        return true;
+    }
+    return ((uint32_t) abs((int) pMD->SignalStrength - (int) pEntry->syncRssi) >= pNaSta->syncHysteresis);
+}
+
+/*
+ * Sync the NonAssociatedDevice instances with the last measurements.
+ * Only the entries whose measurement moved beyond the hysteresis are written,
+ * and the writes are flushed at most once per sync interval.
+ */
+int whm_mxl_monitor_updateNaStaObj(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+    mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(vendorData, SWL_RC_ERROR, ME, "NULL");
+    mxl_nastaData_t* pNaSta = &vendorData->naSta;
+
+    amxc_llist_for_each(it, &pNaSta->schedList) {
+        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, schedIt);
+        if(pEntry->pMD == NULL) {
+            continue;
+        }
+        if(!s_isNaStaChanged(pNaSta, pEntry)) {
+            /* only a new measurement kept back by the hysteresis avoids a write */
+            swl_timeMono_t measTime = pEntry->pMD->TimeStamp;
+            if((measTime != pEntry->syncTime) && (measTime != pEntry->avoidedTime)) {
+                pEntry->avoidedTime = measTime;
+                pNaSta->nrSyncAvoided++;
+            }
+            continue;
+        }
+        if(pEntry->dirty) {
+            pNaSta->nrSyncCoalesced++;
+            continue;
+        }
+        pEntry->dirty = true;
+        pNaSta->nrDirty++;
+    }
+    ASSERTS_NOT_EQUALS(pNaSta->nrDirty, 0, SWL_RC_OK, ME, "%s: no NaSta change to sync", pRad->Name);
+    amxp_timer_state_t state = amxp_timer_get_state(pNaSta->syncTimer);
+    ASSERTS_FALSE((state == amxp_timer_started) || (state == amxp_timer_running), SWL_RC_OK, ME, "%s: NaSta sync pending", pRad->Name);
+
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    int64_t elapsed = swl_timespec_diffToMillisec(&pNaSta->lastSyncTs, &now);
+    if((pNaSta->lastSyncTs.tv_sec == 0) || (elapsed >= (int64_t) pNaSta->syncInterval)) {
+        return s_flushNaStaObj(pRad);
+    }
+    amxp_timer_start(pNaSta->syncTimer, pNaSta->syncInterval - elapsed);
     return SWL_RC_OK;
 }
 
@@ -361,6 +643,7 @@ swl_rc_ne whm_mxl_monitor_addStaMon(T_Radio* pRad, T_NonAssociatedDevice* pMD) {
         whm_mxl_monitor_setStaScanTimeOut(pRad, SCAN_TIMEOUT_PER_CHAN_DEFAULT_MS);
         whm_mxl_monitor_getStaScanTimeOut(pRad);
     }
+    whm_mxl_monitor_addNaStaEntry(pRad, pMD);
 
     return SWL_RC_OK;
 }
@@ -369,9 +652,104 @@ int whm_mxl_monitor_delStamon(T_Radio* pRad, T_NonAssociatedDevice* pMD) {
     ASSERT_NOT_NULL(pMD, SWL_RC_INVALID_PARAM, ME, "NULL");
     mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
     ASSERT_NOT_NULL(vendorData, SWL_RC_INVALID_PARAM, ME, "NULL");
-    mxl_nastaEntryData_t* pEntry = whm_mxl_monitor_fetchRunNaStaEntry(pRad, (swl_macBin_t*) pMD->MACAddress);
+    mxl_nastaEntryData_t* pEntry = whm_mxl_monitor_fetchNaStaEntry(pRad, (swl_macBin_t*) pMD->MACAddress);
     ASSERTI_NOT_NULL(pEntry, SWL_RC_OK, ME, "Not found");
-    whm_mxl_monitor_delRunNaStaEntry(pEntry);
+    whm_mxl_monitor_delNaStaEntry(pRad, pEntry);
     whm_mxl_monitor_checkRunNaStaList(pRad);
     return SWL_RC_OK;
 }
+
+static void s_trimNaStaEntries(T_Radio* pRad, mxl_VendorData_t* vendorData) {
+    amxc_llist_it_t* it = amxc_llist_get_last(&vendorData->naSta.schedList);
+    while((it != NULL) && (vendorData->naSta.nrEntries > vendorData->naSta.capacity)) {
+        amxc_llist_it_t* prev = amxc_llist_it_get_previous(it);
+        whm_mxl_monitor_delNaStaEntry(pRad, amxc_container_of(it, mxl_nastaEntryData_t, schedIt));
+        it = prev;
+    }
+}
+
+static void s_setNaStaSchedulerConf_ocf(void* priv _UNUSED, amxd_object_t* object, const amxc_var_t* const newParamValues _UNUSED) {
+    SAH_TRACEZ_IN(ME);
+    /* WiFi.Radio.{}.Vendor.NaStaScheduler. */
+    amxd_object_t* radObj = amxd_object_get_parent(amxd_object_get_parent(object));
+    T_Radio* pRad = wld_rad_fromObj(radObj);
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(vendorData, , ME, "NULL");
+
+    uint32_t capacity = amxd_object_get_value(uint32_t, object, "Capacity", NULL);
+    uint32_t batchSize = amxd_object_get_value(uint32_t, object, "BatchSize", NULL);
+    char* policy = amxd_object_get_value(cstring_t, object, "Policy", NULL);
+    vendorData->naSta.syncHysteresis = amxd_object_get_value(uint32_t, object, "SyncHysteresis", NULL);
+    vendorData->naSta.syncInterval = amxd_object_get_value(uint32_t, object, "SyncInterval", NULL);
+    vendorData->naSta.capacity = SWL_MIN(SWL_MAX(capacity, 1U), (uint32_t) NASTA_CAPACITY_MAX);
+    vendorData->naSta.batchSize = SWL_MIN(SWL_MAX(batchSize, 1U), (uint32_t) NASTA_BATCH_SIZE_MAX);
+    vendorData->naSta.policy = swl_conv_charToEnum(policy, cstr_NASTA_SCHED_POLICY, MXL_NASTA_SCHED_MAX, MXL_NASTA_SCHED_PRIORITY);
+    free(policy);
+    SAH_TRACEZ_INFO(ME, "%s: NaSta scheduler capacity %u batch %u policy %s sync hysteresis %udB interval %ums", pRad->Name,
+                    vendorData->naSta.capacity, vendorData->naSta.batchSize, cstr_NASTA_SCHED_POLICY[vendorData->naSta.policy],
+                    vendorData->naSta.syncHysteresis, vendorData->naSta.syncInterval);
+    s_trimNaStaEntries(pRad, vendorData);
+
+    SAH_TRACEZ_OUT(ME);
+}
+
+SWLA_DM_HDLRS(sNaStaSchedulerDmHdlrs, ARR(), .objChangedCb = s_setNaStaSchedulerConf_ocf);
+
+void _whm_mxl_monitor_setNaStaSchedulerConf_ocf(const char* const sig_name,
+                                                const amxc_var_t* const data,
+                                                void* const priv) {
+    swla_dm_procObjEvtOfLocalDm(&sNaStaSchedulerDmHdlrs, sig_name, data, priv);
+}
+
+amxd_status_t _whm_mxl_monitor_getNaStaSchedulerStats(amxd_object_t* object,
+                                                      amxd_function_t* func _UNUSED,
+                                                      amxc_var_t* args _UNUSED,
+                                                      amxc_var_t* retval) {
+    /* WiFi.Radio.{}.Vendor. */
+    T_Radio* pRad = wld_rad_fromObj(amxd_object_get_parent(object));
+    ASSERT_NOT_NULL(pRad, amxd_status_unknown_error, ME, "No Radio Mapped");
+    mxl_VendorData_t* vendorData = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(vendorData, amxd_status_unknown_error, ME, "NULL");
+
+    swl_timeMono_t now = swl_time_getMonoSec();
+    uint64_t totalAge = 0;
+    uint32_t maxAge = 0;
+
+    amxc_var_set_type(retval, AMXC_VAR_ID_HTABLE);
+    amxc_var_t* pEntryList = amxc_var_add_key(amxc_llist_t, retval, "Entries", NULL);
+    amxc_llist_for_each(it, &vendorData->naSta.schedList) {
+        mxl_nastaEntryData_t* pEntry = amxc_container_of(it, mxl_nastaEntryData_t, schedIt);
+        /* Age of the last measurement, or time since monitoring started if never measured */
+        uint32_t age = now - (pEntry->lastMeasTime ? pEntry->lastMeasTime : pEntry->addTime);
+        totalAge += age;
+        maxAge = SWL_MAX(maxAge, age);
+        amxc_var_t* pEntryStats = amxc_var_add(amxc_htable_t, pEntryList, NULL);
+        amxc_var_add_key(cstring_t, pEntryStats, "MACAddress", swl_typeMacBin_toBuf32Ref(&pEntry->mac).buf);
+        amxc_var_add_key(uint32_t, pEntryStats, "MeasurementAge", age);
+        amxc_var_add_key(bool, pEntryStats, "Measured", (pEntry->lastMeasTime != 0));
+        amxc_var_add_key(bool, pEntryStats, "Pending", amxc_llist_it_is_in_list(&pEntry->runIt));
+        amxc_var_add_key(uint32_t, pEntryStats, "Requests", pEntry->nrRequests);
+        amxc_var_add_key(uint32_t, pEntryStats, "Measurements", pEntry->nrMeasurements);
+        amxc_var_add_key(uint32_t, pEntryStats, "Timeouts", pEntry->nrTimeouts);
+        amxc_var_add_key(bool, pEntryStats, "SyncPending", pEntry->dirty);
+    }
+    amxc_var_add_key(cstring_t, retval, "Policy", cstr_NASTA_SCHED_POLICY[vendorData->naSta.policy]);
+    amxc_var_add_key(uint32_t, retval, "Capacity", vendorData->naSta.capacity);
+    amxc_var_add_key(uint32_t, retval, "BatchSize", vendorData->naSta.batchSize);
+    amxc_var_add_key(uint32_t, retval, "NrEntries", vendorData->naSta.nrEntries);
+    amxc_var_add_key(uint32_t, retval, "NrPending", amxc_llist_size(&vendorData->naSta.scanList));
+    amxc_var_add_key(uint32_t, retval, "NrRejected", vendorData->naSta.nrRejected);
+    amxc_var_add_key(uint32_t, retval, "NrWindows", vendorData->naSta.nrWindows);
+    amxc_var_add_key(uint32_t, retval, "MaxMeasurementAge", maxAge);
+    amxc_var_add_key(uint32_t, retval, "AvgMeasurementAge", vendorData->naSta.nrEntries ? (uint32_t) (totalAge / vendorData->naSta.nrEntries) : 0);
+    amxc_var_t* pSyncMap = amxc_var_add_key(amxc_htable_t, retval, "Sync", NULL);
+    amxc_var_add_key(uint32_t, pSyncMap, "Hysteresis", vendorData->naSta.syncHysteresis);
+    amxc_var_add_key(uint32_t, pSyncMap, "Interval", vendorData->naSta.syncInterval);
+    amxc_var_add_key(uint32_t, pSyncMap, "NrPending", vendorData->naSta.nrDirty);
+    amxc_var_add_key(uint64_t, pSyncMap, "NrFlushes", vendorData->naSta.nrSyncFlushes);
+    amxc_var_add_key(uint64_t, pSyncMap, "NrWrites", vendorData->naSta.nrSyncWrites);
+    amxc_var_add_key(uint64_t, pSyncMap, "NrAvoided", vendorData->naSta.nrSyncAvoided);
+    amxc_var_add_key(uint64_t, pSyncMap, "NrCoalesced", vendorData->naSta.nrSyncCoalesced);
+    return amxd_status_ok;
+}
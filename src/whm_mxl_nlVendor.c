@@ -0,0 +1,154 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : whm_mxl_nlVendor.c                                    *
+*         Description  : Decoding of vendor netlink replies and events         *
+*                                                                              *
+*  *****************************************************************************/
+
+#include <netlink/genl/genl.h>
+
+#include "swl/swl_common.h"
+
+#include <nl80211_copy.h>
+
+#include "wld/wld_radio.h"
+#include "wld/wld_nl80211_compat.h"
+
+#include "whm_mxl_utils.h"
+#include "whm_mxl_rad.h"
+#include "whm_mxl_csi.h"
+#include "whm_mxl_nlVendor.h"
+
+#include <vendor_cmds_copy.h>
+
+#define ME "mxlNlv"
+
+typedef enum {
+    MXL_NL_VENDOR_LEN_EXACT,    /* payload is exactly the driver struct */
+    MXL_NL_VENDOR_LEN_MIN,      /* payload holds at least the driver struct */
+} whm_mxl_nlVendorLenCheck_e;
+
+/* Expected payload of one vendor subcmd reply or vendor event */
+typedef struct {
+    uint32_t id;
+    size_t size;
+    whm_mxl_nlVendorLenCheck_e check;
+} whm_mxl_nlVendorPolicy_t;
+
+static const whm_mxl_nlVendorPolicy_t sReplyPolicies[] = {
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_TR181_WLAN_STATS, sizeof(mtlk_wssa_drv_tr181_wlan_stats_t), MXL_NL_VENDOR_LEN_EXACT},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_FLOW_STATUS, sizeof(mtlk_wssa_drv_peer_stats_t), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_CAPABILITIES, sizeof(mtlk_wssa_drv_peer_capabilities_t), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_PER_CLIENT_STATS, sizeof(perClientStats_t), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_DEV_DIAG_RESULT3, sizeof(wifiAssociatedDevDiagnostic3_t), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PARAMS_BG, sizeof(mxl_bgScanParams_t), MXL_NL_VENDOR_LEN_EXACT},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA, sizeof(struct intel_vendor_unconnected_sta), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA_SCAN_TIME, sizeof(uint32_t), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_ZWDFS_ANT, sizeof(uint32_t), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_20MHZ_TX_POWER, sizeof(int), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_SUBCMD_GET_CSI_COUNTERS, sizeof(whm_mxl_csiCounters_t), MXL_NL_VENDOR_LEN_MIN},
+};
+
+static const whm_mxl_nlVendorPolicy_t sEvtPolicies[] = {
+    {LTQ_NL80211_VENDOR_EVENT_UNCONNECTED_STA, sizeof(struct intel_vendor_unconnected_sta), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_EVENT_CHAN_DATA, sizeof(struct intel_vendor_channel_data), MXL_NL_VENDOR_LEN_MIN},
+    {LTQ_NL80211_VENDOR_EVENT_CSI_STATS, sizeof(wifi_csi_driver_nl_event_data_t), MXL_NL_VENDOR_LEN_MIN},
+};
+
+static const whm_mxl_nlVendorPolicy_t* s_findPolicy(const whm_mxl_nlVendorPolicy_t* policies, uint32_t nrPolicies, uint32_t id) {
+    for(uint32_t i = 0; i < nrPolicies; i++) {
+        if(policies[i].id == id) {
+            return &policies[i];
+        }
+    }
+    return NULL;
+}
+
+static bool s_checkLen(size_t len, size_t size, whm_mxl_nlVendorLenCheck_e check) {
+    if(check == MXL_NL_VENDOR_LEN_EXACT) {
+        return (len == size);
+    }
+    return (len >= size);
+}
+
+/*
+ * Locate the vendor data attribute of a vendor reply.
+ * Only the top level attribute list is walked, without filling a full nl80211 attribute table.
+ */
+static struct nlattr* s_findVendorData(struct genlmsghdr* gnlh) {
+    struct nlattr* vendorData = nla_find(genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NL80211_ATTR_VENDOR_DATA);
+    ASSERT_NOT_NULL(vendorData, NULL, ME, "no vendor data");
+    return vendorData;
+}
+
+static swl_rc_ne s_fillView(struct nlattr* vendorData, uint32_t id, size_t size, whm_mxl_nlVendorLenCheck_e check, whm_mxl_nlVendorView_t* pView) {
+    size_t len = (size_t) nla_len(vendorData);
+    ASSERT_TRUE(s_checkLen(len, size, check), SWL_RC_ERROR, ME, "Wrong data size %zu received for %u, expected %s%zu",
+                len, id, (check == MXL_NL_VENDOR_LEN_MIN) ? ">=" : "", size);
+    pView->data = nla_data(vendorData);
+    pView->len = len;
+    pView->id = id;
+    return SWL_RC_OK;
+}
+
+/**
+ * @brief Get a view on the vendor data of a vendor subcmd reply
+ *
+ * The payload size is checked against the driver struct of the subcmd,
+ * so that the callback can read the returned view without further checks.
+ *
+ * @param nlh vendor reply message
+ * @param subcmd vendor subcmd the reply answers
+ * @param pView filled with the payload view, pointing into nlh
+ * @return SWL_RC_OK when the payload matches the subcmd policy, <= SWL_RC_ERROR otherwise
+ */
+swl_rc_ne whm_mxl_nlVendor_getReplyView(struct nlmsghdr* nlh, uint32_t subcmd, whm_mxl_nlVendorView_t* pView) {
+    ASSERT_NOT_NULL(pView, SWL_RC_INVALID_PARAM, ME, "NULL");
+    const whm_mxl_nlVendorPolicy_t* pPolicy = s_findPolicy(sReplyPolicies, SWL_ARRAY_SIZE(sReplyPolicies), subcmd);
+    ASSERT_NOT_NULL(pPolicy, SWL_RC_INVALID_PARAM, ME, "no policy for subcmd %u", subcmd);
+    ASSERT_NOT_NULL(nlh, SWL_RC_INVALID_PARAM, ME, "NULL");
+    struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
+    ASSERT_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_ERROR, ME, "unexpected cmd %d", gnlh->cmd);
+    struct nlattr* vendorData = s_findVendorData(gnlh);
+    ASSERTS_NOT_NULL(vendorData, SWL_RC_ERROR, ME, "NULL");
+    return s_fillView(vendorData, subcmd, pPolicy->size, pPolicy->check, pView);
+}
+
+/**
+ * @brief Get a view on the vendor data of a vendor subcmd reply of a caller defined size
+ *
+ * Used by the generic getters, where the expected payload is given by the caller.
+ */
+swl_rc_ne whm_mxl_nlVendor_getSizedReplyView(struct nlmsghdr* nlh, size_t size, whm_mxl_nlVendorView_t* pView) {
+    ASSERT_NOT_NULL(pView, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(nlh, SWL_RC_INVALID_PARAM, ME, "NULL");
+    struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
+    ASSERT_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_ERROR, ME, "unexpected cmd %d", gnlh->cmd);
+    struct nlattr* vendorData = s_findVendorData(gnlh);
+    ASSERTS_NOT_NULL(vendorData, SWL_RC_ERROR, ME, "NULL");
+    return s_fillView(vendorData, 0, size, MXL_NL_VENDOR_LEN_EXACT, pView);
+}
+
+/**
+ * @brief Get a view on the vendor data attribute of a vendor event
+ *
+ * @param vendorData NL80211_ATTR_VENDOR_DATA attribute of the event
+ * @param evt vendor event id
+ * @param pView filled with the payload view, pointing into the event message
+ * @return SWL_RC_OK when the payload matches the event policy, <= SWL_RC_ERROR otherwise
+ */
+swl_rc_ne whm_mxl_nlVendor_getEvtView(struct nlattr* vendorData, uint32_t evt, whm_mxl_nlVendorView_t* pView) {
+    ASSERT_NOT_NULL(pView, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(vendorData, SWL_RC_ERROR, ME, "no vendor data for event %u", evt);
+    const whm_mxl_nlVendorPolicy_t* pPolicy = s_findPolicy(sEvtPolicies, SWL_ARRAY_SIZE(sEvtPolicies), evt);
+    ASSERT_NOT_NULL(pPolicy, SWL_RC_INVALID_PARAM, ME, "no policy for event %u", evt);
+    return s_fillView(vendorData, evt, pPolicy->size, pPolicy->check, pView);
+}
@@ -31,7 +31,9 @@
 #include "whm_mxl_utils.h"
 #include "whm_mxl_rad.h"
 #include "whm_mxl_csi.h"
+#include "whm_mxl_chanSurvey.h"
 #include "whm_mxl_monitor.h"
+#include "whm_mxl_parser.h"
 #include <vendor_cmds_copy.h>
 
 #define ME "mxlPars"
@@ -44,13 +46,10 @@ const char* s_reqToStr(uint8_t reqType) {
     }
 }
 
-swl_rc_ne mxl_parseNaStaStats(T_Radio* pRad, struct nlattr* tb[], uint8_t reqType, bool syncDm) {
+swl_rc_ne mxl_parseNaStaStats(T_Radio* pRad, const whm_mxl_nlVendorView_t* pView, uint8_t reqType, bool syncDm) {
     ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
-    ASSERT_NOT_NULL(tb, SWL_RC_INVALID_PARAM, ME, "NULL");
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    struct intel_vendor_unconnected_sta* nasta = (struct intel_vendor_unconnected_sta*) data;
+    ASSERT_NOT_NULL(pView, SWL_RC_INVALID_PARAM, ME, "NULL");
+    const struct intel_vendor_unconnected_sta* nasta = WHM_MXL_NL_VENDOR_VIEW(pView, struct intel_vendor_unconnected_sta);
     ASSERT_NOT_NULL(nasta, SWL_RC_ERROR, ME, "NULL");
 
     swl_macChar_t nastaMacStr = SWL_MAC_CHAR_NEW();
@@ -83,34 +82,41 @@ swl_rc_ne mxl_parseNaStaStats(T_Radio* pRad, struct nlattr* tb[], uint8_t reqTyp
 
     mxl_nastaEntryData_t* pEntry = whm_mxl_monitor_fetchRunNaStaEntry(pRad, (swl_macBin_t*) nasta->addr);
     if(pEntry) {
-        SAH_TRACEZ_INFO(ME, "del executed runNaSta entry %s", nastaMacStr.cMac);
-        whm_mxl_monitor_delRunNaStaEntry(pEntry);
+        SAH_TRACEZ_INFO(ME, "completed runNaSta entry %s", nastaMacStr.cMac);
+        whm_mxl_monitor_completeRunNaStaEntry(pEntry, (bestRssi != -200));
     }
 
     return SWL_RC_OK;
 }
 
-swl_rc_ne mxl_parseChanDataEvt(T_Radio* pRad, struct nlattr* tb[]) {
+swl_rc_ne mxl_parseChanDataEvt(T_Radio* pRad, const whm_mxl_nlVendorView_t* pView) {
     ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
-    ASSERT_NOT_NULL(tb, SWL_RC_INVALID_PARAM, ME, "NULL");
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    struct intel_vendor_channel_data* chanData = (struct intel_vendor_channel_data*) data;
+    ASSERT_NOT_NULL(pView, SWL_RC_INVALID_PARAM, ME, "NULL");
+    const struct intel_vendor_channel_data* chanData = WHM_MXL_NL_VENDOR_VIEW(pView, struct intel_vendor_channel_data);
     ASSERT_NOT_NULL(chanData, SWL_RC_ERROR, ME, "NULL");
-    SAH_TRACEZ_INFO(ME, "%s: chan %d , freq %d MHz", pRad->Name, chanData->channel, chanData->freq);
+    SAH_TRACEZ_INFO(ME, "%s: chan %d , freq %d MHz load %d noise %d cwi %d bss %d", pRad->Name, chanData->channel, chanData->freq,
+                    chanData->load, chanData->noise_floor, chanData->cwi_noise, chanData->num_bss);
+    ASSERT_TRUE(chanData->channel > 0, SWL_RC_ERROR, ME, "%s: invalid chan %d", pRad->Name, chanData->channel);
+
+    whm_mxl_chanSurveySample_t sample = {
+        .channel = chanData->channel,
+        .freq = chanData->freq,
+        .bandwidth = chanData->BW,
+        .load = chanData->load,
+        .noise = chanData->noise_floor,
+        .interference = chanData->cwi_noise,
+        .nrBss = chanData->num_bss,
+    };
+    whm_mxl_chanSurvey_addSample(pRad, &sample);
     return SWL_RC_OK;
 }
 
-swl_rc_ne mxl_parseCsiStatsEvt(T_Radio* pRad, struct nlattr* tb[]) {
+swl_rc_ne mxl_parseCsiStatsEvt(T_Radio* pRad, const whm_mxl_nlVendorView_t* pView) {
     ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
-    ASSERT_NOT_NULL(tb, SWL_RC_INVALID_PARAM, ME, "NULL");
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    wifi_csi_driver_nl_event_data_t* csiStats = (wifi_csi_driver_nl_event_data_t*) data;
+    ASSERT_NOT_NULL(pView, SWL_RC_INVALID_PARAM, ME, "NULL");
+    const wifi_csi_driver_nl_event_data_t* csiStats = WHM_MXL_NL_VENDOR_VIEW(pView, wifi_csi_driver_nl_event_data_t);
     ASSERT_NOT_NULL(csiStats, SWL_RC_ERROR, ME, "NULL");
-    mxl_rad_sendCsiStatsOverUnixSocket(csiStats);
+    mxl_rad_sendCsiStatsOverUnixSocket(pRad, csiStats);
     return SWL_RC_OK;
 }
 
@@ -0,0 +1,114 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : whm_mxl_perf.c                                        *
+*         Description  : Cost instrumentation of stats polls and reconf cycles *
+*                                                                              *
+*  *****************************************************************************/
+
+#include "swl/swl_common.h"
+
+#include "whm_mxl_perf.h"
+#include "whm_mxl_rad.h"
+
+#define ME "mxlPerf"
+
+static const char* s_probeNames[MXL_PERF_MAX] = {"RadioStats", "StationStats", "ReconfCycle"};
+
+static whm_mxl_perf_t* s_getPerf(T_Radio* pRad) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, NULL, ME, "NULL");
+    return &pRadVendor->perf;
+}
+
+void whm_mxl_perf_start(T_Radio* pRad, whm_mxl_perfProbe_e probe) {
+    whm_mxl_perf_t* pPerf = s_getPerf(pRad);
+    ASSERTS_NOT_NULL(pPerf, , ME, "NULL");
+    ASSERTS_TRUE(probe < MXL_PERF_MAX, , ME, "invalid probe %d", probe);
+    whm_mxl_perfRun_t* pRun = &pPerf->run[probe];
+    swl_timespec_getMono(&pRun->startTs);
+    pRun->nrRoundTrips = 0;
+    pRun->nrItems = 0;
+    pRun->running = true;
+}
+
+void whm_mxl_perf_addRoundTrips(T_Radio* pRad, whm_mxl_perfProbe_e probe, uint32_t nrRoundTrips) {
+    whm_mxl_perf_t* pPerf = s_getPerf(pRad);
+    ASSERTS_NOT_NULL(pPerf, , ME, "NULL");
+    ASSERTS_TRUE(probe < MXL_PERF_MAX, , ME, "invalid probe %d", probe);
+    ASSERTS_TRUE(pPerf->run[probe].running, , ME, "probe %s not running", s_probeNames[probe]);
+    pPerf->run[probe].nrRoundTrips += nrRoundTrips;
+}
+
+void whm_mxl_perf_addItems(T_Radio* pRad, whm_mxl_perfProbe_e probe, uint32_t nrItems) {
+    whm_mxl_perf_t* pPerf = s_getPerf(pRad);
+    ASSERTS_NOT_NULL(pPerf, , ME, "NULL");
+    ASSERTS_TRUE(probe < MXL_PERF_MAX, , ME, "invalid probe %d", probe);
+    ASSERTS_TRUE(pPerf->run[probe].running, , ME, "probe %s not running", s_probeNames[probe]);
+    pPerf->run[probe].nrItems += nrItems;
+}
+
+/* Record a run measured outside of the per radio run slots, e.g. by an async round */
+void whm_mxl_perf_record(T_Radio* pRad, whm_mxl_perfProbe_e probe, whm_mxl_perfRun_t* pRun) {
+    ASSERTS_NOT_NULL(pRun, , ME, "NULL");
+    whm_mxl_perf_t* pPerf = s_getPerf(pRad);
+    ASSERTS_NOT_NULL(pPerf, , ME, "NULL");
+    ASSERTS_TRUE(probe < MXL_PERF_MAX, , ME, "invalid probe %d", probe);
+    ASSERTS_TRUE(pRun->running, , ME, "probe %s not running", s_probeNames[probe]);
+    whm_mxl_perfStats_t* pStats = &pPerf->stats[probe];
+
+    swl_timeSpecMono_t now;
+    swl_timeSpecMono_t diffTs;
+    swl_timespec_getMono(&now);
+    swl_timespec_diff(&diffTs, &pRun->startTs, &now);
+    uint32_t elapsedUs = (uint32_t) ((uint64_t) diffTs.tv_sec * 1000000 + diffTs.tv_nsec / 1000);
+
+    pStats->nrRuns++;
+    pStats->totalUs += elapsedUs;
+    pStats->lastUs = elapsedUs;
+    pStats->maxUs = SWL_MAX(pStats->maxUs, elapsedUs);
+    pStats->totalRoundTrips += pRun->nrRoundTrips;
+    pStats->lastRoundTrips = pRun->nrRoundTrips;
+    pStats->lastNrItems = pRun->nrItems;
+    pRun->running = false;
+
+    SAH_TRACEZ_INFO(ME, "%s: %s took %u us, %u round trips, %u items", pRad->Name, s_probeNames[probe],
+                    elapsedUs, pRun->nrRoundTrips, pRun->nrItems);
+}
+
+void whm_mxl_perf_stop(T_Radio* pRad, whm_mxl_perfProbe_e probe) {
+    whm_mxl_perf_t* pPerf = s_getPerf(pRad);
+    ASSERTS_NOT_NULL(pPerf, , ME, "NULL");
+    ASSERTS_TRUE(probe < MXL_PERF_MAX, , ME, "invalid probe %d", probe);
+    whm_mxl_perf_record(pRad, probe, &pPerf->run[probe]);
+}
+
+void whm_mxl_perf_reset(T_Radio* pRad) {
+    whm_mxl_perf_t* pPerf = s_getPerf(pRad);
+    ASSERTS_NOT_NULL(pPerf, , ME, "NULL");
+    memset(pPerf->stats, 0, sizeof(pPerf->stats));
+}
+
+void whm_mxl_perf_toVar(T_Radio* pRad, amxc_var_t* pMap) {
+    ASSERTS_NOT_NULL(pMap, , ME, "NULL");
+    whm_mxl_perf_t* pPerf = s_getPerf(pRad);
+    ASSERTS_NOT_NULL(pPerf, , ME, "NULL");
+    for(uint32_t i = 0; i < MXL_PERF_MAX; i++) {
+        whm_mxl_perfStats_t* pStats = &pPerf->stats[i];
+        amxc_var_t* pProbeMap = amxc_var_add_key(amxc_htable_t, pMap, s_probeNames[i], NULL);
+        amxc_var_add_key(uint64_t, pProbeMap, "Runs", pStats->nrRuns);
+        amxc_var_add_key(uint32_t, pProbeMap, "LastTimeUs", pStats->lastUs);
+        amxc_var_add_key(uint32_t, pProbeMap, "MaxTimeUs", pStats->maxUs);
+        amxc_var_add_key(uint64_t, pProbeMap, "AvgTimeUs", pStats->nrRuns ? (pStats->totalUs / pStats->nrRuns) : 0);
+        amxc_var_add_key(uint32_t, pProbeMap, "LastRoundTrips", pStats->lastRoundTrips);
+        amxc_var_add_key(uint64_t, pProbeMap, "AvgRoundTrips", pStats->nrRuns ? (pStats->totalRoundTrips / pStats->nrRuns) : 0);
+        amxc_var_add_key(uint32_t, pProbeMap, "LastItems", pStats->lastNrItems);
+    }
+}
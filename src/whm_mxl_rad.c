@@ -39,6 +39,7 @@
 #include "whm_mxl_vap.h"
 #include "whm_mxl_wmm.h"
 #include "whm_mxl_reconfMngr.h"
+#include "whm_mxl_nlVendor.h"
 
 #include <vendor_cmds_copy.h>
 
@@ -126,6 +127,7 @@ static void s_vapStatusCb(wld_vap_status_change_event_t* event) {
     ASSERT_NOT_NULL(pRad, , ME, "NULL");
 
     if ((pAP->status == APSTI_ENABLED) && (pSSID->status == RST_UP)) {
+        whm_mxl_module_markRadioUp(pRad);
         whm_mxl_vap_postUpActions(pAP);
     } else if (pSSID->status == RST_DOWN) {
         whm_mxl_vap_postDownActions(pAP);
@@ -147,6 +149,9 @@ int whm_mxl_rad_createHook(T_Radio* pRad) {
     s_mxl_rad_init_vendordata(pRad);
 
     whm_mxl_reconfMngr_init(pRad);
+    whm_mxl_pendingActions_init(pRad);
+    whm_mxl_vendorQueue_init(pRad);
+    whm_mxl_chanSurvey_init(pRad);
 
     // set vendor events handler
     SAH_TRACEZ_INFO(ME, "%s: Set vendor event handler", pRad->Name);
@@ -209,13 +214,24 @@ static void s_deinitRadVendorData(T_Radio* pRad) {
         free(vendorData->acs_exclusion_ch_list);
     }
 #endif /* CONFIG_VENDOR_MXL_PROPRIETARY */
+    whm_mxl_rad_cleanupVendorCfg(pRad);
+    whm_mxl_hapdConf_cleanup(pRad);
     free(vendorData);
 }
 
 void whm_mxl_rad_destroyHook(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    if((pRadVendor != NULL) && (pRadVendor->pStatsRound != NULL)) {
+        /* pending replies still release the round, which then frees itself */
+        pRadVendor->pStatsRound->pRad = NULL;
+        pRadVendor->pStatsRound = NULL;
+    }
     wld_event_remove_callback(gWld_queue_vap_onStatusChange, &s_vapStatusEventCb);
     whm_mxl_unregisterToWdsEvent();
+    /* pending vendor requests complete with an error, releasing their stats round */
+    whm_mxl_vendorQueue_deinit(pRad);
+    whm_mxl_pendingActions_deinit(pRad);
     whm_mxl_reconfMngr_deinit(pRad);
     whm_mxl_rad_delVap_timer_deinit(pRad);
     whm_mxl_monitor_deinit(pRad);
@@ -223,34 +239,8 @@ void whm_mxl_rad_destroyHook(T_Radio* pRad) {
     CALL_NL80211_FTA(mfn_wrad_destroy_hook, pRad);
 }
 
-static swl_rc_ne s_getVAPStatsCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
-    ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "Request error");
-    ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
-    struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
-    ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
-
-    T_Stats* stats = (T_Stats*) priv;
-    ASSERT_NOT_NULL(stats, SWL_RC_ERROR, ME, "NULL");
-
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
-
-    // parse data table
-    void* data = NULL;
-    size_t len;
-    mtlk_wssa_drv_tr181_wlan_stats_t *drvStats;
-
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    len = nla_len(tb[NL80211_ATTR_VENDOR_DATA]);
-    ASSERT_EQUALS(sizeof(*drvStats), len, SWL_RC_ERROR, ME, "Wrong data size %zu received, expected %zu", len, sizeof(*drvStats));
-
-    drvStats = data;
-    ASSERT_NOT_NULL(drvStats, SWL_RC_ERROR, ME, "NULL");
-
+/* Add the traffic counters of one AP to the radio stats */
+static void s_addTr181WlanStats(T_Stats* stats, const mtlk_wssa_drv_tr181_wlan_stats_t* drvStats) {
     stats->BytesSent                   += drvStats->traffic_stats.BytesSent;
     stats->BytesReceived               += drvStats->traffic_stats.BytesReceived;
     stats->PacketsSent                 += drvStats->traffic_stats.PacketsSent;
@@ -270,8 +260,6 @@ static swl_rc_ne s_getVAPStatsCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv)
     stats->FailedRetransCount          += drvStats->retrans_stats.FailedRetransCount;
     stats->RetryCount                  += drvStats->retrans_stats.RetryCount;
     stats->MultipleRetryCount          += drvStats->retrans_stats.MultipleRetryCount;
-
-    return rc;
 }
 
 struct cbData_t {
@@ -295,22 +283,11 @@ static swl_rc_ne s_getDataCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
     struct cbData_t *getData = priv;
     ASSERT_NOT_NULL(getData, SWL_RC_ERROR, ME, "NULL");
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
-
-    void* data = NULL;
-    size_t len = 0;
+    whm_mxl_nlVendorView_t view;
+    swl_rc_ne ret = whm_mxl_nlVendor_getSizedReplyView(nlh, getData->size, &view);
+    ASSERT_EQUALS(ret, SWL_RC_OK, ret, ME, "fail to decode vendor data");
 
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    len = nla_len(tb[NL80211_ATTR_VENDOR_DATA]);
-    ASSERT_EQUALS(getData->size, len, SWL_RC_ERROR, ME, "Wrong data size %zu received, expected %zu", len, getData->size);
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    ASSERT_NOT_NULL(data, SWL_RC_ERROR, ME, "NULL");
-
-    memcpy(getData->data, data, len);
+    memcpy(getData->data, view.data, view.len);
     return rc;
 }
 
@@ -330,43 +307,177 @@ static swl_rc_ne s_getBgScanParams(swl_rc_ne rc, struct nlmsghdr* nlh, void* pri
     mxl_bgScanParams_t* pBgScanParams = (mxl_bgScanParams_t*) priv;
     ASSERT_NOT_NULL(pBgScanParams, SWL_RC_ERROR, ME, "pBgScanParams is NULL");
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
+    whm_mxl_nlVendorView_t view;
+    swl_rc_ne ret = whm_mxl_nlVendor_getReplyView(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_SCAN_PARAMS_BG, &view);
+    ASSERT_EQUALS(ret, SWL_RC_OK, ret, ME, "fail to decode bg scan params");
+
+    memcpy(pBgScanParams, view.data, view.len);
+
+    return rc;
+}
+
+typedef enum {
+    MXL_RAD_STATS_REQ_VAP,          /* GET_TR181_WLAN_STATS of one AP */
+    MXL_RAD_STATS_REQ_TEMPERATURE,  /* GET_TEMPERATURE_SENSOR of the radio */
+} whm_mxl_radStatsReqType_e;
+
+typedef struct {
+    whm_mxl_radStatsRound_t* pRound;
+    whm_mxl_radStatsReqType_e type;
+    bool done;
+} whm_mxl_radStatsReq_t;
+
+struct whm_mxl_radStatsRound {
+    T_Radio* pRad;              /* NULL when the radio is gone or the round was abandoned */
+    swl_timeMono_t startSec;    /* monotonic start time */
+    T_Stats stats;              /* replies aggregated so far */
+    int32_t temperature;
+    bool temperatureValid;
+    amxp_timer_t* noiseTimer;   /* noise step, run from the event loop once the round is issued */
+    int32_t noise;
+    bool noiseValid;
+    uint32_t nrPending;         /* pending replies, plus one ref held while issuing */
+    uint32_t nrFailed;
+    uint32_t nrReqs;
+    whm_mxl_radStatsReq_t reqs[];
+};
+
+/* A round older than this is abandoned and a new burst is issued */
+#define MXL_RAD_STATS_ROUND_TIMEOUT_SEC 5
+
+static void s_completeRadStatsRound(whm_mxl_radStatsRound_t* pRound) {
+    T_Radio* pRad = pRound->pRad;
+    mxl_VendorData_t* pRadVendor = (pRad != NULL) ? mxl_rad_getVendorData(pRad) : NULL;
+    if(pRadVendor != NULL) {
+        pRadVendor->pStatsRound = NULL;
+        /* WMM counters come from one debugfs snapshot shared by all APs */
+        amxc_llist_for_each(it, &pRad->llAP) {
+            T_AccessPoint* pAP = (T_AccessPoint*) amxc_llist_it_get_data(it, T_AccessPoint, it);
+            if((pAP->index <= 0) || !mxl_isApReadyToProcessVendorCmd(pAP)) {
+                continue;
+            }
+            if(mxl_getWmmStats(pAP, &pRound->stats, true) < SWL_RC_OK) {
+                SAH_TRACEZ_ERROR(ME, "%s: Get WMM stats failed", pAP->alias);
+            }
+        }
+        /* keep the previous values of what this round failed to read */
+        pRound->stats.noise = pRound->noiseValid ? pRound->noise : pRad->stats.noise;
+        pRound->stats.TemperatureDegreesCelsius = pRound->temperatureValid ?
+            pRound->temperature : pRad->stats.TemperatureDegreesCelsius;
+        pRad->stats = pRound->stats; /* struct copy */
+        wld_util_stats2Obj(amxd_object_get(pRad->pBus, "Stats"), &pRad->stats);
+        pRadVendor->statsRoundRc = ((pRound->nrReqs > 0) && (pRound->nrFailed >= pRound->nrReqs)) ? SWL_RC_ERROR : SWL_RC_OK;
+        whm_mxl_perf_stop(pRad, MXL_PERF_RAD_STATS);
+        SAH_TRACEZ_INFO(ME, "%s: stats round done, %u requests, %u failed", pRad->Name, pRound->nrReqs, pRound->nrFailed);
     }
+    amxp_timer_delete(&pRound->noiseTimer);
+    free(pRound);
+}
 
-    // parse data
-    void* data = NULL;
-    size_t len;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    ASSERT_NOT_NULL(data, SWL_RC_ERROR, ME, "data is NULL");
-    len = nla_len(tb[NL80211_ATTR_VENDOR_DATA]);
-    ASSERT_EQUALS(sizeof(*pBgScanParams), len, SWL_RC_ERROR, ME, "Wrong data size %zu received, expected %zu", len, sizeof(*pBgScanParams));
+static void s_releaseRadStatsRound(whm_mxl_radStatsRound_t* pRound, bool failed) {
+    if(failed) {
+        pRound->nrFailed++;
+    }
+    if(--pRound->nrPending == 0) {
+        s_completeRadStatsRound(pRound);
+    }
+}
 
-    memcpy(pBgScanParams, data, len);
+/* Completion of one request of the stats burst, with the driver data or the queue error / timeout */
+static void s_radStatsReqDone(swl_rc_ne rc, const whm_mxl_nlVendorView_t* pView, void* userData) {
+    whm_mxl_radStatsReq_t* pReq = (whm_mxl_radStatsReq_t*) userData;
+    ASSERT_NOT_NULL(pReq, , ME, "NULL");
+    ASSERTS_FALSE(pReq->done, , ME, "request already done");
+    whm_mxl_radStatsRound_t* pRound = pReq->pRound;
+    bool ok = (rc >= SWL_RC_OK) && (pView != NULL);
+    if(ok) {
+        if(pReq->type == MXL_RAD_STATS_REQ_VAP) {
+            s_addTr181WlanStats(&pRound->stats, WHM_MXL_NL_VENDOR_VIEW(pView, mtlk_wssa_drv_tr181_wlan_stats_t));
+        } else {
+            memcpy(&pRound->temperature, pView->data, sizeof(pRound->temperature));
+            pRound->temperatureValid = true;
+        }
+    }
+    pReq->done = true;
+    s_releaseRadStatsRound(pRound, !ok);
+}
 
-    return rc;
+/*
+ * Noise step of the stats burst: the generic nl80211 survey has no async variant,
+ * so it is read from the event loop after the poll returned, not by the poll itself
+ */
+static void s_radStatsNoise_th(amxp_timer_t* timer _UNUSED, void* priv) {
+    whm_mxl_radStatsRound_t* pRound = (whm_mxl_radStatsRound_t*) priv;
+    ASSERT_NOT_NULL(pRound, , ME, "NULL");
+    if(pRound->pRad != NULL) {
+        pRound->noiseValid = (wld_rad_getCurrentNoise(pRound->pRad, &pRound->noise) >= SWL_RC_OK);
+        if(!pRound->noiseValid) {
+            SAH_TRACEZ_ERROR(ME, "%s: wld_rad_getCurrentNoise failed", pRound->pRad->Name);
+        }
+    }
+    s_releaseRadStatsRound(pRound, false);
 }
 
-static swl_rc_ne s_getRadCurrentTemp(T_Radio* pRad, int32_t* pTemp)
-{
-    swl_rc_ne rc;
-    struct cbData_t getData;
-    getData.size = sizeof(*pTemp);
-    getData.data = pTemp;
-    rc = wld_rad_nl80211_sendVendorSubCmd(pRad, OUI_MXL, LTQ_NL80211_VENDOR_SUBCMD_GET_TEMPERATURE_SENSOR, NULL, 0,
-                                          VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_getDataCb, &getData);
+static void s_startRadStatsNoise(whm_mxl_radStatsRound_t* pRound, T_Radio* pRad) {
+    pRound->nrPending++;
+    if((amxp_timer_new(&pRound->noiseTimer, s_radStatsNoise_th, pRound) != 0) ||
+       (amxp_timer_start(pRound->noiseTimer, 0) != 0)) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to schedule noise read", pRad->Name);
+        s_releaseRadStatsRound(pRound, false);
+    }
+}
 
-    return rc;
+static void s_sendRadStatsReq(whm_mxl_radStatsRound_t* pRound, T_Radio* pRad, T_AccessPoint* pAP) {
+    whm_mxl_radStatsReq_t* pReq = &pRound->reqs[pRound->nrReqs++];
+    pReq->pRound = pRound;
+    pReq->type = (pAP != NULL) ? MXL_RAD_STATS_REQ_VAP : MXL_RAD_STATS_REQ_TEMPERATURE;
+    pRound->nrPending++;
+    whm_mxl_vendorReqArgs_t args = {
+        .pAP = pAP,
+        .subcmd = (pAP != NULL) ? LTQ_NL80211_VENDOR_SUBCMD_GET_TR181_WLAN_STATS : LTQ_NL80211_VENDOR_SUBCMD_GET_TEMPERATURE_SENSOR,
+        .expectReply = true,
+        .replySize = (pAP != NULL) ? 0 : sizeof(pRound->temperature),
+        .doneCb = s_radStatsReqDone,
+        .userData = pReq,
+    };
+    if(whm_mxl_vendorQueue_send(pRad, &args, NULL) < SWL_RC_OK) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to queue stats request (type %d)", (pAP != NULL) ? pAP->alias : pRad->Name, pReq->type);
+        pReq->done = true;
+        s_releaseRadStatsRound(pRound, true);
+    }
 }
 
+/*
+ * Radio stats are collected with one burst of async driver requests (per AP traffic stats
+ * and radio temperature) sent through the radio vendor queue, plus a deferred noise read.
+ * When the last step completes, the result is aggregated into pRad->stats and
+ * written to the Radio.Stats object, so a burst costs the latency of the slowest reply
+ * instead of the sum of all of them, and the poll itself never waits on the driver.
+ * An error is returned when the last completed burst got no reply at all.
+ */
 int whm_mxl_rad_stats(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRad, WLD_ERROR_INVALID_PARAM, ME, "NULL");
-    swl_rc_ne rc;
-    T_Stats stats = {0};
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, WLD_ERROR_INVALID_PARAM, ME, "pRadVendor is NULL");
+
+    if(pRadVendor->pStatsRound != NULL) {
+        uint32_t elapsed = swl_time_getMonoSec() - pRadVendor->pStatsRound->startSec;
+        ASSERTI_TRUE(elapsed >= MXL_RAD_STATS_ROUND_TIMEOUT_SEC, pRadVendor->statsRoundRc, ME, "%s: stats round in progress", pRad->Name);
+        SAH_TRACEZ_WARNING(ME, "%s: abandon stats round after %us", pRad->Name, elapsed);
+        /* late replies still release the round, which then frees itself */
+        pRadVendor->pStatsRound->pRad = NULL;
+        pRadVendor->pStatsRound = NULL;
+    }
+
+    uint32_t maxReqs = amxc_llist_size(&pRad->llAP) + 1;
+    whm_mxl_radStatsRound_t* pRound = calloc(1, sizeof(whm_mxl_radStatsRound_t) + maxReqs * sizeof(whm_mxl_radStatsReq_t));
+    ASSERT_NOT_NULL(pRound, SWL_RC_ERROR, ME, "%s: fail to allocate stats round", pRad->Name);
+    pRound->pRad = pRad;
+    pRound->startSec = swl_time_getMonoSec();
+    pRound->nrPending = 1;
+    pRadVendor->pStatsRound = pRound;
 
+    whm_mxl_perf_start(pRad, MXL_PERF_RAD_STATS);
     amxc_llist_for_each(it, &pRad->llAP) {
         T_AccessPoint* pAP = (T_AccessPoint*) amxc_llist_it_get_data(it, T_AccessPoint, it);
 
@@ -374,22 +485,17 @@ int whm_mxl_rad_stats(T_Radio* pRad) {
         if ((pAP->index <= 0) || !mxl_isApReadyToProcessVendorCmd(pAP))
             continue;
 
-        rc = wld_ap_nl80211_sendVendorSubCmd(pAP, OUI_MXL, LTQ_NL80211_VENDOR_SUBCMD_GET_TR181_WLAN_STATS, NULL, 0,
-                                             VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_getVAPStatsCb, &stats);
-        ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: GET_TR181_WLAN_STATS failed", pAP->alias);
-        rc = mxl_getWmmStats(pAP, &stats, true);
-        ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: Get WMM stats failed", pAP->alias);
+        whm_mxl_perf_addItems(pRad, MXL_PERF_RAD_STATS, 1);
+        s_sendRadStatsReq(pRound, pRad, pAP);
     }
+    s_sendRadStatsReq(pRound, pRad, NULL);
+    s_startRadStatsNoise(pRound, pRad);
+    whm_mxl_perf_addRoundTrips(pRad, MXL_PERF_RAD_STATS, pRound->nrReqs + 1);
 
-    pRad->stats = stats; /* struct copy */
-    rc = wld_rad_getCurrentNoise(pRad, &pRad->stats.noise);
-    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: wld_rad_getCurrentNoise failed", pRad->Name);
-    rc = s_getRadCurrentTemp(pRad, &pRad->stats.TemperatureDegreesCelsius);
-    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: s_mxl_rad_getCurrentTemp failed", pRad->Name);
-
-    /* TODO: fill WMM counters */
-
-    return rc;
+    /* drop the issuing reference: the round completes with its last pending step */
+    s_releaseRadStatsRound(pRound, false);
+    ASSERT_FALSE(pRadVendor->statsRoundRc < SWL_RC_OK, pRadVendor->statsRoundRc, ME, "%s: no reply to the last stats round", pRad->Name);
+    return SWL_RC_OK;
 }
 
 /**
@@ -1075,6 +1181,13 @@ amxd_status_t _whm_mxl_rad_debug(amxd_object_t* object,
     } else if (swl_str_matches(feature, "CommitReconfFsm")) {
         whm_mxl_reconfMngr_doCommit(pRad);
         amxc_var_add_key(cstring_t, retval, "Status", "executed command");
+    } else if (swl_str_matches(feature, "PerfStats")) {
+        whm_mxl_perf_toVar(pRad, retval);
+    } else if (swl_str_matches(feature, "PerfReset")) {
+        whm_mxl_perf_reset(pRad);
+        amxc_var_add_key(cstring_t, retval, "Status", "executed command");
+    } else if (swl_str_matches(feature, "WpaCtrlHealth")) {
+        whm_mxl_wpaCtrlHealth_toVar(pRad, retval);
     } else {
         //help display
         amxc_var_add_key(cstring_t, retval, "help", "Please add argument 'op', with one of following debug operations:");
@@ -1082,6 +1195,9 @@ amxd_status_t _whm_mxl_rad_debug(amxd_object_t* object,
         amxc_var_add_key(cstring_t, opMap, "StaScanTime", "To trigger a LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA_SCAN_TIME subcmd");
         amxc_var_add_key(cstring_t, opMap, "NaStaMon", "To trigger LTQ_NL80211_VENDOR_SUBCMD_GET_UNCONNECTED_STA subcmd");
         amxc_var_add_key(cstring_t, opMap, "CommitReconfFsm", "To trigger a dummy commit to the Reconf FSM");
+        amxc_var_add_key(cstring_t, opMap, "PerfStats", "To get time and round trips of the radio stats, station stats and reconf cycles");
+        amxc_var_add_key(cstring_t, opMap, "PerfReset", "To reset the PerfStats counters");
+        amxc_var_add_key(cstring_t, opMap, "WpaCtrlHealth", "To get the wpa ctrl socket health and reconnection counters of each VAP");
     }
 
     return amxd_status_ok;
@@ -1311,6 +1427,7 @@ SWLA_DM_HDLRS(sRadVendorDmHdlrs,
 void _whm_mxl_rad_setVendorObj_ocf(const char* const sig_name,
                             const amxc_var_t* const data,
                             void* const priv) {                          
+    whm_mxl_rad_invalidateVendorCfgFromSignal(data, MXL_RAD_CFG_SECTION_MAIN);
     swla_dm_procObjEvtOfLocalDm(&sRadVendorDmHdlrs, sig_name, data, priv);
 }
 
@@ -1397,6 +1514,7 @@ SWLA_DM_HDLRS(sAcsConfigDmHdlrs, ARR(), .objChangedCb = s_setAcsConfig_ocf);
 void _whm_mxl_rad_setAcsConf_ocf(const char* const sig_name,
                                   const amxc_var_t* const data,
                                   void* const priv) {
+    whm_mxl_rad_invalidateVendorCfgFromSignal(data, MXL_RAD_CFG_SECTION_ACS);
     swla_dm_procObjEvtOfLocalDm(&sAcsConfigDmHdlrs, sig_name, data, priv);
 }
 #else
@@ -1452,6 +1570,7 @@ SWLA_DM_HDLRS(sAfcConfigDmHdlrs, ARR(), .objChangedCb = s_setAfcConfig_ocf);
 void _whm_mxl_rad_setAfcConf_ocf(const char* const sig_name,
                                   const amxc_var_t* const data,
                                   void* const priv) {
+    whm_mxl_rad_invalidateVendorCfgFromSignal(data, MXL_RAD_CFG_SECTION_AFC);
     swla_dm_procObjEvtOfLocalDm(&sAfcConfigDmHdlrs, sig_name, data, priv);
 }
 
@@ -1575,6 +1694,7 @@ SWLA_DM_HDLRS(sBssColorDmHdlrs, ARR(), .objChangedCb = s_setBssColor_ocf);
 void _whm_mxl_rad_setBssColor_ocf(const char* const sig_name,
                                   const amxc_var_t* const data,
                                   void* const priv) {
+    whm_mxl_rad_invalidateVendorCfgFromSignal(data, MXL_RAD_CFG_SECTION_BSS_COLOR);
     swla_dm_procObjEvtOfLocalDm(&sBssColorDmHdlrs, sig_name, data, priv);
 }
 
@@ -1613,6 +1733,7 @@ SWLA_DM_HDLRS(sDelayedStartDmHdlrs, ARR(), .objChangedCb = s_setDelayedStartConf
 void _whm_mxl_rad_setDelayedStartConf_ocf(const char* const sig_name,
                                         const amxc_var_t* const data,
                                         void* const priv) {
+    whm_mxl_rad_invalidateVendorCfgFromSignal(data, MXL_RAD_CFG_SECTION_DELAYED_START);
     swla_dm_procObjEvtOfLocalDm(&sDelayedStartDmHdlrs, sig_name, data, priv);
 }
 
@@ -1887,6 +2008,7 @@ SWLA_DM_HDLRS(sObssScanConfigDmHdlrs, ARR(), .objChangedCb = s_mxl_setObssScanCo
 void _whm_mxl_rad_setObssScanParams_ocf(const char* const sig_name,
                                         const amxc_var_t* const data,
                                         void* const priv) {
+    whm_mxl_rad_invalidateVendorCfgFromSignal(data, MXL_RAD_CFG_SECTION_OBSS);
     swla_dm_procObjEvtOfLocalDm(&sObssScanConfigDmHdlrs, sig_name, data, priv);
 }
 
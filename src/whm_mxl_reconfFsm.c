@@ -31,6 +31,17 @@
 /* 30 Second to attempt to lock the radio - (30 Sec = 100ms * 4 * 30) */
 #define NUM_OF_RETRIES_IN_LOCK_INTERVAL_UNITS   (120)
 #define MXL_RECONF_FSM_MAX_LOCK_RETRIES         (NUM_OF_RETRIES_IN_LOCK_INTERVAL_UNITS)
+/* Event driven mode: delay used to resume the FSM from the event loop */
+#define MXL_FSM_EVT_KICK_MS                     (1)
+/* Event driven mode: max FSM steps chained in one timer callback */
+#define MXL_FSM_MAX_CHAINED_STEPS               (256)
+
+/*
+ * In event driven mode, the FSM advances to the next step as soon as the previous one
+ * completed (wpa ctrl reply received), and the timer is only used as timeout for the
+ * steps waiting for a hostapd event.
+ */
+static bool s_eventDriven = true;
 
 const char* s_debug_fsm_state(FSM_STATE state) {
     switch (state) {
@@ -172,6 +183,7 @@ static void s_resetReconfFsm(T_Radio* pRad, mxl_VendorData_t* pRadVendor) {
     }
     pRadVendor->reconfFsm.timeout_msec = 0;
     pRadVendor->reconfFsm.timer = 0;
+    pRadVendor->reconfFsmWaitEvt = false;
 }
 
 static wld_fsmMngr_t* s_getReconfMngr(mxl_VendorData_t* pRadVendor) {
@@ -180,6 +192,42 @@ static wld_fsmMngr_t* s_getReconfMngr(mxl_VendorData_t* pRadVendor) {
     return (wld_fsmMngr_t*)pRadVendor->reconfFsmMngr;
 }
 
+static void s_kickLockWaiters(T_Radio* pRad) {
+    ASSERTS_TRUE(s_eventDriven, , ME, "timer driven");
+    T_Radio* pOtherRad = NULL;
+    wld_for_eachRad(pOtherRad) {
+        mxl_VendorData_t* pOtherRadVendor = mxl_rad_getVendorData(pOtherRad);
+        if((pOtherRad == pRad) || (pOtherRadVendor == NULL) || (pOtherRadVendor->reconfFsm.timer == NULL)) {
+            continue;
+        }
+        if(pOtherRadVendor->reconfFsm.FSM_State == FSM_WAIT) {
+            SAH_TRACEZ_INFO(ME, "%s: lock released by %s - retry lock", pOtherRad->Name, pRad->Name);
+            amxp_timer_start(pOtherRadVendor->reconfFsm.timer, MXL_FSM_EVT_KICK_MS);
+        }
+    }
+}
+
+/*
+ * Run one FSM step, and in event driven mode, directly chain the next steps
+ * as long as they complete synchronously.
+ */
+static void s_runReconfFsm(T_Radio* pRad, mxl_VendorData_t* pRadVendor) {
+    pRadVendor->reconfFsmWaitEvt = false;
+    FSM_STATE prevState = pRadVendor->reconfFsm.FSM_State;
+    FSM_STATE state = whm_mxl_reconf_fsm(pRad);
+    for(uint32_t i = 0; s_eventDriven && (i < MXL_FSM_MAX_CHAINED_STEPS); i++) {
+        if(!pRadVendor->reconfFsm.timer || pRadVendor->reconfFsmWaitEvt) {
+            break;
+        }
+        /* Stay in same state: only RUN makes progress by itself, WAIT needs the lock to be released */
+        if((state == prevState) && (state != FSM_RUN)) {
+            break;
+        }
+        prevState = state;
+        state = whm_mxl_reconf_fsm(pRad);
+    }
+}
+
 static void s_reconf_fsm_th(amxp_timer_t* timer _UNUSED, void* userdata) {
     SAH_TRACEZ_IN(ME);
     T_Radio* pRad = (T_Radio*) userdata;
@@ -187,7 +235,7 @@ static void s_reconf_fsm_th(amxp_timer_t* timer _UNUSED, void* userdata) {
     mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
     ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
 
-    whm_mxl_reconf_fsm(pRad);
+    s_runReconfFsm(pRad, pRadVendor);
 
     if(pRadVendor->reconfFsm.timer && (pRadVendor->reconfFsm.timeout_msec > 0)) {
         SAH_TRACEZ_INFO(ME, "%s: reconf fsm retrigger timer - timeout %d",
@@ -219,10 +267,11 @@ FSM_STATE whm_mxl_reconf_fsm(T_Radio* pRad) {
             }
             if (pRadVendor->reconfFsm.timer) {
                 /* FSM timer is created - start it and move to WAIT state */
-                pRadVendor->reconfFsm.timeout_msec = MXL_FSM_TRY_LOCK_INTERVAL_MS;
+                pRadVendor->reconfFsm.timeout_msec = s_eventDriven ? MXL_FSM_EVT_KICK_MS : MXL_FSM_TRY_LOCK_INTERVAL_MS;
                 amxp_timer_start(pRadVendor->reconfFsm.timer, pRadVendor->reconfFsm.timeout_msec);
                 pRadVendor->reconfFsm.FSM_State = FSM_WAIT;
                 pRadVendor->reconfFsmBriefState = MXL_RECONF_FSM_RUNNING;
+                whm_mxl_perf_start(pRad, MXL_PERF_RECONF_CYCLE);
                 pRadVendor->reconfFsm.FSM_Error = MXL_RECONF_FSM_REQ_OK; // Used as an indication for DEPENDENCY state
                 pRadVendor->reconfFsm.FSM_Retry = MXL_RECONF_FSM_MAX_LOCK_RETRIES; // Used as an indication of try lock attempts
             }
@@ -297,6 +346,7 @@ FSM_STATE whm_mxl_reconf_fsm(T_Radio* pRad) {
                 if (reconfMngr->actionList && reconfMngr->actionList[radExecBit].doRadFsmAction) {
                     SAH_TRACEZ_INFO(ME, "%s: Reconf RAD action RUN bit %u : %s", pRad->Name, radExecBit, reconfMngr->actionList[radExecBit].name);
                     radExecStatus = reconfMngr->actionList[radExecBit].doRadFsmAction(pRad);
+                    whm_mxl_perf_addItems(pRad, MXL_PERF_RECONF_CYCLE, 1);
                 }
 
                 if (!radExecStatus) {
@@ -319,6 +369,7 @@ FSM_STATE whm_mxl_reconf_fsm(T_Radio* pRad) {
                         if (reconfMngr->actionList && reconfMngr->actionList[vapExecBit].doVapFsmAction) {
                             SAH_TRACEZ_INFO(ME, "%s: Reconf VAP action RUN bit %u : %s", pAP->alias, vapExecBit, reconfMngr->actionList[vapExecBit].name);
                             vapExecStatus = reconfMngr->actionList[vapExecBit].doVapFsmAction(pAP, pRad);
+                            whm_mxl_perf_addItems(pRad, MXL_PERF_RECONF_CYCLE, 1);
                         }
                         if (!vapExecStatus) {
                             SAH_TRACEZ_NOTICE(ME, "%s: Failed bit %u in RUN state", pAP->alias, vapExecBit);
@@ -339,14 +390,19 @@ FSM_STATE whm_mxl_reconf_fsm(T_Radio* pRad) {
         }
         case FSM_COMPEND: {
             if (s_anyCommitsPending(pRad, pRadVendor)) {
-                /* Need to work on more commits - go to DEPENDENCY - we still have lock */
-                pRadVendor->reconfFsm.FSM_State = FSM_DEPENDENCY;
-                break;
+                /* Need to work on more commits - go to DEPENDENCY if the lock we have covers them */
+                if (reconfMngr->doLock(pRad)) {
+                    pRadVendor->reconfFsm.FSM_State = FSM_DEPENDENCY;
+                    break;
+                }
+                /* Pending commits need a wider lock - release ours and wait for it from FINISH */
+                SAH_TRACEZ_INFO(ME, "%s: pending commits require cross radio lock", pRad->Name);
             }
             /* No pending commits - unlock FSM and go to finish */
             pRadVendor->reconfFsm.timeout_msec = 100; // speed up the finish
             pRadVendor->reconfFsm.FSM_State = FSM_FINISH;
             reconfMngr->doUnlock(pRad);
+            s_kickLockWaiters(pRad);
             break;
         }
         case FSM_FINISH: {
@@ -365,6 +421,7 @@ FSM_STATE whm_mxl_reconf_fsm(T_Radio* pRad) {
             pRadVendor->reconfFsm.timer = 0;
 
             pRadVendor->reconfFsmBriefState = MXL_RECONF_FSM_IDLE;
+            whm_mxl_perf_stop(pRad, MXL_PERF_RECONF_CYCLE);
             break;
         }
         case FSM_ERROR: {
@@ -372,6 +429,8 @@ FSM_STATE whm_mxl_reconf_fsm(T_Radio* pRad) {
             reconfMngr->doUnlock(pRad); // unlock FSM
             pRadVendor->reconfFsm.FSM_ComPend = 0;
             s_resetReconfFsm(pRad, pRadVendor);
+            s_kickLockWaiters(pRad);
+            whm_mxl_perf_stop(pRad, MXL_PERF_RECONF_CYCLE);
             s_printBits(pRad, pRadVendor);
             break;
         }
@@ -403,3 +462,42 @@ void whm_mxl_reconfFsm_init(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
     s_resetReconfFsm(pRad, pRadVendor);
 }
+
+void whm_mxl_reconfFsm_setEventDriven(bool enable) {
+    SAH_TRACEZ_INFO(ME, "Reconf FSM event driven mode set from %u to %u", s_eventDriven, enable);
+    s_eventDriven = enable;
+}
+
+bool whm_mxl_reconfFsm_isEventDriven(void) {
+    return s_eventDriven;
+}
+
+/**
+ * @brief Mark the current FSM step as waiting for a hostapd event.
+ * The FSM resumes on whm_mxl_reconfFsm_notifyEvent, or at the latest after the timeout.
+ *
+ * @param pRad Pointer to Radio context
+ * @param timeoutMs Max time to wait for the event
+ */
+void whm_mxl_reconfFsm_waitEvent(T_Radio* pRad, uint32_t timeoutMs) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    pRadVendor->reconfFsm.timeout_msec = timeoutMs;
+    pRadVendor->reconfFsmWaitEvt = s_eventDriven;
+}
+
+/**
+ * @brief Resume the FSM of a radio waiting for a hostapd event.
+ * The FSM is resumed from the event loop, to not re-enter it from a wpa ctrl callback.
+ *
+ * @param pRad Pointer to Radio context
+ */
+void whm_mxl_reconfFsm_notifyEvent(T_Radio* pRad) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    ASSERTS_TRUE(pRadVendor->reconfFsmWaitEvt, , ME, "%s: FSM not waiting for event", pRad->Name);
+    ASSERTS_NOT_NULL(pRadVendor->reconfFsm.timer, , ME, "%s: FSM not running", pRad->Name);
+    SAH_TRACEZ_INFO(ME, "%s: awaited event received - resume reconf fsm", pRad->Name);
+    pRadVendor->reconfFsmWaitEvt = false;
+    amxp_timer_start(pRadVendor->reconfFsm.timer, MXL_FSM_EVT_KICK_MS);
+}
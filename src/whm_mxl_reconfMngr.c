@@ -41,19 +41,35 @@
 
 #define MAX_COMMITS_PENDING             30
 #define MAX_WAIT_FROM_FIRST_COMMIT_SEC  30
+#define RECONF_TIMEOUT_MS               1000
+#define RECONF_SYNC_RETRY_INTERVAL_MS   200
+#define RECONF_SYNC_MAX_RETRIES         5
 
 typedef struct {
     bool enable;
-    uint32_t delay;
+    uint32_t delay;         /* quiet period, restarted by every new change */
+    uint32_t maxDelay;      /* max latency from first change to commit, 0 for no limit */
     uint32_t bootDelay;
 } whm_mxl_reconfCommitCfg_t;
 
 static whm_mxl_reconfCommitCfg_t reconfCommitMngr = {
     .enable = true,
-    .delay = 1000,
+    .delay = 200,
+    .maxDelay = 2000,
     .bootDelay = 10000,
 };
 
+/* Upper bounds (ms) of the commit latency histogram buckets, last bucket has no bound */
+static const uint32_t sCommitLatencyBucketsMs[MXL_COMMIT_LATENCY_NR_BUCKETS - 1] = {50, 100, 250, 500, 1000, 2500, 5000};
+
+static void s_addPendingCommit(T_Radio* pRad, mxl_VendorData_t* pRadVendor) {
+    if (pRadVendor->reconfFsm.FSM_ComPend == 0) {
+        pRadVendor->reconfFsm.FSM_ComPend_Start = swl_time_getMonoSec();
+    }
+    pRadVendor->reconfFsm.FSM_ComPend++;
+    SAH_TRACEZ_INFO(ME, "%s: Commits are pending %d", pRad->Name, pRadVendor->reconfFsm.FSM_ComPend);
+}
+
 static bool s_reconfCheckRequirements(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRad, MXL_RECONF_FSM_REQ_NO_OK, ME, "NULL");
     if (pRad->enable && pRad->isReady && wld_secDmn_isRunning(pRad->hostapd)) {
@@ -62,14 +78,15 @@ static bool s_reconfCheckRequirements(T_Radio* pRad) {
     return MXL_RECONF_FSM_REQ_NO_OK;
 }
 
-static void s_rescheduleAction(mxl_VendorData_t* pRadVendor,
+static void s_rescheduleAction(T_Radio* pRad,
+                               mxl_VendorData_t* pRadVendor,
                                whm_mxl_reconfMngr_actions_e newAction,
                                bool sameAction) {
     ASSERTS_NOT_NULL(pRadVendor, , ME, "NULL");
     /* Used to reschedule actions during FSM run */
     if (sameAction) {
         setBitLongArray(pRadVendor->reconfFsm.FSM_BitActionArray, FSM_BW, newAction);
-        pRadVendor->reconfFsm.FSM_ComPend++;
+        s_addPendingCommit(pRad, pRadVendor);
     } else {
         setBitLongArray(pRadVendor->reconfFsm.FSM_AC_BitActionArray, FSM_BW, newAction);
     }
@@ -81,7 +98,7 @@ static bool s_modConfFile(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRadVendor, false, ME, "pRadVendorData is NULL");
     SAH_TRACEZ_INFO(ME, "%s: Create new config file for hostapd", pRad->Name);
     pRadVendor->reconfFsm.timeout_msec = 100;
-    wld_hostapd_cfgFile_createExt(pRad);
+    whm_mxl_hapdConf_write(pRad);
     return true;
 }
 
@@ -90,9 +107,25 @@ static bool s_reloadBss(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
     SAH_TRACEZ_INFO(ME, "%s: reloading bss", pAP->alias);
     ASSERTI_FALSE(whm_mxl_utils_isDummyVap(pAP), false, ME, "%s: skip reload bss for dummy vap", pAP->alias);
     ASSERTI_TRUE(wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface), true, ME, "%s: wpactrl link disconnected", pAP->alias);
+    whm_mxl_perf_addRoundTrips(pAP->pRadio, MXL_PERF_RECONF_CYCLE, 1);
     return wld_wpaCtrl_sendCmdCheckResponse(pAP->wpaCtrlInterface, "RELOAD_BSS", "OK");
 }
 
+/*
+ * hostapd handles the reconf request before replying, so once the OK reply is received
+ * the FSM can go on with the sync. Without a reply, wait for the BSS to be enabled again.
+ */
+static void s_reconfStarted(T_Radio* pRad, mxl_VendorData_t* pRadVendor, bool replied) {
+    whm_mxl_perf_addRoundTrips(pRad, MXL_PERF_RECONF_CYCLE, 1);
+    pRadVendor->reconfSyncRetries = RECONF_SYNC_MAX_RETRIES;
+    if (replied) {
+        pRadVendor->reconfFsm.timeout_msec = RECONF_TIMEOUT_MS;
+    } else {
+        SAH_TRACEZ_INFO(ME, "%s: no reconf reply - wait for hostapd event", pRad->Name);
+        whm_mxl_reconfFsm_waitEvent(pRad, RECONF_TIMEOUT_MS);
+    }
+}
+
 /**
  * @brief Send RECONF command to hostapd and reconf specific BSS
  *
@@ -114,9 +147,10 @@ static bool s_reconfBss(T_AccessPoint* pAP, T_Radio* pRad) {
     /* Prepare reconf command */
     swl_str_catFormat(cmd, sizeof(cmd), "RECONF %s", pAP->alias);
 
+    bool replied = false;
     if (wld_wpaCtrlInterface_isReady(masterVap->wpaCtrlInterface)) {
         SAH_TRACEZ_INFO(ME, "%s: start reconf bss using master vap", pAP->alias);
-        wld_wpaCtrl_sendCmdCheckResponseExt(masterVap->wpaCtrlInterface, cmd, "OK", 5000);
+        replied = wld_wpaCtrl_sendCmdCheckResponseExt(masterVap->wpaCtrlInterface, cmd, "OK", 5000);
     } else {
         wld_wpaCtrlMngr_t* pMgr = wld_secDmn_getWpaCtrlMgr(pRad->hostapd);
         wld_wpaCtrlInterface_t* pIface = wld_wpaCtrlMngr_getDefaultInterface(pMgr);
@@ -126,7 +160,7 @@ static bool s_reconfBss(T_AccessPoint* pAP, T_Radio* pRad) {
         setBitLongArray(pRadVendor->reconfFsm.FSM_AC_BitActionArray, FSM_BW, RECONF_FSM_SYNC_RECONF);
     }
 
-    pRadVendor->reconfFsm.timeout_msec = 1000;
+    s_reconfStarted(pRad, pRadVendor, replied);
     return true;
 }
 
@@ -150,8 +184,8 @@ static bool s_reconfAllChangedBss(T_Radio* pRad) {
         setBitLongArray(pRadVendor->reconfFsm.FSM_AC_BitActionArray, FSM_BW, RECONF_FSM_SYNC_RECONF);
     }
     SAH_TRACEZ_INFO(ME, "%s: start reconf on all changed interfaces", pRad->Name);
-    wld_wpaCtrl_sendCmdCheckResponseExt(masterVap->wpaCtrlInterface, "BSS_RECONF", "OK", 5000);
-    pRadVendor->reconfFsm.timeout_msec = 1000;
+    bool replied = wld_wpaCtrl_sendCmdCheckResponseExt(masterVap->wpaCtrlInterface, "BSS_RECONF", "OK", 5000);
+    s_reconfStarted(pRad, pRadVendor, replied);
     return true;
 }
 
@@ -159,6 +193,7 @@ static void s_update6gBeacons(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRad, , ME, "NULL");
     T_AccessPoint* pAP = whm_mxl_utils_getFirstEnabledVap(pRad);
 
+    whm_mxl_perf_addRoundTrips(pRad, MXL_PERF_RECONF_CYCLE, 1);
     if (pAP) {
         SAH_TRACEZ_INFO(ME, "%s: Update 6G beacons", pAP->alias);
         wld_ap_hostapd_sendCommand(pAP, "UPDATE_BEACON", "update 6G beacon");
@@ -215,15 +250,22 @@ static bool s_syncReconf(T_Radio* pRad) {
                     pAP->wDevId = ifaceInfo.wDevId;
                 }
             }
-            if (!wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface)) {
-                SAH_TRACEZ_NOTICE(ME, "%s: reconnecting to %s wpa ctrl socket after reconf", pRad->Name, pAP->alias);
-                wld_wpaCtrlInterface_setEnable(pAP->wpaCtrlInterface, true);
-                wld_wpaCtrlInterface_open(pAP->wpaCtrlInterface);
-                /* Update state becuase we might have missed events while socket was disconnected */
-                wld_vap_updateState(pAP);
-            }
         }
     }
+    /* Only reopen the sockets that hostapd re-created during reconf */
+    bool allCtrlReady = (whm_mxl_wpaCtrlHealth_reconnectStale(pRad, false) == SWL_RC_OK);
+
+    /*
+     * In event driven mode, the sync directly follows the reconf reply:
+     * give hostapd some time to re-create the missing ctrl sockets
+     */
+    if (!allCtrlReady && whm_mxl_reconfFsm_isEventDriven() && (pRadVendor->reconfSyncRetries > 0)) {
+        pRadVendor->reconfSyncRetries--;
+        SAH_TRACEZ_INFO(ME, "%s: wpa ctrl sockets not ready - retry sync (%u left)", pRad->Name, pRadVendor->reconfSyncRetries);
+        setBitLongArray(pRadVendor->reconfFsm.FSM_AC_BitActionArray, FSM_BW, RECONF_FSM_SYNC_RECONF);
+        whm_mxl_reconfFsm_waitEvent(pRad, RECONF_SYNC_RETRY_INTERVAL_MS);
+        return true;
+    }
 
     /* Update 6G co-located beacons after Reconf */
     if (wld_rad_is_6ghz(pRad)) {
@@ -239,19 +281,8 @@ static bool s_syncReconf(T_Radio* pRad) {
 
 static swl_rc_ne s_checkCtrlIfaces(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRad, SWL_RC_ERROR, ME, "NULL");
-    T_AccessPoint* pAP = NULL;
-
-    wld_rad_forEachAp(pAP, pRad) {
-        if (pAP) {
-            if (!wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface)) {
-                SAH_TRACEZ_NOTICE(ME, "%s: restarting wpa ctrl manager %s is not ready", pRad->Name, pAP->alias);
-                wld_wpaCtrlMngr_disconnect(wld_secDmn_getWpaCtrlMgr(pRad->hostapd));
-                wld_wpaCtrlMngr_connect(wld_secDmn_getWpaCtrlMgr(pRad->hostapd));
-                return SWL_RC_CONTINUE;
-            }
-        }
-    }
-    return SWL_RC_OK;
+    /* Reopen stale sockets only, healthy interfaces keep their connection and event subscriptions */
+    return whm_mxl_wpaCtrlHealth_reconnectStale(pRad, true);
 }
 
 static bool s_sync(T_Radio* pRad) {
@@ -268,9 +299,9 @@ static bool s_sync(T_Radio* pRad) {
         whm_mxl_rad_setCtrlSockSyncNeeded(pRad, false);
         if (wld_secDmn_isRunning(pRad->hostapd)) {
             if (s_checkCtrlIfaces(pRad) == SWL_RC_CONTINUE) {
-                pRadVendor->reconfFsm.timeout_msec = 1000;
+                whm_mxl_reconfFsm_waitEvent(pRad, 1000);
                 /* Schedule another sync cycle to refresh radio state after wpa ctrl is established */
-                s_rescheduleAction(pRadVendor, RECONF_FSM_SYNC, true);
+                s_rescheduleAction(pRad, pRadVendor, RECONF_FSM_SYNC, true);
                 updateState = false;
             }
         } else {
@@ -329,8 +360,34 @@ static void s_checkVapDependency(T_AccessPoint* pAP, T_Radio* pRad) {
     }    
 }
 
+/*
+ * Reconf is executed by hostapd on all radios sharing the daemon, and 6G reconf
+ * updates the co-located beacons of the other radios: both require the cross radio lock.
+ * Other actions only touch the radio itself and can run in parallel with other radios.
+ */
+static bool s_isCrossRadioLockRequired(T_Radio* pRad) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, true, ME, "pRadVendorData is NULL");
+    bool reconfRequested = isBitSetLongArray(pRadVendor->reconfFsm.FSM_BitActionArray, FSM_BW, RECONF_FSM_DO_RECONF);
+
+    T_AccessPoint* pAP = NULL;
+    wld_rad_forEachAp(pAP, pRad) {
+        mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+        if (reconfRequested) {
+            break;
+        }
+        if (pAP && pVapVendor && !whm_mxl_utils_isDummyVap(pAP)) {
+            reconfRequested = isBitSetLongArray(pVapVendor->reconfFsm.FSM_BitActionArray, FSM_BW, RECONF_FSM_DO_RECONF_BSS);
+        }
+    }
+    ASSERTS_TRUE(reconfRequested, false, ME, "%s: no reconf requested", pRad->Name);
+
+    return (wld_rad_is_6ghz(pRad) || (whm_mxl_utils_numOfGrpMembers(pRad) > 1));
+}
+
 static bool s_tryRadioLock(T_Radio* pRad) {
-    return whm_mxl_reconfFsmLock(pRad);
+    ASSERT_NOT_NULL(pRad, false, ME, "NULL");
+    return whm_mxl_reconfFsmLock(pRad, s_isCrossRadioLockRequired(pRad));
 }
 
 static void s_doRadioUnlock(T_Radio* pRad) {
@@ -375,13 +432,8 @@ int whm_mxl_reconfMngr_doCommit(T_Radio* pRad) {
         res = whm_mxl_reconf_fsm(pRad);
     } else {
         /* We cannot run reconf FSM - so mark commit is pending */
-        pRadVendor->reconfFsm.FSM_ComPend++;
-        swl_timeMono_t now = swl_time_getMonoSec();
-        if (pRadVendor->reconfFsm.FSM_ComPend == 0) {
-            pRadVendor->reconfFsm.FSM_ComPend_Start = now;
-        }
-        time_t diff = now - pRadVendor->reconfFsm.FSM_ComPend_Start;
-        SAH_TRACEZ_INFO(ME, "%s: Commits are pending %d", pRad->Name, pRadVendor->reconfFsm.FSM_ComPend);
+        s_addPendingCommit(pRad, pRadVendor);
+        time_t diff = swl_time_getMonoSec() - pRadVendor->reconfFsm.FSM_ComPend_Start;
         res = 0;
         if ((pRadVendor->reconfFsm.FSM_ComPend > MAX_COMMITS_PENDING) && (diff > MAX_WAIT_FROM_FIRST_COMMIT_SEC)) {
             SAH_TRACEZ_WARNING(ME, "%s: CANT COMMIT AFTER MANY ATTEMPTS - Forcing FSM reset in all radios", pRad->Name);
@@ -392,9 +444,42 @@ int whm_mxl_reconfMngr_doCommit(T_Radio* pRad) {
     return res;
 }
 
+static void s_addCommitLatency(whm_mxl_commitBatch_t* pBatch, uint32_t latencyMs) {
+    uint32_t bucket = 0;
+    while ((bucket < SWL_ARRAY_SIZE(sCommitLatencyBucketsMs)) && (latencyMs > sCommitLatencyBucketsMs[bucket])) {
+        bucket++;
+    }
+    pBatch->latencyHist[bucket]++;
+    pBatch->lastLatencyMs = latencyMs;
+    pBatch->maxLatencyMs = SWL_MAX(pBatch->maxLatencyMs, latencyMs);
+    pBatch->totalLatencyMs += latencyMs;
+}
+
 static void s_reconfCommit_th(amxp_timer_t* timer _UNUSED, void* userdata) {
     T_Radio* pRad = (T_Radio*) userdata;
     ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    whm_mxl_commitBatch_t* pBatch = &pRadVendor->commitBatch;
+    if (pBatch->pending) {
+        swl_timeSpecMono_t now;
+        swl_timespec_getMono(&now);
+        /* the boot block wait is not commit latency */
+        int64_t latencyMs = SWL_MAX(swl_timespec_diffToMillisec(&pBatch->firstTs, &now) - pBatch->bootWaitMs, (int64_t) 0);
+        if (pBatch->bootWaitMs > 0) {
+            pBatch->nrBootDeferred++;
+        }
+        if ((reconfCommitMngr.maxDelay > 0) && (latencyMs >= reconfCommitMngr.maxDelay)) {
+            pBatch->nrDeadlineHits++;
+        }
+        s_addCommitLatency(pBatch, (uint32_t) latencyMs);
+        pBatch->nrBatches++;
+        pBatch->nrChangesTotal += pBatch->nrChanges;
+        SAH_TRACEZ_INFO(ME, "%s: Commit %u changes batched over %" PRId64 " ms", pRad->Name, pBatch->nrChanges, latencyMs);
+        pBatch->pending = false;
+        pBatch->nrChanges = 0;
+        pBatch->bootWaitMs = 0;
+    }
     whm_mxl_reconfMngr_doCommit(pRad);
 }
 
@@ -405,6 +490,7 @@ void whm_mxl_reconfMngr_init(T_Radio* pRad) {
     pRadVendor->reconfFsmMngr = whm_mxl_get_reconfMngr();
     ASSERT_NOT_NULL(pRadVendor->reconfFsmMngr, , ME, "reconfFsmMngr is NULL");
     amxp_timer_new(&pRadVendor->commitTimer, s_reconfCommit_th, pRad);
+    whm_mxl_wpaCtrlHealth_init(pRad);
     whm_mxl_reconfFsm_init(pRad);
     SAH_TRACEZ_NOTICE(ME, "%s: Reconf manager successfuly initailized", pRad->Name);
 }
@@ -420,6 +506,8 @@ void whm_mxl_reconfMngr_deinit(T_Radio* pRad) {
     pRadVendor->reconfFsmMngr = NULL;
     amxp_timer_delete(&pRadVendor->commitTimer);
     pRadVendor->commitTimer = NULL;
+    memset(&pRadVendor->commitBatch, 0, sizeof(pRadVendor->commitBatch));
+    whm_mxl_wpaCtrlHealth_deinit(pRad);
     SAH_TRACEZ_NOTICE(ME, "%s: Reconf manager successfuly de-initailized", pRad->Name);
 }
 
@@ -446,6 +534,12 @@ void whm_mxl_reconfMngr_initEvents(void) {
     wld_event_add_callback(gWld_queue_vap_onChangeEvent, &s_apChangeCbEvt);
 }
 
+/*
+ * Arm the commit timer for a quiet period after the last change,
+ * without going past the max delay from the first change of the batch.
+ * During boot, the commit is blocked until boot delay expires,
+ * and the batch latency only starts when the commit is allowed to run.
+ */
 static void s_startReconfCommit(T_Radio* pRad) {
     mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
     ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
@@ -455,9 +549,6 @@ static void s_startReconfCommit(T_Radio* pRad) {
 
     ASSERTI_TRUE(reconfCommitMngr.enable, , ME, "Reconf commit manager is disabled");
     ASSERT_NOT_NULL(pRadVendor->commitTimer, , ME, "commitTimer is NULL");
-    amxp_timer_state_t state = pRadVendor->commitTimer->state;
-
-    ASSERTI_TRUE(state != amxp_timer_running && state != amxp_timer_started, , ME, "%s: commit timer already started", pRad->Name);
     ASSERTI_TRUE(pRadVendor->reconfFsm.FSM_ComPend == 0, , ME, "%s: Already have pending commits (%d)", pRad->Name, pRadVendor->reconfFsm.FSM_ComPend);
 
     int64_t mSecSinceInit = swl_timespec_diffToMillisec(initTime, &time);
@@ -465,8 +556,25 @@ static void s_startReconfCommit(T_Radio* pRad) {
     if ((mSecSinceInit > 0 ) && (mSecSinceInit < reconfCommitMngr.bootDelay)) {
         minDelay = reconfCommitMngr.bootDelay - (uint32_t) mSecSinceInit;
     }
-    uint32_t finalDelay = SWL_MAX(reconfCommitMngr.delay, minDelay);
-    SAH_TRACEZ_INFO(ME, "%s: Starting reconf commit timer with delay %u", pRad->Name, finalDelay);
+
+    whm_mxl_commitBatch_t* pBatch = &pRadVendor->commitBatch;
+    amxp_timer_state_t state = pRadVendor->commitTimer->state;
+    if (!pBatch->pending || ((state != amxp_timer_running) && (state != amxp_timer_started))) {
+        pBatch->pending = true;
+        pBatch->firstTs = time;
+        pBatch->bootWaitMs = minDelay;
+        pBatch->nrChanges = 0;
+    }
+    pBatch->nrChanges++;
+
+    uint32_t delay = reconfCommitMngr.delay;
+    if (reconfCommitMngr.maxDelay > 0) {
+        int64_t batchAge = SWL_MAX(swl_timespec_diffToMillisec(&pBatch->firstTs, &time) - pBatch->bootWaitMs, (int64_t) 0);
+        uint32_t remaining = (batchAge < reconfCommitMngr.maxDelay) ? (reconfCommitMngr.maxDelay - (uint32_t) batchAge) : 0;
+        delay = SWL_MIN(delay, remaining);
+    }
+    uint32_t finalDelay = SWL_MAX(delay, minDelay);
+    SAH_TRACEZ_INFO(ME, "%s: (Re)starting reconf commit timer with delay %u (%u changes batched)", pRad->Name, finalDelay, pBatch->nrChanges);
     amxp_timer_start(pRadVendor->commitTimer, finalDelay);
 }
 
@@ -515,6 +623,13 @@ static void s_reconfMngrDelay_pwf(void* priv _UNUSED, amxd_object_t* object _UNU
     reconfCommitMngr.delay = delay;
 }
 
+static void s_reconfMngrMaxDelay_pwf(void* priv _UNUSED, amxd_object_t* object _UNUSED,
+                                   amxd_param_t* param _UNUSED, const amxc_var_t* const newValue) {
+    uint32_t maxDelay = amxc_var_dyncast(uint32_t, newValue);
+    SAH_TRACEZ_INFO(ME, "Reconf Mngr max delay set from %u to %u", reconfCommitMngr.maxDelay, maxDelay);
+    reconfCommitMngr.maxDelay = maxDelay;
+}
+
 static void s_reconfMngrBootDelay_pwf(void* priv _UNUSED, amxd_object_t* object _UNUSED,
                                     amxd_param_t* param _UNUSED, const amxc_var_t* const newValue) {
     uint32_t bootDelay = amxc_var_dyncast(uint32_t, newValue);
@@ -522,13 +637,54 @@ static void s_reconfMngrBootDelay_pwf(void* priv _UNUSED, amxd_object_t* object
     reconfCommitMngr.bootDelay = bootDelay;
 }
 
+static void s_reconfMngrEventDriven_pwf(void* priv _UNUSED, amxd_object_t* object _UNUSED,
+                                        amxd_param_t* param _UNUSED, const amxc_var_t* const newValue) {
+    whm_mxl_reconfFsm_setEventDriven(amxc_var_dyncast(bool, newValue));
+}
+
 SWLA_DM_HDLRS(sReconfMngrMgrDmHdlrs,
               ARR(SWLA_DM_PARAM_HDLR("CommitEnable", s_reconfMngrCommitEnable_pwf),
                   SWLA_DM_PARAM_HDLR("CommitDelay", s_reconfMngrDelay_pwf),
-                  SWLA_DM_PARAM_HDLR("BootBlockDelay", s_reconfMngrBootDelay_pwf)));
+                  SWLA_DM_PARAM_HDLR("CommitMaxDelay", s_reconfMngrMaxDelay_pwf),
+                  SWLA_DM_PARAM_HDLR("BootBlockDelay", s_reconfMngrBootDelay_pwf),
+                  SWLA_DM_PARAM_HDLR("EventDriven", s_reconfMngrEventDriven_pwf)));
 
 void _whm_mxl_reconfMngr_configure_ocf(const char* const sig_name,
                                        const amxc_var_t* const data,
                                        void* const priv) {
     swla_dm_procObjEvtOfLocalDm(&sReconfMngrMgrDmHdlrs, sig_name, data, priv);
 }
+
+amxd_status_t _whm_mxl_reconfMngr_getCommitStats(amxd_object_t* object,
+                                                 amxd_function_t* func _UNUSED,
+                                                 amxc_var_t* args _UNUSED,
+                                                 amxc_var_t* retval) {
+    /* WiFi.Radio.{}.Vendor. */
+    T_Radio* pRad = wld_rad_fromObj(amxd_object_get_parent(object));
+    ASSERT_NOT_NULL(pRad, amxd_status_unknown_error, ME, "No Radio Mapped");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, amxd_status_unknown_error, ME, "NULL");
+    whm_mxl_commitBatch_t* pBatch = &pRadVendor->commitBatch;
+
+    amxc_var_set_type(retval, AMXC_VAR_ID_HTABLE);
+    amxc_var_add_key(uint32_t, retval, "Batches", pBatch->nrBatches);
+    amxc_var_add_key(uint64_t, retval, "Changes", pBatch->nrChangesTotal);
+    amxc_var_add_key(uint32_t, retval, "DeadlineHits", pBatch->nrDeadlineHits);
+    amxc_var_add_key(uint32_t, retval, "BootDeferred", pBatch->nrBootDeferred);
+    amxc_var_add_key(uint32_t, retval, "PendingChanges", pBatch->pending ? pBatch->nrChanges : 0);
+    amxc_var_add_key(uint32_t, retval, "PendingCommits", pRadVendor->reconfFsm.FSM_ComPend);
+    amxc_var_add_key(uint32_t, retval, "LastLatencyMs", pBatch->lastLatencyMs);
+    amxc_var_add_key(uint32_t, retval, "MaxLatencyMs", pBatch->maxLatencyMs);
+    amxc_var_add_key(uint32_t, retval, "AvgLatencyMs", pBatch->nrBatches ? (uint32_t) (pBatch->totalLatencyMs / pBatch->nrBatches) : 0);
+    amxc_var_t* pHist = amxc_var_add_key(amxc_htable_t, retval, "LatencyHistogram", NULL);
+    for (uint32_t i = 0; i < MXL_COMMIT_LATENCY_NR_BUCKETS; i++) {
+        char bucketName[32] = {0};
+        if (i < SWL_ARRAY_SIZE(sCommitLatencyBucketsMs)) {
+            swl_str_catFormat(bucketName, sizeof(bucketName), "Le%ums", sCommitLatencyBucketsMs[i]);
+        } else {
+            swl_str_catFormat(bucketName, sizeof(bucketName), "Gt%ums", sCommitLatencyBucketsMs[i - 1]);
+        }
+        amxc_var_add_key(uint32_t, pHist, bucketName, pBatch->latencyHist[i]);
+    }
+    return amxd_status_ok;
+}
@@ -21,6 +21,7 @@
 #include "wld/wld_util.h"
 #include "wld/wld_radio.h"
 #include "wld/wld_accesspoint.h"
+#include "wld/wld_assocdev.h"
 #include "wld/wld_nl80211_compat.h"
 #include "wld/wld_nl80211_api.h"
 #include "wld/wld_ap_nl80211.h"
@@ -37,6 +38,8 @@
 #include "whm_mxl_wmm.h"
 #include "whm_mxl_mlo.h"
 #include "whm_mxl_reconfMngr.h"
+#include "whm_mxl_nlVendor.h"
+#include "whm_mxl_vendorQueue.h"
 
 #define START_ENABLE_SYNC_TIMEOUT_MS 10000
 
@@ -86,6 +89,9 @@ static void s_mxl_vap_init_vendordata(T_AccessPoint* pAP) {
     mxlVapVendorData->EnableWPA3PersonalCompatibility = 0;
     /* Init VAP enable sync timer */
     amxp_timer_new(&mxlVapVendorData->onVapEnableSyncTimer, s_enableSync, pAP);
+    /* Init hostapd config shadow */
+    amxc_var_init(&mxlVapVendorData->cfgShadow);
+    amxc_var_set_type(&mxlVapVendorData->cfgShadow, AMXC_VAR_ID_HTABLE);
     return;
 }
 
@@ -135,6 +141,12 @@ int whm_mxl_vap_createHook(T_AccessPoint* pAP) {
 static void s_mxl_deinit_vendorVapData(mxl_VapVendorData_t* mxlVapVendorData) {
     ASSERT_NOT_NULL(mxlVapVendorData, , ME, "mxlVapVendorData is NULL");
     amxp_timer_delete(&mxlVapVendorData->onVapEnableSyncTimer);
+    amxc_var_clean(&mxlVapVendorData->cfgShadow);
+    if(mxlVapVendorData->pStaStatsRound != NULL) {
+        /* late replies still release the round, which then frees itself */
+        mxlVapVendorData->pStaStatsRound->pAP = NULL;
+        mxlVapVendorData->pStaStatsRound = NULL;
+    }
     return;
 }
 
@@ -149,27 +161,17 @@ void whm_mxl_vap_destroyHook(T_AccessPoint* pAP){
     free(mxlVapVendorData);
 }
 
-static swl_rc_ne s_getDevDiagResults3Cb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
-    ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "Request error");
-    ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
-
+static const void* s_getStaStatsVendorData(struct nlmsghdr* nlh, uint32_t subcmd) {
     struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
-    ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
-
-    T_AssociatedDevice* pAD = (T_AssociatedDevice*) priv;
-    ASSERT_NOT_NULL(pAD, SWL_RC_ERROR, ME, "NULL");
+    ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, NULL, ME, "unexpected cmd %d", gnlh->cmd);
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
+    whm_mxl_nlVendorView_t view;
+    ASSERT_EQUALS(whm_mxl_nlVendor_getReplyView(nlh, subcmd, &view), SWL_RC_OK, NULL, ME, "fail to decode subcmd %u", subcmd);
+    return view.data;
+}
 
-    // parse data table
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    wifiAssociatedDevDiagnostic3_t* devDiagRes3Stats = (wifiAssociatedDevDiagnostic3_t*) data;
+static void s_parseDevDiagResults3(T_AssociatedDevice* pAD, const void* data) {
+    const wifiAssociatedDevDiagnostic3_t* devDiagRes3Stats = (const wifiAssociatedDevDiagnostic3_t*) data;
     const char* opStdName = (const char*) devDiagRes3Stats->wifiAssociatedDevDiagnostic2.OperatingStandard;
     swl_radStd_e* pOpStd = (swl_radStd_e*) swl_table_getMatchingValue(&sOperStdMap, 1, 0, opStdName);
     pAD->operatingStandard = (pOpStd != NULL) ? *pOpStd : SWL_RADSTD_AUTO;
@@ -184,6 +186,33 @@ static swl_rc_ne s_getDevDiagResults3Cb(swl_rc_ne rc, struct nlmsghdr* nlh, void
     pAD->RxPacketCount = devDiagRes3Stats->PacketsReceived;
     pAD->Retransmissions = devDiagRes3Stats->wifiAssociatedDevDiagnostic2.Retransmissions;
     pAD->Tx_RetransmissionsFailed = devDiagRes3Stats->FailedRetransCount;
+}
+
+static void s_parsePeerFlowStatus(T_AssociatedDevice* pAD, const void* data) {
+    const mtlk_wssa_drv_peer_stats_t* peerFlowStats = (const mtlk_wssa_drv_peer_stats_t*) data;
+    pAD->Rx_Retransmissions = peerFlowStats->tr181_stats.retrans_stats.Retransmissions;
+    pAD->RxUnicastPacketCount = peerFlowStats->tr181_stats.traffic_stats.UnicastPacketsReceived;
+    pAD->TxMulticastPacketCount = peerFlowStats->tr181_stats.traffic_stats.MulticastPacketsSent;
+    pAD->TxUnicastPacketCount = peerFlowStats->tr181_stats.traffic_stats.UnicastPacketsSent;
+    pAD->SignalStrength = peerFlowStats->tr181_stats.SignalStrength;
+    pAD->TxBytes = peerFlowStats->tr181_stats.traffic_stats.BytesSent;
+    pAD->RxBytes = peerFlowStats->tr181_stats.traffic_stats.BytesReceived;
+    pAD->LastDataUplinkRate = peerFlowStats->tr181_stats.LastDataUplinkRate;
+    pAD->LastDataDownlinkRate = peerFlowStats->tr181_stats.LastDataDownlinkRate;
+    pAD->MaxUplinkRateSupported = SWL_MAX(pAD->MaxUplinkRateSupported, peerFlowStats->tr181_stats.LastDataUplinkRate);
+    pAD->MaxDownlinkRateSupported = SWL_MAX(pAD->MaxDownlinkRateSupported, peerFlowStats->tr181_stats.LastDataDownlinkRate);
+}
+
+static swl_rc_ne s_getDevDiagResults3Cb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
+    ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "Request error");
+    ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
+
+    T_AssociatedDevice* pAD = (T_AssociatedDevice*) priv;
+    ASSERT_NOT_NULL(pAD, SWL_RC_ERROR, ME, "NULL");
+
+    const void* data = s_getStaStatsVendorData(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_DEV_DIAG_RESULT3);
+    ASSERT_NOT_NULL(data, SWL_RC_ERROR, ME, "NULL");
+    s_parseDevDiagResults3(pAD, data);
 
     return rc;
 }
@@ -210,35 +239,12 @@ static swl_rc_ne s_getPeerFlowStatusCb(swl_rc_ne rc, struct nlmsghdr* nlh, void*
     ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "Request error");
     ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
 
-    struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
-    ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
-
     T_AssociatedDevice* pAD = (T_AssociatedDevice*) priv;
     ASSERT_NOT_NULL(pAD, SWL_RC_ERROR, ME, "NULL");
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
-
-    // parse data table
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    mtlk_wssa_drv_peer_stats_t* peerFlowStats = (mtlk_wssa_drv_peer_stats_t*) data;
-    ASSERT_NOT_NULL(peerFlowStats, SWL_RC_ERROR, ME, "NULL");
-    pAD->Rx_Retransmissions = peerFlowStats->tr181_stats.retrans_stats.Retransmissions;
-    pAD->RxUnicastPacketCount = peerFlowStats->tr181_stats.traffic_stats.UnicastPacketsReceived;
-    pAD->TxMulticastPacketCount = peerFlowStats->tr181_stats.traffic_stats.MulticastPacketsSent;
-    pAD->TxUnicastPacketCount = peerFlowStats->tr181_stats.traffic_stats.UnicastPacketsSent;
-    pAD->SignalStrength = peerFlowStats->tr181_stats.SignalStrength;
-    pAD->TxBytes = peerFlowStats->tr181_stats.traffic_stats.BytesSent;
-    pAD->RxBytes = peerFlowStats->tr181_stats.traffic_stats.BytesReceived;
-    pAD->LastDataUplinkRate = peerFlowStats->tr181_stats.LastDataUplinkRate;
-    pAD->LastDataDownlinkRate = peerFlowStats->tr181_stats.LastDataDownlinkRate;
-    pAD->MaxUplinkRateSupported = SWL_MAX(pAD->MaxUplinkRateSupported, peerFlowStats->tr181_stats.LastDataUplinkRate);
-    pAD->MaxDownlinkRateSupported = SWL_MAX(pAD->MaxDownlinkRateSupported, peerFlowStats->tr181_stats.LastDataDownlinkRate);
+    const void* data = s_getStaStatsVendorData(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_FLOW_STATUS);
+    ASSERT_NOT_NULL(data, SWL_RC_ERROR, ME, "NULL");
+    s_parsePeerFlowStatus(pAD, data);
 
     return rc;
 }
@@ -283,19 +289,181 @@ swl_rc_ne whm_mxl_vap_getSingleStationStats(T_AssociatedDevice* pAD) {
     return rc;
 }
 
+/*
+ * Station stats round of an AP: the vendor diagnostic and peer flow requests of all its stations,
+ * pipelined asynchronously. Replies are kept in the round, and only applied to the stations,
+ * right after the generic station dump, when the last one arrives.
+ * So the station counters always come from one round, and never go back to older vendor values.
+ */
+#define MXL_STA_STATS_ROUND_TIMEOUT_SEC 5
+#define MXL_STA_STATS_REQS_PER_STA      2
+
+typedef void (* mxl_staStatsParser_f)(T_AssociatedDevice* pAD, const void* data);
+
+typedef struct {
+    whm_mxl_staStatsRound_t* pRound;
+    swl_macBin_t mac;
+    uint32_t subcmd;
+    mxl_staStatsParser_f parser;
+    size_t dataLen;
+    bool replied;               /* nl80211 layer has called back, or the send failed */
+    bool valid;                 /* data holds the driver reply */
+    union {
+        wifiAssociatedDevDiagnostic3_t devDiag3;
+        mtlk_wssa_drv_peer_stats_t peerFlow;
+    } data;
+} mxl_staStatsReq_t;
+
+struct whm_mxl_staStatsRound {
+    T_AccessPoint* pAP;         /* NULL when the AP is gone or the round was abandoned */
+    swl_timeMono_t startSec;    /* monotonic start time */
+    whm_mxl_perfRun_t perfRun;
+    uint32_t nrPending;         /* pending replies, plus one ref held while issuing */
+    uint32_t nrFailed;
+    uint32_t nrReqs;
+    mxl_staStatsReq_t reqs[];
+};
+
+static void s_completeStaStatsRound(whm_mxl_staStatsRound_t* pRound) {
+    T_AccessPoint* pAP = pRound->pAP;
+    mxl_VapVendorData_t* pVapVendor = (pAP != NULL) ? mxl_vap_getVapVendorData(pAP) : NULL;
+    if(pVapVendor != NULL) {
+        pVapVendor->pStaStatsRound = NULL;
+        /* generic info first, then overridden by the vendor values, as with the sync requests */
+        swl_rc_ne rc = SWL_RC_OK;
+        CALL_NL80211_FTA_RET(rc, mfn_wvap_get_station_stats, pAP);
+        if(rc < SWL_RC_OK) {
+            SAH_TRACEZ_ERROR(ME, "%s: fail in generic call", pAP->alias);
+        }
+        pRound->perfRun.nrRoundTrips++;
+        for(uint32_t i = 0; i < pRound->nrReqs; i++) {
+            mxl_staStatsReq_t* pReq = &pRound->reqs[i];
+            T_AssociatedDevice* pAD = pReq->valid ? wld_vap_find_asociatedDevice(pAP, &pReq->mac) : NULL;
+            if((pAD == NULL) || !pAD->Active) {
+                continue;
+            }
+            pReq->parser(pAD, &pReq->data);
+        }
+        whm_mxl_perf_record(pAP->pRadio, MXL_PERF_STA_STATS, &pRound->perfRun);
+        SAH_TRACEZ_INFO(ME, "%s: station stats round done, %u requests, %u failed", pAP->alias, pRound->nrReqs, pRound->nrFailed);
+    }
+    free(pRound);
+}
+
+static void s_releaseStaStatsRound(whm_mxl_staStatsRound_t* pRound, bool failed) {
+    if(failed) {
+        pRound->nrFailed++;
+    }
+    if(--pRound->nrPending == 0) {
+        s_completeStaStatsRound(pRound);
+    }
+}
+
+/* Called once per sent request by the nl80211 layer, with the driver reply or the error / timeout */
+static swl_rc_ne s_getStaStatsAsyncCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
+    mxl_staStatsReq_t* pReq = (mxl_staStatsReq_t*) priv;
+    ASSERT_NOT_NULL(pReq, SWL_RC_ERROR, ME, "NULL");
+    ASSERTS_FALSE(pReq->replied, SWL_RC_DONE, ME, "request already replied");
+    pReq->replied = true;
+    const void* data = ((rc > SWL_RC_ERROR) && (nlh != NULL)) ? s_getStaStatsVendorData(nlh, pReq->subcmd) : NULL;
+    if(data != NULL) {
+        memcpy(&pReq->data, data, pReq->dataLen);
+        pReq->valid = true;
+    } else {
+        SAH_TRACEZ_INFO(ME, "no stats reply of "SWL_MAC_FMT" (%d)", SWL_MAC_ARG(pReq->mac.bMac), rc);
+    }
+    s_releaseStaStatsRound(pReq->pRound, !pReq->valid);
+    return SWL_RC_DONE;
+}
+
+static void s_sendStaStatsReq(whm_mxl_staStatsRound_t* pRound, T_AccessPoint* pAP, T_AssociatedDevice* pAD,
+                              uint32_t subcmd, size_t dataLen, mxl_staStatsParser_f parser) {
+    mxl_staStatsReq_t* pReq = &pRound->reqs[pRound->nrReqs++];
+    pReq->pRound = pRound;
+    memcpy(pReq->mac.bMac, pAD->MACAddress, ETHER_ADDR_LEN);
+    pReq->subcmd = subcmd;
+    pReq->dataLen = dataLen;
+    pReq->parser = parser;
+    pRound->nrPending++;
+    pRound->perfRun.nrRoundTrips++;
+    swl_rc_ne rc = wld_ap_nl80211_sendVendorSubCmd(pAP, OUI_MXL, subcmd, pAD->MACAddress, ETHER_ADDR_LEN,
+                                                   VENDOR_SUBCMD_IS_ASYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_getStaStatsAsyncCb, pReq);
+    if((rc < SWL_RC_OK) && !pReq->replied) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to send subcmd %u of %s", pAP->alias, subcmd, pAD->Name);
+        pReq->replied = true;
+        s_releaseStaStatsRound(pRound, true);
+    }
+}
+
+/**
+ * @brief Update statistics of all stations connected to an AP
+ *
+ * Vendor diagnostic and peer flow requests of all stations are pipelined asynchronously
+ * in one round, so the event loop is not blocked for one round trip per station.
+ * When the last reply arrives, the generic info is fetched with a single nl80211 station dump,
+ * and the vendor replies are applied on top of it.
+ * So each poll publishes the result of the last completed round.
+ *
+ * @param pAP Pointer to AP context
+ * @return SWL_RC_OK on success, error code otherwise
+ */
 swl_rc_ne whm_mxl_vap_getStationStats(T_AccessPoint* pAP) {
     SAH_TRACEZ_IN(ME);
     ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
+    T_Radio* pRad = (T_Radio*) pAP->pRadio;
+    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_FALSE(pRad->detailedState == CM_RAD_DOWN, SWL_RC_INVALID_STATE, ME, "Radio state is down");
+    mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+    ASSERT_NOT_NULL(pVapVendor, SWL_RC_INVALID_PARAM, ME, "pVapVendor is NULL");
+    swl_rc_ne rc = SWL_RC_OK;
+
+    if(pVapVendor->pStaStatsRound != NULL) {
+        uint32_t elapsed = swl_time_getMonoSec() - pVapVendor->pStaStatsRound->startSec;
+        ASSERTI_TRUE(elapsed >= MXL_STA_STATS_ROUND_TIMEOUT_SEC, SWL_RC_OK, ME, "%s: station stats round in progress", pAP->alias);
+        SAH_TRACEZ_WARNING(ME, "%s: abandon station stats round after %us", pAP->alias, elapsed);
+        /* late replies still release the round, which then frees itself */
+        pVapVendor->pStaStatsRound->pAP = NULL;
+        pVapVendor->pStaStatsRound = NULL;
+    }
 
+    if((pRad->status == RST_ERROR) || !mxl_isApReadyToProcessVendorCmd(pAP)) {
+        CALL_NL80211_FTA_RET(rc, mfn_wvap_get_station_stats, pAP);
+        ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: fail in generic call", pAP->alias);
+        SAH_TRACEZ_INFO(ME, "%s: no vendor station stats, radio error or AP not ready", pAP->alias);
+        return SWL_RC_INVALID_STATE;
+    }
+
+    uint32_t nrActive = 0;
     for(int i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
         T_AssociatedDevice* pAD = pAP->AssociatedDevice[i];
-        if(!pAD) {
-            SAH_TRACEZ_ERROR(ME, "nullpointer! %p", pAD);
-            return SWL_RC_ERROR;
+        if((pAD != NULL) && pAD->Active) {
+            nrActive++;
+        }
+    }
+    whm_mxl_staStatsRound_t* pRound = calloc(1, sizeof(whm_mxl_staStatsRound_t) +
+                                             nrActive * MXL_STA_STATS_REQS_PER_STA * sizeof(mxl_staStatsReq_t));
+    ASSERT_NOT_NULL(pRound, SWL_RC_ERROR, ME, "%s: fail to allocate station stats round", pAP->alias);
+    pRound->pAP = pAP;
+    pRound->startSec = swl_time_getMonoSec();
+    pRound->nrPending = 1;
+    swl_timespec_getMono(&pRound->perfRun.startTs);
+    pRound->perfRun.running = true;
+    pVapVendor->pStaStatsRound = pRound;
+
+    for(int i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
+        T_AssociatedDevice* pAD = pAP->AssociatedDevice[i];
+        if((pAD == NULL) || !pAD->Active) {
+            continue;
         }
-        whm_mxl_vap_getSingleStationStats(pAD);
+        pRound->perfRun.nrItems++;
+        s_sendStaStatsReq(pRound, pAP, pAD, LTQ_NL80211_VENDOR_SUBCMD_GET_DEV_DIAG_RESULT3,
+                          sizeof(wifiAssociatedDevDiagnostic3_t), s_parseDevDiagResults3);
+        s_sendStaStatsReq(pRound, pAP, pAD, LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_FLOW_STATUS,
+                          sizeof(mtlk_wssa_drv_peer_stats_t), s_parsePeerFlowStatus);
     }
 
+    /* drop the issuing reference: completes the round now if all replies are already in */
+    s_releaseStaStatsRound(pRound, false);
     return SWL_RC_OK;
 }
 
@@ -309,18 +477,10 @@ static swl_rc_ne s_getTr181WlanStatsApCb(swl_rc_ne rc, struct nlmsghdr* nlh, voi
     T_AccessPoint* pAP = (T_AccessPoint*) priv;
     ASSERT_NOT_NULL(pAP, SWL_RC_ERROR, ME, "NULL");
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
-    }
-
-    // parse data table
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    mtlk_wssa_drv_tr181_wlan_stats_t* tr181Stats = (mtlk_wssa_drv_tr181_wlan_stats_t*) data;
-    ASSERT_NOT_NULL(tr181Stats, SWL_RC_ERROR, ME, "NULL");
+    whm_mxl_nlVendorView_t view;
+    swl_rc_ne ret = whm_mxl_nlVendor_getReplyView(nlh, LTQ_NL80211_VENDOR_SUBCMD_GET_TR181_WLAN_STATS, &view);
+    ASSERT_EQUALS(ret, SWL_RC_OK, ret, ME, "fail to decode ap stats");
+    const mtlk_wssa_drv_tr181_wlan_stats_t* tr181Stats = WHM_MXL_NL_VENDOR_VIEW(&view, mtlk_wssa_drv_tr181_wlan_stats_t);
 
     T_Stats* pApStats = &pAP->pSSID->stats;
     pApStats->BytesSent                   = tr181Stats->traffic_stats.BytesSent;
@@ -1509,60 +1669,78 @@ void _whm_mxl_vap_updateMaxAssociatedDevices(const char* const sig_name _UNUSED,
     whm_mxl_updateOnEventMaxAssociatedDevices(pAP);
 }
 
-static swl_rc_ne s_get20MHzTxPowerCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
-    ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "Request error");
-    ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
-
-    struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
-    ASSERTI_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
-
-    int* txPower = (int*) priv;
-    ASSERT_NOT_NULL(txPower, SWL_RC_ERROR, ME, "txPower is NULL");
+/* Convert the 20MHz TX power of the colocated 6G radio to the PSD subfield of the neighbor report */
+static swl_rc_ne s_txPowerToPsd(int tx_power_20mhz, uint8_t* psd) {
+    /* Adjust received 20MHz TX power to the correct units of PSD subfield */
+    int tmpPsd = (tx_power_20mhz - MXL_HAPD_6GHZ_10LOG_20MHZ ) * MXL_HAPD_6GHZ_CONVERT_HALF_DB_UNIT;
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if (nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "Failed to parse netlink message");
-        return SWL_RC_ERROR;
+    ASSERT_FALSE(((tmpPsd < MXL_HAPD_6GHZ_PSD_20MHZ_MIN) || (tmpPsd > MXL_HAPD_6GHZ_PSD_20MHZ_MAX)), SWL_RC_ERROR, ME,
+                                                                "PSD is out of range (%d)", tmpPsd);
+    if (tmpPsd < 0) {
+        tmpPsd = tmpPsd + MXL_HAPD_BYTE_2S_COMPLEMENT;
     }
 
-    // parse data table
-    void* data = NULL;
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    data = nla_data(tb[NL80211_ATTR_VENDOR_DATA]);
-    int* tmpTxPower = (int*) data;
-    ASSERT_NOT_NULL(tmpTxPower, SWL_RC_ERROR, ME, "tmpTxPower is NULL");
-    *txPower = *tmpTxPower;
+    *psd = (u8) tmpPsd;
+    return SWL_RC_OK;
+}
+
+/* Neighbor waiting for the TX power of its colocated 6G radio */
+typedef struct {
+    char apName[IFNAMSIZ];          /* AP the neighbor belongs to */
+    swl_macBin_t bssid;             /* colocated 6G neighbor */
+} whm_mxl_neighborPsdReq_t;
 
-    return rc;
+static void s_neighborTxPowerDone(swl_rc_ne rc, const whm_mxl_nlVendorView_t* pView, void* userData) {
+    whm_mxl_neighborPsdReq_t* pReq = (whm_mxl_neighborPsdReq_t*) userData;
+    ASSERT_NOT_NULL(pReq, , ME, "NULL");
+    uint8_t psd = 0;
+    T_AccessPoint* pAP = wld_vap_from_name(pReq->apName);
+    if((rc < SWL_RC_OK) || (pView == NULL)) {
+        SAH_TRACEZ_ERROR(ME, "%s: Failed to get 20MHz tx power (%d)", pReq->apName, rc);
+    } else if(pAP == NULL) {
+        SAH_TRACEZ_INFO(ME, "%s: AP gone, drop neighbor psd", pReq->apName);
+    } else if(swl_rc_isOk(s_txPowerToPsd(*WHM_MXL_NL_VENDOR_VIEW(pView, int), &psd))) {
+        char cmd[256] = {0};
+        /* Prepare message to hostapd */
+        swl_str_catFormat(cmd, sizeof(cmd), "SET_NEIGHBOR_PSD %s psd_subfield=%d",
+                                                swl_typeMacBin_toBuf32Ref(&pReq->bssid).buf,
+                                                (psd & 0xff));
+        SAH_TRACEZ_INFO(ME, "sending cmd : %s", cmd);
+        if(!whm_mxl_hostapd_sendCommand(pAP, cmd, "set_neighbor_psd")) {
+            SAH_TRACEZ_ERROR(ME, "%s: set_neighbor_psd command failed", pAP->alias);
+        }
+    }
+    free(pReq);
 }
 
-static swl_rc_ne s_getNeighborPsd(T_AccessPoint* pNeighAp, uint8_t* psd) {
+/* Queue the TX power read on the master VAP of the neighbor radio, the PSD is set on completion */
+static swl_rc_ne s_getNeighborPsd(T_AccessPoint* pAP, T_AccessPoint* pNeighAp, const swl_macBin_t* pBssid) {
     ASSERT_NOT_NULL(pNeighAp, SWL_RC_INVALID_PARAM, ME, "pNeighAp is NULL");
-    ASSERT_NOT_NULL(psd, SWL_RC_INVALID_PARAM, ME, "psd is NULL");
     T_Radio* pNeighRad = pNeighAp->pRadio;
     ASSERT_NOT_NULL(pNeighRad, SWL_RC_INVALID_PARAM, ME, "pNeighRad is NULL");
     T_AccessPoint* masterVap = wld_rad_getFirstVap(pNeighRad);
     ASSERTS_NOT_NULL(masterVap, SWL_RC_INVALID_PARAM, ME, "masterVap is NULL");
-    int tmpPsd = 0;
-    int tx_power_20mhz = 0;
-    swl_rc_ne rc = SWL_RC_OK;
-    uint32_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_20MHZ_TX_POWER;
-
     ASSERTI_TRUE(mxl_isApReadyToProcessVendorCmd(masterVap), SWL_RC_INVALID_STATE, ME, "AP not ready to process Vendor cmd");
-    rc = wld_ap_nl80211_sendVendorSubCmd(masterVap, OUI_MXL, subcmd, masterVap->pSSID->Name, strlen(masterVap->pSSID->Name),
-                                         VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_get20MHzTxPowerCb, &tx_power_20mhz);
-    ASSERT_TRUE((rc == SWL_RC_OK), SWL_RC_ERROR, ME, "Failed in call LTQ_NL80211_VENDOR_SUBCMD_GET_20MHZ_TX_POWER");
-
-    /* Adjust received 20MHz TX power to the correct units of PSD subfield */
-    tmpPsd = (tx_power_20mhz - MXL_HAPD_6GHZ_10LOG_20MHZ ) * MXL_HAPD_6GHZ_CONVERT_HALF_DB_UNIT;
 
-    ASSERT_FALSE(((tmpPsd < MXL_HAPD_6GHZ_PSD_20MHZ_MIN) || (tmpPsd > MXL_HAPD_6GHZ_PSD_20MHZ_MAX)), SWL_RC_ERROR, ME,
-                                                                "PSD is out of range (%d)", tmpPsd);
-    if (tmpPsd < 0) {
-        tmpPsd = tmpPsd + MXL_HAPD_BYTE_2S_COMPLEMENT;
+    whm_mxl_neighborPsdReq_t* pReq = calloc(1, sizeof(whm_mxl_neighborPsdReq_t));
+    ASSERT_NOT_NULL(pReq, SWL_RC_ERROR, ME, "%s: fail to allocate neighbor psd request", pAP->alias);
+    swl_str_copy(pReq->apName, sizeof(pReq->apName), pAP->alias);
+    memcpy(pReq->bssid.bMac, pBssid->bMac, ETHER_ADDR_LEN);
+
+    whm_mxl_vendorReqArgs_t args = {
+        .pAP = masterVap,
+        .subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_20MHZ_TX_POWER,
+        .data = masterVap->pSSID->Name,
+        .dataLen = strlen(masterVap->pSSID->Name),
+        .expectReply = true,
+        .doneCb = s_neighborTxPowerDone,
+        .userData = pReq,
+    };
+    swl_rc_ne rc = whm_mxl_vendorQueue_send(pNeighRad, &args, NULL);
+    if(rc < SWL_RC_OK) {
+        SAH_TRACEZ_ERROR(ME, "Failed to queue LTQ_NL80211_VENDOR_SUBCMD_GET_20MHZ_TX_POWER");
+        free(pReq);
     }
-
-    *psd = (u8) tmpPsd;
     return rc;
 }
 
@@ -1573,8 +1751,6 @@ static swl_rc_ne s_whm_mxl_setNeighborPsd(T_AccessPoint* pAP, T_ApNeighbour* pAp
     ASSERTS_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "pRad is NULL");
     bool has11rFToDsEnabled = (pRad->IEEE80211rSupported && pAP->IEEE80211rEnable && pAP->IEEE80211rFTOverDSEnable);
     bool has11kNeighReportEnabled = (pRad->IEEE80211kSupported && pAP->IEEE80211kEnable);
-    char cmd[256] = {0};
-    uint8_t psd = 0;
     swl_rc_ne rc = SWL_RC_OK;
 
     if (has11rFToDsEnabled || has11kNeighReportEnabled) {
@@ -1583,17 +1759,11 @@ static swl_rc_ne s_whm_mxl_setNeighborPsd(T_AccessPoint* pAP, T_ApNeighbour* pAp
         ASSERT_NOT_NULL(pColocAP, SWL_RC_INVALID_PARAM, ME, "pColocAP is NULL");
         ASSERT_TRUE(wld_rad_is_6ghz(pColocAP->pRadio), SWL_RC_INVALID_PARAM, ME, "%s: Not a 6G neighbor", pColocAP->alias);
         ASSERT_TRUE(pApNeighbor->colocatedAp, SWL_RC_INVALID_PARAM, ME, "%s: Not a co-located neighbor AP", pColocAP->alias);
-        if (!swl_rc_isOk(s_getNeighborPsd(pColocAP, &psd))) {
+        /* the PSD is sent to hostapd once the 6G radio replied */
+        if (!swl_rc_isOk(s_getNeighborPsd(pAP, pColocAP, (swl_macBin_t*) pApNeighbor->bssid))) {
             SAH_TRACEZ_ERROR(ME, "s_getNeighborPsd failed");
             return SWL_RC_ERROR;
         }
-        /* Prepare message to hostapd */
-        swl_str_catFormat(cmd, sizeof(cmd), "SET_NEIGHBOR_PSD %s psd_subfield=%d",
-                                                swl_typeMacBin_toBuf32Ref((swl_macBin_t*) pApNeighbor->bssid).buf,
-                                                (psd & 0xff));
-        SAH_TRACEZ_INFO(ME, "sending cmd : %s", cmd);
-        bool ret = whm_mxl_hostapd_sendCommand(pAP, cmd, "set_neighbor_psd");
-        ASSERT_TRUE(ret, SWL_RC_ERROR, ME, "%s: set_neighbor_psd command failed", pAP->alias);
     }
 
     return rc;
@@ -0,0 +1,385 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : whm_mxl_vendorQueue.c                                 *
+*         Description  : Per radio queue of async vendor subcmd requests       *
+*                                                                              *
+*  *****************************************************************************/
+
+#include "swl/swl_common.h"
+
+#include "wld/wld.h"
+#include "wld/wld_util.h"
+#include "wld/wld_accesspoint.h"
+#include "wld/wld_nl80211_api.h"
+#include "wld/wld_rad_nl80211.h"
+#include "wld/wld_ap_nl80211.h"
+
+#include "whm_mxl_utils.h"
+#include "whm_mxl_rad.h"
+#include "whm_mxl_vap.h"
+#include "whm_mxl_vendorQueue.h"
+
+#include <vendor_cmds_copy.h>
+
+#define ME "mxlVq"
+
+typedef struct {
+    amxc_llist_it_t it;
+    whm_mxl_vendorQueue_t* pQueue;  /* NULL once the queue is gone */
+    T_Radio* pRad;
+    uint32_t seq;
+    char apName[IFNAMSIZ];          /* empty for a radio subcmd */
+    uint32_t subcmd;
+    bool expectReply;
+    size_t replySize;
+    uint32_t timeoutMs;
+    swl_timeSpecMono_t sendTs;
+    whm_mxl_vendorReqDone_f doneCb;
+    void* userData;
+    bool sent;                      /* moved to the in-flight list */
+    bool inSend;                    /* nl80211 send call in progress */
+    bool replied;                   /* nl80211 layer has called back */
+    bool expired;                   /* deadline passed before the nl80211 layer called back */
+    bool done;                      /* completion reported */
+    size_t dataLen;
+    uint8_t data[];
+} whm_mxl_vendorReq_t;
+
+static whm_mxl_vendorQueue_t* s_getQueue(T_Radio* pRad) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERTS_NOT_NULL(pRadVendor, NULL, ME, "NULL");
+    return &pRadVendor->vendorQueue;
+}
+
+static void s_pump(whm_mxl_vendorQueue_t* pQueue);
+
+/* Report the request outcome, and release its queue slot */
+static void s_completeReq(whm_mxl_vendorReq_t* pReq, swl_rc_ne rc, const whm_mxl_nlVendorView_t* pView) {
+    ASSERTS_FALSE(pReq->done, , ME, "request %u already done", pReq->seq);
+    pReq->done = true;
+    whm_mxl_vendorQueue_t* pQueue = pReq->pQueue;
+    if(pQueue != NULL) {
+        if(amxc_llist_it_is_in_list(&pReq->it) && !pReq->expired) {
+            amxc_llist_it_take(&pReq->it);
+            if(pReq->sent) {
+                pQueue->nrInFlight--;
+            } else {
+                pQueue->nrWaiting--;
+            }
+        }
+        if(rc < SWL_RC_OK) {
+            pQueue->nrFailed++;
+        } else {
+            swl_timeSpecMono_t now;
+            swl_timespec_getMono(&now);
+            uint32_t latencyMs = (uint32_t) SWL_MAX(swl_timespec_diffToMillisec(&pReq->sendTs, &now), (int64_t) 0);
+            pQueue->nrCompleted++;
+            pQueue->totalLatencyMs += latencyMs;
+            pQueue->lastLatencyMs = latencyMs;
+            pQueue->maxLatencyMs = SWL_MAX(pQueue->maxLatencyMs, latencyMs);
+        }
+    }
+    SAH_TRACEZ_INFO(ME, "%s: request %u subcmd %u done (%d)", pReq->pRad->Name, pReq->seq, pReq->subcmd, rc);
+    if(pReq->doneCb != NULL) {
+        pReq->doneCb(rc, pView, pReq->userData);
+    }
+    if(pQueue != NULL) {
+        s_pump(pQueue);
+    }
+}
+
+/*
+ * Reply handler given to the nl80211 layer: it is called once per sent request,
+ * with the driver reply or with the error / timeout of the nl80211 layer.
+ * The request is freed here, even when its deadline already expired:
+ * the nl80211 layer keeps a reference to it until then.
+ */
+static swl_rc_ne s_replyCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
+    whm_mxl_vendorReq_t* pReq = (whm_mxl_vendorReq_t*) priv;
+    ASSERT_NOT_NULL(pReq, SWL_RC_ERROR, ME, "NULL");
+    ASSERTS_FALSE(pReq->replied, SWL_RC_DONE, ME, "request %u already replied", pReq->seq);
+    pReq->replied = true;
+    if(pReq->expired) {
+        amxc_llist_it_take(&pReq->it);
+        if(pReq->pQueue != NULL) {
+            pReq->pQueue->nrExpired--;
+        }
+    }
+    if(!pReq->done) {
+        whm_mxl_nlVendorView_t view;
+        const whm_mxl_nlVendorView_t* pView = NULL;
+        swl_rc_ne ret = rc;
+        if((rc >= SWL_RC_OK) && pReq->expectReply) {
+            if(nlh == NULL) {
+                ret = SWL_RC_ERROR;
+            } else if(pReq->replySize > 0) {
+                ret = whm_mxl_nlVendor_getSizedReplyView(nlh, pReq->replySize, &view);
+            } else {
+                ret = whm_mxl_nlVendor_getReplyView(nlh, pReq->subcmd, &view);
+            }
+            pView = (ret == SWL_RC_OK) ? &view : NULL;
+        }
+        s_completeReq(pReq, ret, pView);
+    } else if(pReq->pQueue != NULL) {
+        pReq->pQueue->nrLateReplies++;
+    }
+    if(!pReq->inSend) {
+        free(pReq);
+    }
+    return SWL_RC_DONE;
+}
+
+static swl_rc_ne s_sendReq(whm_mxl_vendorReq_t* pReq) {
+    void* data = (pReq->dataLen > 0) ? pReq->data : NULL;
+    bool withAck = pReq->expectReply ? VENDOR_SUBCMD_IS_WITHOUT_ACK : VENDOR_SUBCMD_IS_WITH_ACK;
+    if(swl_str_isEmpty(pReq->apName)) {
+        return wld_rad_nl80211_sendVendorSubCmd(pReq->pRad, OUI_MXL, pReq->subcmd, data, pReq->dataLen,
+                                                VENDOR_SUBCMD_IS_ASYNC, withAck, 0, s_replyCb, pReq);
+    }
+    T_AccessPoint* pAP = wld_vap_from_name(pReq->apName);
+    ASSERTI_NOT_NULL(pAP, SWL_RC_INVALID_STATE, ME, "%s: AP gone", pReq->apName);
+    ASSERTI_TRUE(mxl_isApReadyToProcessVendorCmd(pAP), SWL_RC_INVALID_STATE, ME, "%s: AP not ready to process Vendor cmd", pReq->apName);
+    return wld_ap_nl80211_sendVendorSubCmd(pAP, OUI_MXL, pReq->subcmd, data, pReq->dataLen,
+                                           VENDOR_SUBCMD_IS_ASYNC, withAck, 0, s_replyCb, pReq);
+}
+
+static void s_armDeadlineTimer(whm_mxl_vendorQueue_t* pQueue) {
+    ASSERTS_NOT_NULL(pQueue->deadlineTimer, , ME, "NULL");
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    int64_t nextMs = -1;
+    amxc_llist_for_each(it, &pQueue->sentList) {
+        whm_mxl_vendorReq_t* pReq = amxc_llist_it_get_data(it, whm_mxl_vendorReq_t, it);
+        int64_t remainingMs = SWL_MAX((int64_t) pReq->timeoutMs - swl_timespec_diffToMillisec(&pReq->sendTs, &now), (int64_t) 0);
+        nextMs = (nextMs < 0) ? remainingMs : SWL_MIN(nextMs, remainingMs);
+    }
+    if(nextMs < 0) {
+        amxp_timer_stop(pQueue->deadlineTimer);
+        return;
+    }
+    amxp_timer_start(pQueue->deadlineTimer, (uint32_t) nextMs);
+}
+
+/* Send waiting requests while in-flight slots are available */
+static void s_pump(whm_mxl_vendorQueue_t* pQueue) {
+    while((pQueue->nrInFlight < pQueue->maxInFlight) && !amxc_llist_is_empty(&pQueue->waitList)) {
+        amxc_llist_it_t* it = amxc_llist_take_first(&pQueue->waitList);
+        whm_mxl_vendorReq_t* pReq = amxc_llist_it_get_data(it, whm_mxl_vendorReq_t, it);
+        pQueue->nrWaiting--;
+        amxc_llist_append(&pQueue->sentList, &pReq->it);
+        pQueue->nrInFlight++;
+        pReq->sent = true;
+        swl_timespec_getMono(&pReq->sendTs);
+
+        pReq->inSend = true;
+        swl_rc_ne rc = s_sendReq(pReq);
+        pReq->inSend = false;
+        if(pReq->replied) {
+            /* reply handled during the send call */
+            free(pReq);
+            continue;
+        }
+        if(rc < SWL_RC_OK) {
+            SAH_TRACEZ_ERROR(ME, "%s: fail to send request %u subcmd %u", pReq->pRad->Name, pReq->seq, pReq->subcmd);
+            s_completeReq(pReq, rc, NULL);
+            free(pReq);
+        }
+    }
+    s_armDeadlineTimer(pQueue);
+}
+
+static void s_deadline_th(amxp_timer_t* timer _UNUSED, void* userdata) {
+    T_Radio* pRad = (T_Radio*) userdata;
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    whm_mxl_vendorQueue_t* pQueue = s_getQueue(pRad);
+    ASSERT_NOT_NULL(pQueue, , ME, "NULL");
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    bool expired = true;
+    while(expired) {
+        expired = false;
+        amxc_llist_for_each(it, &pQueue->sentList) {
+            whm_mxl_vendorReq_t* pReq = amxc_llist_it_get_data(it, whm_mxl_vendorReq_t, it);
+            if(swl_timespec_diffToMillisec(&pReq->sendTs, &now) < (int64_t) pReq->timeoutMs) {
+                continue;
+            }
+            SAH_TRACEZ_WARNING(ME, "%s: request %u subcmd %u timed out after %u ms", pRad->Name, pReq->seq, pReq->subcmd, pReq->timeoutMs);
+            pQueue->nrTimeouts++;
+            /* the in-flight slot is released, the request stays allocated until the nl80211 layer calls back */
+            amxc_llist_it_take(&pReq->it);
+            pQueue->nrInFlight--;
+            pReq->expired = true;
+            amxc_llist_append(&pQueue->expiredList, &pReq->it);
+            pQueue->nrExpired++;
+            s_completeReq(pReq, SWL_RC_ERROR, NULL);
+            /* completion may have changed the list: restart the scan */
+            expired = true;
+            break;
+        }
+    }
+    s_pump(pQueue);
+}
+
+/**
+ * @brief Queue an async vendor subcmd request on the radio
+ *
+ * The request is sent as soon as an in-flight slot is free, and completes
+ * with the driver reply, an error, or when its deadline expires.
+ * The completion callback is never called from within this function.
+ *
+ * @param pRad radio
+ * @param pArgs request arguments, the payload is copied
+ * @param pSeq optional, filled with the request sequence number
+ * @return SWL_RC_OK when queued, SWL_RC_NOT_AVAILABLE when the queue is full, <= SWL_RC_ERROR otherwise
+ */
+swl_rc_ne whm_mxl_vendorQueue_send(T_Radio* pRad, const whm_mxl_vendorReqArgs_t* pArgs, uint32_t* pSeq) {
+    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(pArgs, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_FALSE((pArgs->dataLen > 0) && (pArgs->data == NULL), SWL_RC_INVALID_PARAM, ME, "no payload");
+    whm_mxl_vendorQueue_t* pQueue = s_getQueue(pRad);
+    ASSERT_NOT_NULL(pQueue, SWL_RC_INVALID_STATE, ME, "%s: no vendor queue", pRad->Name);
+    ASSERT_NOT_NULL(pQueue->deadlineTimer, SWL_RC_INVALID_STATE, ME, "%s: vendor queue not initialized", pRad->Name);
+    if((pQueue->nrWaiting + pQueue->nrInFlight) >= MXL_VENDOR_QUEUE_MAX_DEPTH) {
+        pQueue->nrRejected++;
+        SAH_TRACEZ_ERROR(ME, "%s: vendor queue full, drop subcmd %u", pRad->Name, pArgs->subcmd);
+        return SWL_RC_NOT_AVAILABLE;
+    }
+
+    whm_mxl_vendorReq_t* pReq = calloc(1, sizeof(whm_mxl_vendorReq_t) + pArgs->dataLen);
+    ASSERT_NOT_NULL(pReq, SWL_RC_ERROR, ME, "%s: fail to allocate vendor request", pRad->Name);
+    pReq->pQueue = pQueue;
+    pReq->pRad = pRad;
+    pReq->seq = ++pQueue->nextSeq;
+    if(pArgs->pAP != NULL) {
+        swl_str_copy(pReq->apName, sizeof(pReq->apName), pArgs->pAP->alias);
+    }
+    pReq->subcmd = pArgs->subcmd;
+    pReq->expectReply = pArgs->expectReply;
+    pReq->replySize = pArgs->replySize;
+    pReq->timeoutMs = pArgs->timeoutMs ? pArgs->timeoutMs : pQueue->timeoutMs;
+    pReq->doneCb = pArgs->doneCb;
+    pReq->userData = pArgs->userData;
+    pReq->dataLen = pArgs->dataLen;
+    if(pArgs->dataLen > 0) {
+        memcpy(pReq->data, pArgs->data, pArgs->dataLen);
+    }
+    /* the send time is reset when the request leaves the wait list */
+    swl_timespec_getMono(&pReq->sendTs);
+    amxc_llist_append(&pQueue->waitList, &pReq->it);
+    pQueue->nrWaiting++;
+    pQueue->nrQueued++;
+    pQueue->maxDepth = SWL_MAX(pQueue->maxDepth, pQueue->nrWaiting + pQueue->nrInFlight);
+    if(pSeq != NULL) {
+        *pSeq = pReq->seq;
+    }
+
+    /* send from the event loop, so that the caller never sees its completion re-entering */
+    amxp_timer_start(pQueue->deadlineTimer, 0);
+    return SWL_RC_OK;
+}
+
+void whm_mxl_vendorQueue_init(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    whm_mxl_vendorQueue_t* pQueue = s_getQueue(pRad);
+    ASSERT_NOT_NULL(pQueue, , ME, "NULL");
+    amxc_llist_init(&pQueue->waitList);
+    amxc_llist_init(&pQueue->sentList);
+    amxc_llist_init(&pQueue->expiredList);
+    pQueue->maxInFlight = MXL_VENDOR_QUEUE_DEF_MAX_IN_FLIGHT;
+    pQueue->timeoutMs = MXL_VENDOR_QUEUE_DEF_TIMEOUT_MS;
+    amxp_timer_new(&pQueue->deadlineTimer, s_deadline_th, pRad);
+}
+
+void whm_mxl_vendorQueue_deinit(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    whm_mxl_vendorQueue_t* pQueue = s_getQueue(pRad);
+    ASSERT_NOT_NULL(pQueue, , ME, "NULL");
+    amxp_timer_delete(&pQueue->deadlineTimer);
+    pQueue->deadlineTimer = NULL;
+    /* stop sending: completions must not refill the in-flight window */
+    pQueue->maxInFlight = 0;
+    amxc_llist_it_t* it;
+    while((it = amxc_llist_take_first(&pQueue->waitList)) != NULL) {
+        whm_mxl_vendorReq_t* pReq = amxc_llist_it_get_data(it, whm_mxl_vendorReq_t, it);
+        pQueue->nrWaiting--;
+        pReq->pQueue = NULL;
+        s_completeReq(pReq, SWL_RC_INVALID_STATE, NULL);
+        free(pReq);
+    }
+    while((it = amxc_llist_take_first(&pQueue->sentList)) != NULL) {
+        whm_mxl_vendorReq_t* pReq = amxc_llist_it_get_data(it, whm_mxl_vendorReq_t, it);
+        pQueue->nrInFlight--;
+        /* freed when the nl80211 layer calls back */
+        pReq->pQueue = NULL;
+        s_completeReq(pReq, SWL_RC_INVALID_STATE, NULL);
+    }
+    while((it = amxc_llist_take_first(&pQueue->expiredList)) != NULL) {
+        whm_mxl_vendorReq_t* pReq = amxc_llist_it_get_data(it, whm_mxl_vendorReq_t, it);
+        /* already completed, freed when the nl80211 layer calls back */
+        pReq->pQueue = NULL;
+    }
+    pQueue->nrExpired = 0;
+}
+
+static void s_setVendorQueueConf_ocf(void* priv _UNUSED, amxd_object_t* object, const amxc_var_t* const newParamValues _UNUSED) {
+    SAH_TRACEZ_IN(ME);
+    /* WiFi.Radio.{}.Vendor.VendorCmdQueue. */
+    amxd_object_t* radObj = amxd_object_get_parent(amxd_object_get_parent(object));
+    T_Radio* pRad = wld_rad_fromObj(radObj);
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    whm_mxl_vendorQueue_t* pQueue = s_getQueue(pRad);
+    ASSERT_NOT_NULL(pQueue, , ME, "NULL");
+    ASSERTI_NOT_NULL(pQueue->deadlineTimer, , ME, "%s: vendor queue not initialized", pRad->Name);
+
+    pQueue->maxInFlight = SWL_MAX(amxd_object_get_value(uint32_t, object, "MaxInFlight", NULL), 1U);
+    pQueue->timeoutMs = SWL_MAX(amxd_object_get_value(uint32_t, object, "Timeout", NULL), 1U);
+    SAH_TRACEZ_INFO(ME, "%s: vendor queue max in flight %u timeout %u ms", pRad->Name, pQueue->maxInFlight, pQueue->timeoutMs);
+    s_pump(pQueue);
+
+    SAH_TRACEZ_OUT(ME);
+}
+
+SWLA_DM_HDLRS(sVendorQueueDmHdlrs, ARR(), .objChangedCb = s_setVendorQueueConf_ocf);
+
+void _whm_mxl_vendorQueue_setConf_ocf(const char* const sig_name,
+                                      const amxc_var_t* const data,
+                                      void* const priv) {
+    swla_dm_procObjEvtOfLocalDm(&sVendorQueueDmHdlrs, sig_name, data, priv);
+}
+
+amxd_status_t _whm_mxl_vendorQueue_getStats(amxd_object_t* object,
+                                            amxd_function_t* func _UNUSED,
+                                            amxc_var_t* args _UNUSED,
+                                            amxc_var_t* retval) {
+    /* WiFi.Radio.{}.Vendor. */
+    T_Radio* pRad = wld_rad_fromObj(amxd_object_get_parent(object));
+    ASSERT_NOT_NULL(pRad, amxd_status_unknown_error, ME, "No Radio Mapped");
+    whm_mxl_vendorQueue_t* pQueue = s_getQueue(pRad);
+    ASSERT_NOT_NULL(pQueue, amxd_status_unknown_error, ME, "NULL");
+
+    amxc_var_set_type(retval, AMXC_VAR_ID_HTABLE);
+    amxc_var_add_key(uint32_t, retval, "Depth", pQueue->nrWaiting);
+    amxc_var_add_key(uint32_t, retval, "InFlight", pQueue->nrInFlight);
+    amxc_var_add_key(uint32_t, retval, "Expired", pQueue->nrExpired);
+    amxc_var_add_key(uint32_t, retval, "MaxDepth", pQueue->maxDepth);
+    amxc_var_add_key(uint32_t, retval, "MaxInFlight", pQueue->maxInFlight);
+    amxc_var_add_key(uint32_t, retval, "TimeoutMs", pQueue->timeoutMs);
+    amxc_var_add_key(uint64_t, retval, "Queued", pQueue->nrQueued);
+    amxc_var_add_key(uint64_t, retval, "Completed", pQueue->nrCompleted);
+    amxc_var_add_key(uint64_t, retval, "Failed", pQueue->nrFailed);
+    amxc_var_add_key(uint64_t, retval, "Timeouts", pQueue->nrTimeouts);
+    amxc_var_add_key(uint64_t, retval, "Rejected", pQueue->nrRejected);
+    amxc_var_add_key(uint64_t, retval, "LateReplies", pQueue->nrLateReplies);
+    amxc_var_add_key(uint32_t, retval, "LastLatencyMs", pQueue->lastLatencyMs);
+    amxc_var_add_key(uint32_t, retval, "MaxLatencyMs", pQueue->maxLatencyMs);
+    amxc_var_add_key(uint32_t, retval, "AvgLatencyMs", pQueue->nrCompleted ? (uint32_t) (pQueue->totalLatencyMs / pQueue->nrCompleted) : 0);
+    return amxd_status_ok;
+}
@@ -13,6 +13,9 @@
 *                                                                              *
 *  *****************************************************************************/
 
+#include <stdlib.h>
+#include <net/if.h>
+
 #include <swl/swl_common.h>
 
 #include "wld/wld.h"
@@ -59,96 +62,227 @@
  * NOTE: no more other stats (like RX or Bytes) available right now
  */
 
-swl_rc_ne mxl_getWmmStats(T_AccessPoint* pAP, T_Stats *stats, bool add)
-{
-    ASSERT_TRUE(stats, SWL_RC_INVALID_PARAM, ME, "Pointer to stats is NULL");
-    FILE *fp = fopen(WMM_QUEUE_FILE, "r");
-    ASSERT_NOT_NULL(fp, SWL_RC_ERROR, ME, "%s: Error opening file", pAP->alias);
-    char line[128] = {0}; /* lines are up to 85 chars long, so size 128 should be fine */
-    bool found_interface = false;
-    int i, num_entries;
-    swl_rc_ne rc = SWL_RC_ERROR;
-    char iface_marker[64] = {0};
-
-    snprintf(iface_marker, sizeof(iface_marker), "%s qos data:", pAP->alias);
-    while (fgets(line, sizeof(line), fp)) {
-        if (strstr(line, iface_marker)) {
-            found_interface = true;
+#define WMM_RLM_QUEUE_MARKER         "-rlm-"
+/* All APs polled within this window are served from the same debugfs snapshot */
+#define WMM_SNAPSHOT_VALIDITY_MS     500
+#define WMM_FILE_READ_CHUNK          4096
+
+typedef struct {
+    char ifname[IFNAMSIZ];
+    int queue[MAX_NUM_WMM_QUEUES]; /* indexed as WLD_AC_xx, default queue at last index */
+} mxl_wmmIfaceQueues_t;
+
+typedef struct {
+    int queue;
+    uint32_t txPackets;
+    uint32_t txPacketsFail;
+} mxl_wmmQueueStats_t;
+
+typedef struct {
+    char* buf;                          /* last read file content */
+    size_t bufSize;
+    uint32_t hash;                      /* hash of the parsed content */
+    void* entries;                      /* parsed table, sorted by key */
+    uint32_t nrEntries;
+    uint32_t maxEntries;
+} mxl_wmmFileCache_t;
+
+static mxl_wmmFileCache_t s_queueMapCache;
+static mxl_wmmFileCache_t s_queueStatsCache;
+static swl_timeSpecMono_t s_snapshotTime;
+static bool s_snapshotValid = false;
+
+static uint32_t s_hashContent(const char* buf, size_t len) {
+    uint32_t hash = 2166136261u; /* FNV-1a */
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t) buf[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* debugfs files do not report their size: read them in chunks into the cache buffer */
+static ssize_t s_readFile(const char* path, mxl_wmmFileCache_t* pCache) {
+    FILE* fp = fopen(path, "r");
+    ASSERT_NOT_NULL(fp, -1, ME, "Error opening file %s", path);
+    size_t len = 0;
+    while (true) {
+        if (pCache->bufSize < len + WMM_FILE_READ_CHUNK + 1) {
+            char* newBuf = realloc(pCache->buf, len + WMM_FILE_READ_CHUNK + 1);
+            if (newBuf == NULL) {
+                SAH_TRACEZ_ERROR(ME, "Fail to allocate buffer for %s", path);
+                fclose(fp);
+                return -1;
+            }
+            pCache->buf = newBuf;
+            pCache->bufSize = len + WMM_FILE_READ_CHUNK + 1;
+        }
+        size_t nread = fread(pCache->buf + len, 1, WMM_FILE_READ_CHUNK, fp);
+        len += nread;
+        if (nread < WMM_FILE_READ_CHUNK) {
             break;
         }
     }
+    fclose(fp);
+    pCache->buf[len] = '\0';
+    return len;
+}
 
-    if (!found_interface) {
-        SAH_TRACEZ_INFO(ME, "%s: Interface not found", pAP->alias);
-        rc = SWL_RC_OK; /* ToDo: num ifaces may be limited by platform, hence return OK? */
-        goto end;
+static void* s_addCacheEntry(mxl_wmmFileCache_t* pCache, size_t entrySize) {
+    if (pCache->nrEntries == pCache->maxEntries) {
+        uint32_t maxEntries = pCache->maxEntries ? (pCache->maxEntries * 2) : 16;
+        void* newEntries = realloc(pCache->entries, maxEntries * entrySize);
+        ASSERT_NOT_NULL(newEntries, NULL, ME, "Fail to allocate cache entries");
+        pCache->entries = newEntries;
+        pCache->maxEntries = maxEntries;
     }
+    void* pEntry = (uint8_t*) pCache->entries + (pCache->nrEntries * entrySize);
+    memset(pEntry, 0, entrySize);
+    pCache->nrEntries++;
+    return pEntry;
+}
+
+static int s_cmpIfaceQueues(const void* a, const void* b) {
+    return strcmp(((const mxl_wmmIfaceQueues_t*) a)->ifname, ((const mxl_wmmIfaceQueues_t*) b)->ifname);
+}
+
+static int s_cmpQueueStats(const void* a, const void* b) {
+    int qa = ((const mxl_wmmQueueStats_t*) a)->queue;
+    int qb = ((const mxl_wmmQueueStats_t*) b)->queue;
+    return (qa > qb) - (qa < qb);
+}
+
+static void s_parseQueueMap(mxl_wmmFileCache_t* pCache) {
+    char* savePtr = NULL;
+    char* line = strtok_r(pCache->buf, "\n", &savePtr);
+    pCache->nrEntries = 0;
 
-    /* Read 'Mark:' line */
-    if (!fgets(line, sizeof(line), fp)) {
-        SAH_TRACEZ_ERROR(ME, "%s: Error reading Mark line", pAP->alias);
-        goto end;
+    while (line != NULL) {
+        char* marker = strstr(line, " qos data:");
+        if (marker == NULL) {
+            line = strtok_r(NULL, "\n", &savePtr);
+            continue;
+        }
+        *marker = '\0';
+        char* ifname = line;
+        while (*ifname == ' ') {
+            ifname++;
+        }
+        /* Skip 'Mark:' line and read 'DP(q):' line */
+        char* markLine = strtok_r(NULL, "\n", &savePtr);
+        char* dpLine = (markLine != NULL) ? strtok_r(NULL, "\n", &savePtr) : NULL;
+        if (dpLine == NULL) {
+            SAH_TRACEZ_ERROR(ME, "%s: Error reading Mark / DP(q) lines", ifname);
+            break;
+        }
+        int queueNum[MAX_NUM_WMM_QUEUES] = {0};
+        int numEntries = sscanf(dpLine, "DP(q): %d %d %d %d %d", &queueNum[4], &queueNum[0],
+                                &queueNum[1], &queueNum[2], &queueNum[3]);
+        if (numEntries != MAX_NUM_WMM_QUEUES) {
+            SAH_TRACEZ_ERROR(ME, "%s: Error: Invalid DP(q) line format (%d)(%s)", ifname, numEntries, dpLine);
+        } else {
+            mxl_wmmIfaceQueues_t* pEntry = s_addCacheEntry(pCache, sizeof(mxl_wmmIfaceQueues_t));
+            if (pEntry != NULL) {
+                swl_str_copy(pEntry->ifname, sizeof(pEntry->ifname), ifname);
+                memcpy(pEntry->queue, queueNum, sizeof(pEntry->queue));
+            }
+        }
+        line = strtok_r(NULL, "\n", &savePtr);
     }
+    qsort(pCache->entries, pCache->nrEntries, sizeof(mxl_wmmIfaceQueues_t), s_cmpIfaceQueues);
+}
 
-    /* Read 'DP(q):' line */
-    if (!fgets(line, sizeof(line), fp)) {
-        SAH_TRACEZ_ERROR(ME, "%s: Error reading DP(q) line", pAP->alias);
-        goto end;
+static void s_parseQueueStats(mxl_wmmFileCache_t* pCache) {
+    char* savePtr = NULL;
+    char* line = strtok_r(pCache->buf, "\n", &savePtr);
+    pCache->nrEntries = 0;
+
+    for (; line != NULL; line = strtok_r(NULL, "\n", &savePtr)) {
+        char* marker = strstr(line, WMM_RLM_QUEUE_MARKER);
+        char* fieldEnd = strchr(line + 1, '|');
+        if ((line[0] != '|') || (marker == NULL) || (fieldEnd == NULL) || (marker > fieldEnd)) {
+            continue;
+        }
+        mxl_wmmQueueStats_t stats = {0};
+        stats.queue = atoi(marker + strlen(WMM_RLM_QUEUE_MARKER));
+        int numEntries = sscanf(line, "|%*[^|]|%*[^|]|%u |%u", &stats.txPackets, &stats.txPacketsFail);
+        if (numEntries != 2) {
+            SAH_TRACEZ_ERROR(ME, "Cannot extract statistics of queue %d", stats.queue);
+            continue;
+        }
+        mxl_wmmQueueStats_t* pEntry = s_addCacheEntry(pCache, sizeof(mxl_wmmQueueStats_t));
+        if (pEntry != NULL) {
+            *pEntry = stats;
+        }
     }
+    qsort(pCache->entries, pCache->nrEntries, sizeof(mxl_wmmQueueStats_t), s_cmpQueueStats);
+}
 
-    /* Check 'DP(q):' line format and get values */
-    int queu_num[MAX_NUM_WMM_QUEUES] = {0};
-    num_entries = sscanf(line, "DP(q): %d %d %d %d %d", &queu_num[4], &queu_num[0],
-                         &queu_num[1], &queu_num[2], &queu_num[3]);
-    if (num_entries != MAX_NUM_WMM_QUEUES) {
-        SAH_TRACEZ_ERROR(ME, "%s: Error: Invalid DP(q) line format (%d)(%s)", pAP->alias, num_entries, line);
-        goto end;
+/*
+ * Refresh the debugfs snapshot once per stats poll cycle.
+ * Mark-to-queue mapping is only re-parsed when its content changed.
+ */
+static swl_rc_ne s_refreshSnapshot(void) {
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    if (s_snapshotValid && (swl_timespec_diffToMillisec(&s_snapshotTime, &now) < WMM_SNAPSHOT_VALIDITY_MS)) {
+        return SWL_RC_OK;
     }
+    s_snapshotValid = false;
 
-    char wmm_marker[WLD_AC_MAX][16];
-    /* If default queue number mathes any WMM queue number, DP is not configured properly */
-    for (i = 0; i < SWL_MIN(WLD_AC_MAX, MAX_NUM_WMM_QUEUES); i++) {
-        if (queu_num[4] == queu_num[i]) {
-            SAH_TRACEZ_INFO(ME, "%s: Queues not configured?", pAP->alias);
-            rc = SWL_RC_OK; /* ToDo: return error after full platform integration? */
-            goto end;
-        }
-        snprintf(wmm_marker[i], sizeof(wmm_marker[i]), ")-rlm-%d", queu_num[i]);
+    ssize_t len = s_readFile(WMM_QUEUE_FILE, &s_queueMapCache);
+    ASSERT_TRUE(len >= 0, SWL_RC_ERROR, ME, "Fail to read queue mapping");
+    uint32_t hash = s_hashContent(s_queueMapCache.buf, len);
+    if ((hash != s_queueMapCache.hash) || (s_queueMapCache.entries == NULL)) {
+        SAH_TRACEZ_INFO(ME, "Queue mapping changed - reparse");
+        s_queueMapCache.hash = hash;
+        s_parseQueueMap(&s_queueMapCache);
     }
-    fclose(fp);
 
-    /* Get the actual statistics */
-    fp = fopen(WMM_STATS_FILE, "r");
-    ASSERT_NOT_NULL(fp, SWL_RC_ERROR, ME, "%s: Error opening file", pAP->alias);
-
-    uint32_t tx_packets;
-    uint32_t tx_packets_fail;
-    while (fgets(line, sizeof(line), fp)) {
-        for (i = 0; i < WLD_AC_MAX; i++) {
-            if (!strstr(line, wmm_marker[i]))
-                continue;
-
-            num_entries = sscanf(line, "|%*[^|]|%*[^|]|%u |%u", &tx_packets, &tx_packets_fail);
-            if (num_entries != 2) {
-                SAH_TRACEZ_ERROR(ME, "%s: Cannot extract %d statistics", pAP->alias, i);
-                goto end;
-            }
+    len = s_readFile(WMM_STATS_FILE, &s_queueStatsCache);
+    ASSERT_TRUE(len >= 0, SWL_RC_ERROR, ME, "Fail to read queue statistics");
+    s_parseQueueStats(&s_queueStatsCache);
 
-            if (add) {
-                stats->WmmPacketsSent[i] += tx_packets;
-                stats->WmmFailedSent[i] += tx_packets_fail;
-            }
-            else {
-                stats->WmmPacketsSent[i] = tx_packets;
-                stats->WmmFailedSent[i] = tx_packets_fail;
-            }
+    s_snapshotTime = now;
+    s_snapshotValid = true;
+    return SWL_RC_OK;
+}
+
+swl_rc_ne mxl_getWmmStats(T_AccessPoint* pAP, T_Stats *stats, bool add)
+{
+    ASSERT_TRUE(stats, SWL_RC_INVALID_PARAM, ME, "Pointer to stats is NULL");
+    ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
+    swl_rc_ne rc = s_refreshSnapshot();
+    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: Error reading WMM statistics", pAP->alias);
+
+    mxl_wmmIfaceQueues_t key;
+    swl_str_copy(key.ifname, sizeof(key.ifname), pAP->alias);
+    mxl_wmmIfaceQueues_t* pQueues = bsearch(&key, s_queueMapCache.entries, s_queueMapCache.nrEntries,
+                                            sizeof(mxl_wmmIfaceQueues_t), s_cmpIfaceQueues);
+    /* ToDo: num ifaces may be limited by platform, hence return OK? */
+    ASSERTI_NOT_NULL(pQueues, SWL_RC_OK, ME, "%s: Interface not found", pAP->alias);
+
+    /* If default queue number mathes any WMM queue number, DP is not configured properly */
+    for (int i = 0; i < SWL_MIN(WLD_AC_MAX, MAX_NUM_WMM_QUEUES); i++) {
+        /* ToDo: return error after full platform integration? */
+        ASSERTI_NOT_EQUALS(pQueues->queue[4], pQueues->queue[i], SWL_RC_OK, ME, "%s: Queues not configured?", pAP->alias);
+    }
+
+    for (int i = 0; i < WLD_AC_MAX; i++) {
+        mxl_wmmQueueStats_t qKey = {.queue = pQueues->queue[i]};
+        mxl_wmmQueueStats_t* pQStats = bsearch(&qKey, s_queueStatsCache.entries, s_queueStatsCache.nrEntries,
+                                               sizeof(mxl_wmmQueueStats_t), s_cmpQueueStats);
+        if (pQStats == NULL) {
+            continue;
+        }
+        if (add) {
+            stats->WmmPacketsSent[i] += pQStats->txPackets;
+            stats->WmmFailedSent[i] += pQStats->txPacketsFail;
+        } else {
+            stats->WmmPacketsSent[i] = pQStats->txPackets;
+            stats->WmmFailedSent[i] = pQStats->txPacketsFail;
         }
     }
 
-    fclose(fp);
     return SWL_RC_OK;
-
-end:
-    fclose(fp);
-    return rc;
 }
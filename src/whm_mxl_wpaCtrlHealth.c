@@ -0,0 +1,163 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : whm_mxl_wpaCtrlHealth.c                               *
+*         Description  : Per interface wpa ctrl socket reconnection            *
+*                                                                              *
+*  *****************************************************************************/
+
+#include "swl/swl_common.h"
+#include "wld/wld.h"
+#include "wld/wld_accesspoint.h"
+#include "wld/wld_wpaCtrl_api.h"
+#include "wld/wld_wpaCtrlInterface.h"
+
+#include "whm_mxl_wpaCtrlHealth.h"
+#include "whm_mxl_rad.h"
+#include "whm_mxl_vap.h"
+#include "whm_mxl_utils.h"
+
+#define ME "mxlCtrl"
+
+#define MXL_WPA_CTRL_BACKOFF_MIN_MS    100
+#define MXL_WPA_CTRL_BACKOFF_MAX_MS    10000
+
+static void s_resetHealth(whm_mxl_wpaCtrlHealth_t* pHealth) {
+    pHealth->stale = false;
+    pHealth->nrFailures = 0;
+    pHealth->backoffMs = 0;
+}
+
+/*
+ * Reopen the ctrl socket of one VAP, when its backoff delay expired.
+ * Returns true when the socket is ready.
+ */
+static bool s_reconnectAp(T_AccessPoint* pAP, whm_mxl_wpaCtrlHealth_t* pHealth, swl_timeSpecMono_t* pNow) {
+    if (wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface)) {
+        s_resetHealth(pHealth);
+        return true;
+    }
+    if (pHealth->stale && (swl_timespec_diffToMillisec(&pHealth->lastAttemptTs, pNow) < pHealth->backoffMs)) {
+        /* still in backoff */
+        return false;
+    }
+    pHealth->stale = true;
+    pHealth->lastAttemptTs = *pNow;
+    pHealth->nrAttempts++;
+    SAH_TRACEZ_NOTICE(ME, "%s: reopening wpa ctrl socket (attempt %u)", pAP->alias, pHealth->nrFailures + 1);
+    wld_wpaCtrlInterface_setEnable(pAP->wpaCtrlInterface, true);
+    if (wld_wpaCtrlInterface_open(pAP->wpaCtrlInterface)) {
+        pHealth->nrReconnects++;
+        s_resetHealth(pHealth);
+        /* Update state because we might have missed events while socket was disconnected */
+        wld_vap_updateState(pAP);
+        return true;
+    }
+    pHealth->nrFailures++;
+    pHealth->backoffMs = pHealth->backoffMs ? SWL_MIN(pHealth->backoffMs * 2, (uint32_t) MXL_WPA_CTRL_BACKOFF_MAX_MS) : MXL_WPA_CTRL_BACKOFF_MIN_MS;
+    SAH_TRACEZ_INFO(ME, "%s: wpa ctrl socket not ready, next attempt in %u ms", pAP->alias, pHealth->backoffMs);
+    return false;
+}
+
+static void s_armRetryTimer(T_Radio* pRad, mxl_VendorData_t* pRadVendor, uint32_t delayMs) {
+    ASSERT_NOT_NULL(pRadVendor->ctrlRetryTimer, , ME, "%s: no ctrl retry timer", pRad->Name);
+    amxp_timer_state_t state = pRadVendor->ctrlRetryTimer->state;
+    if ((state == amxp_timer_running) || (state == amxp_timer_started)) {
+        if (amxp_timer_remaining_time(pRadVendor->ctrlRetryTimer) <= delayMs) {
+            return;
+        }
+    }
+    amxp_timer_start(pRadVendor->ctrlRetryTimer, delayMs);
+}
+
+/**
+ * @brief Reopen the wpa ctrl sockets of the radio VAPs that are not ready
+ *
+ * Only stale sockets are reopened: sockets of healthy VAPs, and their event
+ * subscriptions, are left untouched. Failed reopens are retried with an
+ * exponential backoff, from a radio timer, which checks all VAPs.
+ *
+ * @param pRad radio
+ * @param withDummyVap also check the dummy VAP socket: the reconf sync skips it,
+ *                     as hostapd does not re-create it on reconf
+ * @return SWL_RC_OK when all sockets are ready, SWL_RC_CONTINUE when some are still stale,
+ *         SWL_RC_ERROR when hostapd is not running
+ */
+swl_rc_ne whm_mxl_wpaCtrlHealth_reconnectStale(T_Radio* pRad, bool withDummyVap) {
+    ASSERT_NOT_NULL(pRad, SWL_RC_ERROR, ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, SWL_RC_ERROR, ME, "pRadVendor is NULL");
+    ASSERTS_TRUE(wld_secDmn_isRunning(pRad->hostapd), SWL_RC_ERROR, ME, "%s: hostapd not running", pRad->Name);
+
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    int64_t nextRetryMs = -1;
+    T_AccessPoint* pAP = NULL;
+    wld_rad_forEachAp(pAP, pRad) {
+        if ((pAP == NULL) || (!withDummyVap && whm_mxl_utils_isDummyVap(pAP))) {
+            continue;
+        }
+        mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+        if (pVapVendor == NULL) {
+            continue;
+        }
+        whm_mxl_wpaCtrlHealth_t* pHealth = &pVapVendor->ctrlHealth;
+        if (s_reconnectAp(pAP, pHealth, &now)) {
+            continue;
+        }
+        int64_t retryMs = SWL_MAX(pHealth->backoffMs - swl_timespec_diffToMillisec(&pHealth->lastAttemptTs, &now), (int64_t) 0);
+        nextRetryMs = (nextRetryMs < 0) ? retryMs : SWL_MIN(nextRetryMs, retryMs);
+    }
+    ASSERTS_TRUE(nextRetryMs >= 0, SWL_RC_OK, ME, "%s: all wpa ctrl sockets ready", pRad->Name);
+    s_armRetryTimer(pRad, pRadVendor, (uint32_t) nextRetryMs);
+    return SWL_RC_CONTINUE;
+}
+
+static void s_ctrlRetry_th(amxp_timer_t* timer _UNUSED, void* userdata) {
+    T_Radio* pRad = (T_Radio*) userdata;
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    whm_mxl_wpaCtrlHealth_reconnectStale(pRad, true);
+}
+
+void whm_mxl_wpaCtrlHealth_init(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    amxp_timer_new(&pRadVendor->ctrlRetryTimer, s_ctrlRetry_th, pRad);
+}
+
+void whm_mxl_wpaCtrlHealth_deinit(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pRad);
+    ASSERT_NOT_NULL(pRadVendor, , ME, "pRadVendor is NULL");
+    amxp_timer_delete(&pRadVendor->ctrlRetryTimer);
+    pRadVendor->ctrlRetryTimer = NULL;
+}
+
+void whm_mxl_wpaCtrlHealth_toVar(T_Radio* pRad, amxc_var_t* pMap) {
+    ASSERTS_NOT_NULL(pMap, , ME, "NULL");
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    T_AccessPoint* pAP = NULL;
+    amxc_var_set_type(pMap, AMXC_VAR_ID_HTABLE);
+    wld_rad_forEachAp(pAP, pRad) {
+        mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+        if (pVapVendor == NULL) {
+            continue;
+        }
+        whm_mxl_wpaCtrlHealth_t* pHealth = &pVapVendor->ctrlHealth;
+        amxc_var_t* pApMap = amxc_var_add_key(amxc_htable_t, pMap, pAP->alias, NULL);
+        amxc_var_add_key(bool, pApMap, "Ready", wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface));
+        amxc_var_add_key(bool, pApMap, "Stale", pHealth->stale);
+        amxc_var_add_key(uint32_t, pApMap, "Failures", pHealth->nrFailures);
+        amxc_var_add_key(uint32_t, pApMap, "BackoffMs", pHealth->backoffMs);
+        amxc_var_add_key(uint32_t, pApMap, "Attempts", pHealth->nrAttempts);
+        amxc_var_add_key(uint32_t, pApMap, "Reconnects", pHealth->nrReconnects);
+    }
+}
@@ -34,6 +34,8 @@
 #include "whm_mxl_utils.h"
 #include "whm_mxl_rad.h"
 #include "whm_mxl_cfgActions.h"
+#include "whm_mxl_nlVendor.h"
+#include "whm_mxl_vendorQueue.h"
 
 #include <vendor_cmds_copy.h>
 
@@ -41,49 +43,129 @@
 
 static T_Radio* s_pZwDfsRad = NULL;
 
-static swl_rc_ne s_getZwDfsAntennaCb(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv) {
-    ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "request error");
-    ASSERT_NOT_NULL(nlh, SWL_RC_ERROR, ME, "NULL");
+static int s_zwdfsSwitchChannel(wld_startBgdfsArgs_t* args);
+
+/* ZwDfs antenna update: read the antenna state, set it when different, then optionally switch the ZwDfs channel */
+typedef struct {
+    T_Radio* pRad;                  /* radio requesting the update */
+    uint8_t enable;
+    bool switchChan;                /* switch the ZwDfs radio channel once the antenna is set */
+    wld_startBgdfsArgs_t args;
+} whm_mxl_zwdfsAntReq_t;
+
+/*
+ * The update chain goes through the vendor queue of the ZwDfs radio, with one request in flight at a time.
+ * A start or stop coming while a chain runs is applied once it ends: the last one wins,
+ * so a stop never interleaves with a start.
+ */
+typedef struct {
+    bool busy;                      /* a request of the chain is in flight */
+    bool hasNext;                   /* update requested while busy */
+    whm_mxl_zwdfsAntReq_t cur;
+    whm_mxl_zwdfsAntReq_t next;
+} whm_mxl_zwdfsAntChain_t;
+
+static whm_mxl_zwdfsAntChain_t s_antChain;
+
+static swl_rc_ne s_runZwDfsAntChain(void);
+
+/* BG DFS start failing once accepted: report the end of the clear to pwhm */
+static void s_failZwDfsSwitch(whm_mxl_zwdfsAntReq_t* pReq) {
+    ASSERTS_TRUE(pReq->switchChan, , ME, "no BG DFS start");
+    ASSERTS_NOT_NULL(pReq->pRad, , ME, "NULL");
+    SAH_TRACEZ_ERROR(ME, "%s: fail to start ZwDfs on chan %u/%u", pReq->pRad->Name, pReq->args.channel, pReq->args.bandwidth);
+    wld_bgdfs_notifyClearEnded(pReq->pRad, DFS_RESULT_OTHER);
+}
 
-    struct genlmsghdr* gnlh = (struct genlmsghdr*) nlmsg_data(nlh);
-    ASSERT_EQUALS(gnlh->cmd, NL80211_CMD_VENDOR, SWL_RC_OK, ME, "unexpected cmd %d", gnlh->cmd);
+static void s_endZwDfsAntChain(void) {
+    s_antChain.busy = false;
+    ASSERTS_TRUE(s_antChain.hasNext, , ME, "no ZwDfs antenna update pending");
+    s_antChain.hasNext = false;
+    s_antChain.cur = s_antChain.next;
+    if(s_runZwDfsAntChain() < SWL_RC_OK) {
+        s_failZwDfsSwitch(&s_antChain.cur);
+    }
+}
 
-    uint32_t* bgDfsEnable = (uint32_t*) priv;
+static void s_setZwDfsAntennaDone(swl_rc_ne rc, const whm_mxl_nlVendorView_t* pView _UNUSED, void* userData _UNUSED) {
+    whm_mxl_zwdfsAntReq_t* pReq = &s_antChain.cur;
+    if(rc < SWL_RC_OK) {
+        SAH_TRACEZ_ERROR(ME, "fail to %s ZwDfs antenna (%d)", pReq->enable ? "enable" : "disable", rc);
+        s_failZwDfsSwitch(pReq);
+    } else if(pReq->switchChan && (s_zwdfsSwitchChannel(&pReq->args) < SWL_RC_OK)) {
+        s_failZwDfsSwitch(pReq);
+    }
+    s_endZwDfsAntChain();
+}
 
-    struct nlattr* tb[NL80211_ATTR_MAX + 1] = {};
-    if(nla_parse(tb, NL80211_ATTR_MAX, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL)) {
-        SAH_TRACEZ_ERROR(ME, "failed to parse netlink message");
-        return SWL_RC_ERROR;
+static void s_getZwDfsAntennaDone(swl_rc_ne rc, const whm_mxl_nlVendorView_t* pView, void* userData _UNUSED) {
+    whm_mxl_zwdfsAntReq_t* pReq = &s_antChain.cur;
+    if((rc < SWL_RC_OK) || (pView == NULL) || (s_pZwDfsRad == NULL)) {
+        SAH_TRACEZ_ERROR(ME, "fail to get ZwDfs antenna state (%d)", rc);
+        s_failZwDfsSwitch(pReq);
+        s_endZwDfsAntChain();
+        return;
+    }
+    uint32_t bgDfsEnable = *WHM_MXL_NL_VENDOR_VIEW(pView, uint32_t);
+    SAH_TRACEZ_INFO(ME, "ZwDfs antenna is currently %s", bgDfsEnable ? "enabled" : "disabled");
+    if(bgDfsEnable == pReq->enable) {
+        SAH_TRACEZ_INFO(ME, "%s: ZwDfs antenna is already %s", s_pZwDfsRad->Name, pReq->enable ? "enabled" : "disabled");
+        s_setZwDfsAntennaDone(SWL_RC_OK, NULL, NULL);
+        return;
     }
-    ASSERT_NOT_NULL(tb[NL80211_ATTR_VENDOR_DATA], SWL_RC_ERROR, ME, "NULL");
-    *bgDfsEnable = nla_get_u32(tb[NL80211_ATTR_VENDOR_DATA]);
 
-    SAH_TRACEZ_INFO(ME, "ZwDfs antenna is currently %s", *bgDfsEnable ? "enabled" : "disabled");
-    return rc;
+    SAH_TRACEZ_INFO(ME, "%s: %s ZwDfs antenna", s_pZwDfsRad->Name, pReq->enable ? "Enable" : "Disable");
+    whm_mxl_vendorReqArgs_t args = {
+        .subcmd = LTQ_NL80211_VENDOR_SUBCMD_SET_ZWDFS_ANT,
+        .data = &pReq->enable,
+        .dataLen = sizeof(uint8_t),
+        .doneCb = s_setZwDfsAntennaDone,
+    };
+    rc = whm_mxl_vendorQueue_send(s_pZwDfsRad, &args, NULL);
+    if(rc < SWL_RC_OK) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to queue ZwDfs antenna update", s_pZwDfsRad->Name);
+        s_failZwDfsSwitch(pReq);
+        s_endZwDfsAntChain();
+    }
 }
 
-static swl_rc_ne s_getZwDfsAntenna(uint32_t* bgDfsEnable) {
+static swl_rc_ne s_runZwDfsAntChain(void) {
     ASSERT_NOT_NULL(s_pZwDfsRad, WLD_ERROR_INVALID_PARAM, ME, "ZwDfs radio NULL");
-    uint32_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_ZWDFS_ANT;
-    return wld_rad_nl80211_sendVendorSubCmd(s_pZwDfsRad, OUI_MXL, subcmd, NULL, 0,
-                                            VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, s_getZwDfsAntennaCb, bgDfsEnable);
+    whm_mxl_vendorReqArgs_t args = {
+        .subcmd = LTQ_NL80211_VENDOR_SUBCMD_GET_ZWDFS_ANT,
+        .expectReply = true,
+        .replySize = sizeof(uint32_t),
+        .doneCb = s_getZwDfsAntennaDone,
+    };
+    swl_rc_ne rc = whm_mxl_vendorQueue_send(s_pZwDfsRad, &args, NULL);
+    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: fail to queue ZwDfs antenna read", s_pZwDfsRad->Name);
+    s_antChain.busy = true;
+    return rc;
 }
 
-static swl_rc_ne s_setZwDfsAntenna(uint8_t enable) {
+/*
+ * Update the ZwDfs antenna, then optionally switch the ZwDfs channel.
+ * The requests are queued, so the antenna is updated after this function returns.
+ */
+static swl_rc_ne s_setZwDfsAntenna(T_Radio* pRad, uint8_t enable, const wld_startBgdfsArgs_t* pSwitchArgs) {
     ASSERT_NOT_NULL(s_pZwDfsRad, WLD_ERROR_INVALID_PARAM, ME, "ZwDfs radio NULL");
-    uint32_t bgDfsEnable = 0;
-    swl_rc_ne rc = s_getZwDfsAntenna(&bgDfsEnable);
-    ASSERT_FALSE((rc <= SWL_RC_ERROR), rc, ME, "request error");
-    ASSERT_TRUE(bgDfsEnable != enable, rc, ME, "%s: ZwDfs antenna is already %s", s_pZwDfsRad->Name, enable ? "enabled" : "disabled");
-
-    SAH_TRACEZ_INFO(ME, "%s: %s ZwDfs antenna", s_pZwDfsRad->Name, enable ? "Enable" : "Disable");
-    uint8_t subcmd = LTQ_NL80211_VENDOR_SUBCMD_SET_ZWDFS_ANT;
-    return wld_rad_nl80211_sendVendorSubCmd(s_pZwDfsRad, OUI_MXL, subcmd, &enable, sizeof(uint8_t),
-                                            VENDOR_SUBCMD_IS_SYNC, VENDOR_SUBCMD_IS_WITHOUT_ACK, 0, NULL, NULL);
+    whm_mxl_zwdfsAntReq_t req = {.pRad = pRad, .enable = enable};
+    if(pSwitchArgs != NULL) {
+        req.switchChan = true;
+        req.args = *pSwitchArgs;
+    }
+    if(s_antChain.busy) {
+        SAH_TRACEZ_INFO(ME, "%s: ZwDfs antenna %s once the current update ends", s_pZwDfsRad->Name, enable ? "enable" : "disable");
+        s_antChain.next = req;
+        s_antChain.hasNext = true;
+        return SWL_RC_OK;
+    }
+    s_antChain.cur = req;
+    return s_runZwDfsAntChain();
 }
 
-int whm_mxl_rad_bgDfsEnable(T_Radio* pRad _UNUSED, int enable) {
-    int rc = s_setZwDfsAntenna(enable);
+int whm_mxl_rad_bgDfsEnable(T_Radio* pRad, int enable) {
+    int rc = s_setZwDfsAntenna(pRad, enable, NULL);
 
     /* In case BackgroundCac is enabled and PreclearEnable parameter enabled by user (no protection in this case), disable BackgroundCac */
     amxd_object_t* pVendorObj =  amxd_object_findf(pRad->pBus, "Vendor");
@@ -100,7 +182,8 @@ int whm_mxl_rad_bgDfsEnable(T_Radio* pRad _UNUSED, int enable) {
     return rc;
 }
 
-static int s_zwdfsSwitchChannel(wld_startBgdfsArgs_t* args) {
+/* Whether the ZwDfs radio can start a BG CAC on the given channel */
+static swl_rc_ne s_checkZwDfsSwitch(const wld_startBgdfsArgs_t* args) {
     ASSERT_NOT_NULL(s_pZwDfsRad, WLD_ERROR_INVALID_PARAM, ME, "ZwDfs radio NULL");
     ASSERT_TRUE(wld_channel_is_dfs_band(args->channel, args->bandwidth), SWL_RC_ERROR, ME,
                 "%s chan %u/%u not dfs", s_pZwDfsRad->Name, args->channel, args->bandwidth);
@@ -108,6 +191,12 @@ static int s_zwdfsSwitchChannel(wld_startBgdfsArgs_t* args) {
                 "%s: hapd not running", s_pZwDfsRad->Name);
     ASSERT_TRUE(wld_wpaCtrlMngr_ping(s_pZwDfsRad->hostapd->wpaCtrlMngr), SWL_RC_INVALID_STATE, ME,
                 "%s: hapd not ready", s_pZwDfsRad->Name);
+    return SWL_RC_OK;
+}
+
+static int s_zwdfsSwitchChannel(wld_startBgdfsArgs_t* args) {
+    swl_rc_ne rc = s_checkZwDfsSwitch(args);
+    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "ZwDfs channel switch not possible");
 
     /* following the initial requirement, CHAN_SWITCH is needed to start BG CAC using the ZW DFS radio */
     s_pZwDfsRad->channelChangeReason = CHAN_REASON_MANUAL;
@@ -121,23 +210,30 @@ static int s_zwdfsSwitchChannel(wld_startBgdfsArgs_t* args) {
     return wld_rad_hostapd_switchChannel(s_pZwDfsRad);
 }
 
+/*
+ * The start is checked upfront, so that its result is reported to the caller,
+ * as the channel switch only happens once the antenna is enabled.
+ * A later failure ends the BG DFS clear.
+ */
 static swl_rc_ne s_bgDfsStart(T_Radio* pRad, int channel, wld_startBgdfsArgs_t* args) {
     SAH_TRACEZ_INFO(ME, "%s: ZwDfs started", pRad->Name);
-    swl_rc_ne rc = s_setZwDfsAntenna(1);
-    ASSERT_EQUALS(rc, SWL_RC_OK, rc, ME, "fail to enable zwdfs antenna");
-
-    if(args) {
-        return s_zwdfsSwitchChannel(args);
-    }
     wld_startBgdfsArgs_t dfsArgs;
-    dfsArgs.channel = channel;
-    dfsArgs.bandwidth = swl_bandwidth_defaults[pRad->operatingFrequencyBand];
-    return s_zwdfsSwitchChannel(&dfsArgs);
+    if(args != NULL) {
+        dfsArgs = *args;
+    } else {
+        dfsArgs.channel = channel;
+        dfsArgs.bandwidth = swl_bandwidth_defaults[pRad->operatingFrequencyBand];
+    }
+    swl_rc_ne rc = s_checkZwDfsSwitch(&dfsArgs);
+    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "%s: ZwDfs can not start", pRad->Name);
+    rc = s_setZwDfsAntenna(pRad, 1, &dfsArgs);
+    ASSERT_EQUALS(rc, SWL_RC_OK, rc, ME, "fail to enable zwdfs antenna");
+    return SWL_RC_OK;
 }
 
 static swl_rc_ne s_bgDfsStop(T_Radio* pRad) {
     SAH_TRACEZ_INFO(ME, "%s: ZwDfs stopped", pRad->Name);
-    s_setZwDfsAntenna(0);
+    s_setZwDfsAntenna(pRad, 0, NULL);
     return SWL_RC_DONE;
 }
 
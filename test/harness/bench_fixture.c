@@ -0,0 +1,226 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : bench_fixture.c                                       *
+*         Description  : In memory radio, APs and stations of the harness      *
+*                                                                              *
+*  *****************************************************************************/
+
+/*
+ * The fixture builds the radio, AP and station contexts the module works on,
+ * without the pwhm data model: only the fields read by the benchmarked paths are set.
+ * Each AP gets a fake hostapd ctrl socket under the run directory,
+ * and its wpaCtrlInterface is a client of that socket (see mock_wld.c).
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "swl/swl_common.h"
+#include "wld/wld.h"
+#include "wld/wld_radio.h"
+#include "wld/wld_accesspoint.h"
+#include "wld/wld_assocdev.h"
+
+#include "whm_mxl_rad.h"
+#include "whm_mxl_vap.h"
+#include "whm_mxl_vendorQueue.h"
+#include "whm_mxl_reconfMngr.h"
+#include "whm_mxl_hapdConf.h"
+
+#include "bench_fixture.h"
+
+#define ME "benchFx"
+
+static bench_fixture_t* s_pCurFx = NULL;
+
+bench_fixture_t* bench_fixture_get(void) {
+    return s_pCurFx;
+}
+
+static T_AccessPoint* s_createAp(bench_fixture_t* pFx, uint32_t idx, uint32_t hapdLatencyUs) {
+    T_AccessPoint* pAP = calloc(1, sizeof(T_AccessPoint));
+    ASSERT_NOT_NULL(pAP, NULL, ME, "NULL");
+    T_SSID* pSSID = calloc(1, sizeof(T_SSID));
+    mxl_VapVendorData_t* pVapVendor = calloc(1, sizeof(mxl_VapVendorData_t));
+    pFx->aps[idx] = pAP;
+    pFx->ssids[idx] = pSSID;
+    ASSERT_NOT_NULL(pSSID, NULL, ME, "NULL");
+    ASSERT_NOT_NULL(pVapVendor, NULL, ME, "NULL");
+
+    if(idx == 0) {
+        swl_str_copy(pAP->alias, sizeof(pAP->alias), pFx->pRad->Name);
+    } else {
+        snprintf(pAP->alias, sizeof(pAP->alias), "%s.%u", pFx->pRad->Name, idx);
+    }
+    swl_str_copy(pSSID->Name, sizeof(pSSID->Name), pAP->alias);
+    swl_str_copy(pSSID->SSID, sizeof(pSSID->SSID), "mxl-bench");
+    pAP->pSSID = pSSID;
+    pAP->pRadio = pFx->pRad;
+    pAP->index = BENCH_AP_INDEX_BASE + idx;
+    pAP->enable = true;
+    pAP->vendorData = pVapVendor;
+    pVapVendor->mloId = -1;
+    amxc_var_init(&pVapVendor->cfgShadow);
+    amxc_var_set_type(&pVapVendor->cfgShadow, AMXC_VAR_ID_HTABLE);
+    amxc_llist_append(&pFx->pRad->llAP, &pAP->it);
+
+    char sockPath[192] = {0};
+    snprintf(sockPath, sizeof(sockPath), "%s/%s", pFx->runDir, pAP->alias);
+    pFx->hapds[idx] = fake_hostapd_start(sockPath, hapdLatencyUs);
+    ASSERT_NOT_NULL(pFx->hapds[idx], NULL, ME, "%s: fail to start fake hostapd", pAP->alias);
+    pAP->wpaCtrlInterface = (wld_wpaCtrlInterface_t*) fake_hostapd_connect(sockPath);
+    ASSERT_NOT_NULL(pAP->wpaCtrlInterface, NULL, ME, "%s: fail to connect fake hostapd", pAP->alias);
+    return pAP;
+}
+
+static swl_rc_ne s_createStations(bench_fixture_t* pFx, T_AccessPoint* pAP, uint32_t nrStations) {
+    pFx->stations = calloc(SWL_MAX(nrStations, 1u), sizeof(T_AssociatedDevice*));
+    ASSERT_NOT_NULL(pFx->stations, SWL_RC_ERROR, ME, "NULL");
+    for(uint32_t i = 0; i < nrStations; i++) {
+        T_AssociatedDevice* pAD = calloc(1, sizeof(T_AssociatedDevice));
+        ASSERT_NOT_NULL(pAD, SWL_RC_ERROR, ME, "NULL");
+        pFx->stations[i] = pAD;
+        pFx->nrStations++;
+        unsigned char mac[ETHER_ADDR_LEN] = {0x02, 0x00, 0x5e, 0x10, (unsigned char) (i >> 8), (unsigned char) i};
+        memcpy(pAD->MACAddress, mac, ETHER_ADDR_LEN);
+        snprintf(pAD->Name, sizeof(pAD->Name), "sta%u", i);
+        pAD->Active = true;
+    }
+    pAP->AssociatedDevice = pFx->stations;
+    pAP->AssociatedDeviceNumberOfEntries = (int) nrStations;
+    return SWL_RC_OK;
+}
+
+/**
+ * @brief Build one radio with a dummy VAP and one AP carrying nrStations stations
+ *
+ * @param pFx fixture to fill
+ * @param runDir existing directory for the hostapd ctrl sockets and config file
+ * @param nrStations stations associated to the AP
+ * @param hapdLatencyUs processing time of the fake hostapd requests
+ * @return SWL_RC_OK on success
+ */
+swl_rc_ne bench_fixture_create(bench_fixture_t* pFx, const char* runDir, uint32_t nrStations, uint32_t hapdLatencyUs) {
+    ASSERT_NOT_NULL(pFx, SWL_RC_INVALID_PARAM, ME, "NULL");
+    memset(pFx, 0, sizeof(*pFx));
+    s_pCurFx = pFx;
+    swl_str_copy(pFx->runDir, sizeof(pFx->runDir), runDir);
+    snprintf(pFx->cfgPath, sizeof(pFx->cfgPath), "%s/hostapd-phy0.conf", runDir);
+
+    pFx->pRad = calloc(1, sizeof(T_Radio));
+    pFx->pSecDmn = calloc(1, sizeof(wld_secDmn_t));
+    mxl_VendorData_t* pRadVendor = calloc(1, sizeof(mxl_VendorData_t));
+    ASSERT_NOT_NULL(pFx->pRad, SWL_RC_ERROR, ME, "NULL");
+    ASSERT_NOT_NULL(pFx->pSecDmn, SWL_RC_ERROR, ME, "NULL");
+    ASSERT_NOT_NULL(pRadVendor, SWL_RC_ERROR, ME, "NULL");
+    T_Radio* pRad = pFx->pRad;
+    swl_str_copy(pRad->Name, sizeof(pRad->Name), "wlan0");
+    amxc_llist_init(&pRad->llAP);
+    pRad->ref_index = 0;
+    pRad->enable = true;
+    pRad->isReady = true;
+    pRad->status = RST_UP;
+    pRad->detailedState = CM_RAD_UP;
+    pFx->pSecDmn->cfgFile = pFx->cfgPath;
+    pRad->hostapd = pFx->pSecDmn;
+    pRad->vendorData = pRadVendor;
+
+    for(uint32_t i = 0; i < BENCH_NR_APS; i++) {
+        ASSERT_NOT_NULL(s_createAp(pFx, i, hapdLatencyUs), SWL_RC_ERROR, ME, "fail to create AP %u", i);
+    }
+    ASSERT_EQUALS(s_createStations(pFx, pFx->aps[BENCH_NR_APS - 1], nrStations), SWL_RC_OK, SWL_RC_ERROR, ME, "fail to create stations");
+
+    whm_mxl_vendorQueue_init(pRad);
+    whm_mxl_reconfMngr_init(pRad);
+    return SWL_RC_OK;
+}
+
+void bench_fixture_destroy(bench_fixture_t* pFx) {
+    ASSERTS_NOT_NULL(pFx, , ME, "NULL");
+    if(pFx->pRad != NULL) {
+        whm_mxl_reconfMngr_deinit(pFx->pRad);
+        whm_mxl_vendorQueue_deinit(pFx->pRad);
+        whm_mxl_hapdConf_cleanup(pFx->pRad);
+    }
+    for(uint32_t i = 0; i < pFx->nrStations; i++) {
+        free(pFx->stations[i]);
+    }
+    free(pFx->stations);
+    for(uint32_t i = 0; i < BENCH_NR_APS; i++) {
+        T_AccessPoint* pAP = pFx->aps[i];
+        if(pAP != NULL) {
+            fake_hostapd_disconnect((fake_hostapdClient_t*) pAP->wpaCtrlInterface);
+            amxc_llist_it_take(&pAP->it);
+            mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+            if(pVapVendor != NULL) {
+                amxc_var_clean(&pVapVendor->cfgShadow);
+            }
+            free(pVapVendor);
+            free(pAP);
+        }
+        free(pFx->ssids[i]);
+        fake_hostapd_stop(pFx->hapds[i]);
+    }
+    if(pFx->pRad != NULL) {
+        free(pFx->pRad->vendorData);
+        free(pFx->pRad);
+    }
+    free(pFx->pSecDmn);
+    unlink(pFx->cfgPath);
+    if(s_pCurFx == pFx) {
+        s_pCurFx = NULL;
+    }
+    memset(pFx, 0, sizeof(*pFx));
+}
+
+T_AccessPoint* bench_fixture_findAp(const char* name) {
+    ASSERTS_NOT_NULL(s_pCurFx, NULL, ME, "no fixture");
+    for(uint32_t i = 0; i < BENCH_NR_APS; i++) {
+        T_AccessPoint* pAP = s_pCurFx->aps[i];
+        if((pAP != NULL) && swl_str_matches(pAP->alias, name)) {
+            return pAP;
+        }
+    }
+    return NULL;
+}
+
+T_AssociatedDevice* bench_fixture_findStation(T_AccessPoint* pAP, const unsigned char* mac) {
+    ASSERTS_NOT_NULL(pAP, NULL, ME, "NULL");
+    ASSERTS_NOT_NULL(mac, NULL, ME, "NULL");
+    for(int i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
+        T_AssociatedDevice* pAD = pAP->AssociatedDevice[i];
+        if((pAD != NULL) && (memcmp(pAD->MACAddress, mac, ETHER_ADDR_LEN) == 0)) {
+            return pAD;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Sum the request counters of the fake hostapd sockets of all APs
+ */
+void bench_fixture_getHapdStats(bench_fixture_t* pFx, fake_hostapd_stats_t* pStats) {
+    ASSERTS_NOT_NULL(pStats, , ME, "NULL");
+    memset(pStats, 0, sizeof(*pStats));
+    ASSERTS_NOT_NULL(pFx, , ME, "NULL");
+    for(uint32_t i = 0; i < BENCH_NR_APS; i++) {
+        fake_hostapd_stats_t apStats;
+        memset(&apStats, 0, sizeof(apStats));
+        fake_hostapd_getStats(pFx->hapds[i], &apStats);
+        pStats->nrCmds += apStats.nrCmds;
+        pStats->nrSet += apStats.nrSet;
+        pStats->nrReloadBss += apStats.nrReloadBss;
+        pStats->nrReconf += apStats.nrReconf;
+        pStats->nrUpdateBeacon += apStats.nrUpdateBeacon;
+        pStats->nrUnknown += apStats.nrUnknown;
+        pStats->nrEvents += apStats.nrEvents;
+    }
+}
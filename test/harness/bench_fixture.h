@@ -0,0 +1,39 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __BENCH_FIXTURE_H__
+#define __BENCH_FIXTURE_H__
+
+#include "wld/wld.h"
+#include "fake_hostapd.h"
+
+/* Dummy (master) VAP, plus one regular AP carrying all stations */
+#define BENCH_NR_APS        2
+#define BENCH_AP_INDEX_BASE 10
+
+typedef struct {
+    char runDir[128];
+    char cfgPath[160];
+    T_Radio* pRad;
+    wld_secDmn_t* pSecDmn;
+    T_AccessPoint* aps[BENCH_NR_APS];
+    T_SSID* ssids[BENCH_NR_APS];
+    fake_hostapd_t* hapds[BENCH_NR_APS];
+    T_AssociatedDevice** stations;
+    uint32_t nrStations;
+    uint32_t cfgGeneration;     /* bumped by each commit, to change the generated config */
+} bench_fixture_t;
+
+bench_fixture_t* bench_fixture_get(void);
+swl_rc_ne bench_fixture_create(bench_fixture_t* pFx, const char* runDir, uint32_t nrStations, uint32_t hapdLatencyUs);
+void bench_fixture_destroy(bench_fixture_t* pFx);
+T_AccessPoint* bench_fixture_findAp(const char* name);
+T_AssociatedDevice* bench_fixture_findStation(T_AccessPoint* pAP, const unsigned char* mac);
+void bench_fixture_getHapdStats(bench_fixture_t* pFx, fake_hostapd_stats_t* pStats);
+
+#endif /* __BENCH_FIXTURE_H__ */
@@ -0,0 +1,333 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : bench_main.c                                          *
+*         Description  : Stats poll and commit benchmarks of the module        *
+*                                                                              *
+*  *****************************************************************************/
+
+/*
+ * For each station count, a fresh fixture is built and every case is run
+ * a number of times, each run being driven until completion by the bench loop:
+ * async nl80211 replies are delivered and amx timers are fired, as the
+ * event loop of pwhm would do.
+ *
+ * Reported per run: wall time, round trips (vendor subcmds and generic nl80211
+ * requests seen by the mock, plus requests received by the fake hostapd sockets),
+ * the round trips the module accounted in its own perf probe, and heap usage.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <amxp/amxp_timer.h>
+
+#include "swl/swl_common.h"
+#include "swl/swl_common_time_spec.h"
+#include "wld/wld.h"
+#include "wld/wld_util.h"
+
+#include "whm_mxl_utils.h"
+#include "whm_mxl_rad.h"
+#include "whm_mxl_vap.h"
+#include "whm_mxl_perf.h"
+#include "whm_mxl_reconfFsm.h"
+#include "whm_mxl_reconfMngr.h"
+
+#include "bench_fixture.h"
+#include "fake_hostapd.h"
+#include "mock_alloc.h"
+#include "mock_nl80211.h"
+
+#define ME "bench"
+
+#define BENCH_DEF_RUNS              20
+#define BENCH_DEF_NL_LATENCY_US     200
+#define BENCH_DEF_HAPD_LATENCY_US   500
+#define BENCH_RUN_TIMEOUT_MS        10000
+#define BENCH_LOOP_SLEEP_US         50
+#define BENCH_MAX_STATION_COUNTS    8
+
+typedef struct {
+    uint32_t runs;
+    uint32_t nlLatencyUs;
+    uint32_t hapdLatencyUs;
+    uint32_t stationCounts[BENCH_MAX_STATION_COUNTS];
+    uint32_t nrStationCounts;
+    bool eventDriven;
+} bench_opts_t;
+
+typedef struct {
+    const char* name;
+    whm_mxl_perfProbe_e probe;
+    bool (* start)(bench_fixture_t* pFx);
+    bool (* isDone)(bench_fixture_t* pFx);
+} bench_case_t;
+
+typedef struct {
+    uint32_t nrRuns;
+    uint32_t nrFailed;
+    uint64_t totalUs;
+    uint64_t maxUs;
+    uint64_t roundTrips;
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t bytes;
+} bench_result_t;
+
+/* cases */
+
+static bool s_radStatsStart(bench_fixture_t* pFx) {
+    return (whm_mxl_rad_stats(pFx->pRad) >= SWL_RC_OK);
+}
+
+static bool s_radStatsDone(bench_fixture_t* pFx) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pFx->pRad);
+    return (pRadVendor->pStatsRound == NULL) && (mock_nl80211_getNrPending() == 0);
+}
+
+static bool s_staStatsStart(bench_fixture_t* pFx) {
+    return (whm_mxl_vap_getStationStats(pFx->aps[BENCH_NR_APS - 1]) >= SWL_RC_OK);
+}
+
+static bool s_staStatsDone(bench_fixture_t* pFx) {
+    mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pFx->aps[BENCH_NR_APS - 1]);
+    return (pVapVendor->pStaStatsRound == NULL) && (mock_nl80211_getNrPending() == 0);
+}
+
+/* One AP change: rewrite the config, reconf the BSS, then resync */
+static bool s_commitStart(bench_fixture_t* pFx) {
+    T_AccessPoint* pAP = pFx->aps[BENCH_NR_APS - 1];
+    mxl_VapVendorData_t* pVapVendor = mxl_vap_getVapVendorData(pAP);
+    pFx->cfgGeneration++;
+    setBitLongArray(pVapVendor->reconfFsm.FSM_BitActionArray, FSM_BW, RECONF_FSM_DO_RECONF_BSS);
+    return (whm_mxl_reconfMngr_doCommit(pFx->pRad) >= 0);
+}
+
+static bool s_commitDone(bench_fixture_t* pFx) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pFx->pRad);
+    return (pRadVendor->reconfFsmBriefState == MXL_RECONF_FSM_IDLE) && (pRadVendor->reconfFsm.timer == NULL);
+}
+
+static const bench_case_t s_cases[] = {
+    {"rad_stats", MXL_PERF_RAD_STATS, s_radStatsStart, s_radStatsDone},
+    {"sta_stats", MXL_PERF_STA_STATS, s_staStatsStart, s_staStatsDone},
+    {"commit", MXL_PERF_RECONF_CYCLE, s_commitStart, s_commitDone},
+};
+
+/* driver scripts: zeroed payloads of the size the module expects */
+
+static void s_setScript(uint32_t subcmd, size_t len, uint32_t latencyUs) {
+    static uint8_t s_zeroPayload[MOCK_NL80211_MAX_PAYLOAD];
+    mock_nl80211_script_t script = {
+        .subcmd = subcmd,
+        .payload = s_zeroPayload,
+        .len = len,
+        .latencyUs = latencyUs,
+        .rc = SWL_RC_OK,
+    };
+    mock_nl80211_setScript(&script);
+}
+
+static void s_setDriverScripts(uint32_t latencyUs) {
+    mock_nl80211_init(latencyUs);
+    s_setScript(LTQ_NL80211_VENDOR_SUBCMD_GET_TR181_WLAN_STATS, sizeof(mtlk_wssa_drv_tr181_wlan_stats_t), latencyUs);
+    s_setScript(LTQ_NL80211_VENDOR_SUBCMD_GET_TEMPERATURE_SENSOR, sizeof(int32_t), latencyUs);
+    s_setScript(LTQ_NL80211_VENDOR_SUBCMD_GET_DEV_DIAG_RESULT3, sizeof(wifiAssociatedDevDiagnostic3_t), latencyUs);
+    s_setScript(LTQ_NL80211_VENDOR_SUBCMD_GET_PEER_FLOW_STATUS, sizeof(mtlk_wssa_drv_peer_stats_t), latencyUs);
+}
+
+/* bench loop */
+
+static uint64_t s_elapsedUs(const swl_timeSpecMono_t* pStart) {
+    swl_timeSpecMono_t now;
+    swl_timeSpecMono_t diff;
+    swl_timespec_getMono(&now);
+    swl_timespec_diff(&diff, pStart, &now);
+    return (uint64_t) diff.tv_sec * 1000000 + (uint64_t) diff.tv_nsec / 1000;
+}
+
+static void s_loopOnce(void) {
+    mock_nl80211_deliverDue();
+    amxp_timers_calculate();
+    amxp_timers_check();
+}
+
+static bool s_runUntilDone(const bench_case_t* pCase, bench_fixture_t* pFx) {
+    swl_timeSpecMono_t start;
+    swl_timespec_getMono(&start);
+    struct timespec pause = {.tv_sec = 0, .tv_nsec = BENCH_LOOP_SLEEP_US * 1000};
+    while(!pCase->isDone(pFx)) {
+        if(s_elapsedUs(&start) > (uint64_t) BENCH_RUN_TIMEOUT_MS * 1000) {
+            return false;
+        }
+        s_loopOnce();
+        nanosleep(&pause, NULL);
+    }
+    return true;
+}
+
+static uint64_t s_getRoundTrips(bench_fixture_t* pFx) {
+    mock_nl80211_stats_t nlStats;
+    fake_hostapd_stats_t hapdStats;
+    mock_nl80211_getStats(&nlStats);
+    bench_fixture_getHapdStats(pFx, &hapdStats);
+    return nlStats.nrRequests + nlStats.nrGenericRequests + hapdStats.nrCmds;
+}
+
+static bool s_runOnce(const bench_case_t* pCase, bench_fixture_t* pFx, bench_result_t* pResult) {
+    mock_alloc_stats_t allocStart;
+    mock_alloc_stats_t allocEnd;
+    mock_alloc_stats_t allocDiff;
+    uint64_t roundTripsStart = s_getRoundTrips(pFx);
+    swl_timeSpecMono_t start;
+
+    mock_alloc_getStats(&allocStart);
+    swl_timespec_getMono(&start);
+    bool ok = pCase->start(pFx) && s_runUntilDone(pCase, pFx);
+    uint64_t elapsedUs = s_elapsedUs(&start);
+    mock_alloc_getStats(&allocEnd);
+    mock_alloc_diff(&allocDiff, &allocStart, &allocEnd);
+
+    if(pResult == NULL) {
+        return ok;
+    }
+    pResult->nrRuns++;
+    if(!ok) {
+        pResult->nrFailed++;
+        return false;
+    }
+    pResult->totalUs += elapsedUs;
+    pResult->maxUs = SWL_MAX(pResult->maxUs, elapsedUs);
+    pResult->roundTrips += s_getRoundTrips(pFx) - roundTripsStart;
+    pResult->allocs += allocDiff.nrAllocs;
+    pResult->frees += allocDiff.nrFrees;
+    pResult->bytes += allocDiff.nrBytes;
+    return true;
+}
+
+static void s_printHeader(void) {
+    printf("%-10s %8s %5s %10s %10s %8s %8s %8s %10s %8s\n",
+           "case", "stations", "runs", "avg_us", "max_us", "rtt", "probe", "allocs", "bytes", "net");
+}
+
+static void s_printResult(const bench_case_t* pCase, bench_fixture_t* pFx, const bench_result_t* pResult) {
+    mxl_VendorData_t* pRadVendor = mxl_rad_getVendorData(pFx->pRad);
+    const whm_mxl_perfStats_t* pProbe = &pRadVendor->perf.stats[pCase->probe];
+    uint32_t nrOk = pResult->nrRuns - pResult->nrFailed;
+    uint32_t div = SWL_MAX(nrOk, 1u);
+    printf("%-10s %8u %5u %10" PRIu64 " %10" PRIu64 " %8.1f %8.1f %8.1f %10" PRIu64 " %8.1f",
+           pCase->name, pFx->nrStations, nrOk, pResult->totalUs / div, pResult->maxUs,
+           (double) pResult->roundTrips / div,
+           pProbe->nrRuns ? (double) pProbe->totalRoundTrips / pProbe->nrRuns : 0.0,
+           (double) pResult->allocs / div, pResult->bytes / div,
+           ((double) pResult->allocs - (double) pResult->frees) / div);
+    if(pResult->nrFailed > 0) {
+        printf("  (%u runs did not complete)", pResult->nrFailed);
+    }
+    printf("\n");
+}
+
+static bool s_runCases(const bench_opts_t* pOpts, const char* runDir, uint32_t nrStations) {
+    bench_fixture_t fx;
+    if(bench_fixture_create(&fx, runDir, nrStations, pOpts->hapdLatencyUs) != SWL_RC_OK) {
+        fprintf(stderr, "fail to create fixture with %u stations\n", nrStations);
+        bench_fixture_destroy(&fx);
+        return false;
+    }
+    bool ok = true;
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(s_cases); i++) {
+        const bench_case_t* pCase = &s_cases[i];
+        bench_result_t result;
+        memset(&result, 0, sizeof(result));
+        s_setDriverScripts(pOpts->nlLatencyUs);
+        /* warm up run, not accounted: first config write, first lock, cold caches */
+        s_runOnce(pCase, &fx, NULL);
+        whm_mxl_perf_reset(fx.pRad);
+        for(uint32_t run = 0; run < pOpts->runs; run++) {
+            s_runOnce(pCase, &fx, &result);
+        }
+        s_printResult(pCase, &fx, &result);
+        ok &= (result.nrFailed == 0);
+    }
+    bench_fixture_destroy(&fx);
+    return ok;
+}
+
+static void s_usage(const char* prog) {
+    fprintf(stderr, "usage: %s [-r runs] [-l nl80211 latency us] [-L hostapd latency us] [-s stations,...] [-p]\n"
+            "  -p  timer driven reconf FSM, instead of event driven\n", prog);
+}
+
+static bool s_parseStationCounts(bench_opts_t* pOpts, char* list) {
+    pOpts->nrStationCounts = 0;
+    for(char* tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        if(pOpts->nrStationCounts >= BENCH_MAX_STATION_COUNTS) {
+            return false;
+        }
+        pOpts->stationCounts[pOpts->nrStationCounts++] = (uint32_t) strtoul(tok, NULL, 0);
+    }
+    return (pOpts->nrStationCounts > 0);
+}
+
+int main(int argc, char** argv) {
+    bench_opts_t opts = {
+        .runs = BENCH_DEF_RUNS,
+        .nlLatencyUs = BENCH_DEF_NL_LATENCY_US,
+        .hapdLatencyUs = BENCH_DEF_HAPD_LATENCY_US,
+        .stationCounts = {1, 32, 256},
+        .nrStationCounts = 3,
+        .eventDriven = true,
+    };
+    int opt;
+    while((opt = getopt(argc, argv, "r:l:L:s:ph")) != -1) {
+        switch(opt) {
+        case 'r': opts.runs = (uint32_t) strtoul(optarg, NULL, 0); break;
+        case 'l': opts.nlLatencyUs = (uint32_t) strtoul(optarg, NULL, 0); break;
+        case 'L': opts.hapdLatencyUs = (uint32_t) strtoul(optarg, NULL, 0); break;
+        case 's':
+            if(!s_parseStationCounts(&opts, optarg)) {
+                s_usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 'p': opts.eventDriven = false; break;
+        default:
+            s_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    /* timers are polled by the bench loop */
+    signal(SIGALRM, SIG_IGN);
+
+    char runDir[] = "/tmp/mxl-bench.XXXXXX";
+    if(mkdtemp(runDir) == NULL) {
+        perror("mkdtemp");
+        return 1;
+    }
+    whm_mxl_reconfFsm_setEventDriven(opts.eventDriven);
+    printf("nl80211 latency %u us, hostapd latency %u us, %u runs, %s reconf FSM\n",
+           opts.nlLatencyUs, opts.hapdLatencyUs, opts.runs, opts.eventDriven ? "event driven" : "timer driven");
+    s_printHeader();
+
+    bool ok = true;
+    for(uint32_t i = 0; i < opts.nrStationCounts; i++) {
+        ok &= s_runCases(&opts, runDir, opts.stationCounts[i]);
+    }
+    rmdir(runDir);
+    return ok ? 0 : 1;
+}
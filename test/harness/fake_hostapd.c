@@ -0,0 +1,344 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : fake_hostapd.c                                        *
+*         Description  : Fake hostapd ctrl socket for the host harness         *
+*                                                                              *
+*  *****************************************************************************/
+
+/*
+ * Datagram unix socket server speaking the subset of the hostapd ctrl protocol
+ * used by the reconf FSM: PING, ATTACH/DETACH, SET, RELOAD_BSS, RECONF, BSS_RECONF,
+ * UPDATE_BEACON and STATUS. Each server runs its own thread and answers after a
+ * configurable latency. Reloads and reconfs are followed by an AP-ENABLED event,
+ * sent as "<3>AP-ENABLED" to the attached clients, like hostapd does.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "fake_hostapd.h"
+
+struct fake_hostapd {
+    int fd;
+    int stopPipe[2];
+    pthread_t thread;
+    pthread_mutex_t lock;
+    char sockPath[sizeof(((struct sockaddr_un*) 0)->sun_path)];
+    uint32_t latencyUs;
+    struct sockaddr_un clients[FAKE_HOSTAPD_MAX_CLIENTS];
+    socklen_t clientLens[FAKE_HOSTAPD_MAX_CLIENTS];
+    uint32_t nrClients;
+    fake_hostapd_stats_t stats;
+};
+
+struct fake_hostapdClient {
+    int fd;
+    char localPath[sizeof(((struct sockaddr_un*) 0)->sun_path)];
+    uint64_t nrEvents;
+};
+
+static void s_sleepUs(uint32_t us) {
+    if(us == 0) {
+        return;
+    }
+    struct timespec ts = {.tv_sec = us / 1000000, .tv_nsec = (long) (us % 1000000) * 1000};
+    nanosleep(&ts, NULL);
+}
+
+static bool s_startsWith(const char* str, const char* prefix) {
+    return (strncmp(str, prefix, strlen(prefix)) == 0);
+}
+
+/* Must be called with the lock held */
+static void s_sendEventLocked(fake_hostapd_t* pHapd, const char* event) {
+    char msg[FAKE_HOSTAPD_MSG_SIZE];
+    int len = snprintf(msg, sizeof(msg), "<3>%s", event);
+    for(uint32_t i = 0; i < pHapd->nrClients; i++) {
+        sendto(pHapd->fd, msg, (size_t) len, MSG_DONTWAIT, (struct sockaddr*) &pHapd->clients[i], pHapd->clientLens[i]);
+        pHapd->stats.nrEvents++;
+    }
+}
+
+static void s_attachLocked(fake_hostapd_t* pHapd, const struct sockaddr_un* pFrom, socklen_t fromLen) {
+    if(pHapd->nrClients >= FAKE_HOSTAPD_MAX_CLIENTS) {
+        return;
+    }
+    pHapd->clients[pHapd->nrClients] = *pFrom;
+    pHapd->clientLens[pHapd->nrClients] = fromLen;
+    pHapd->nrClients++;
+}
+
+static void s_detachLocked(fake_hostapd_t* pHapd, const struct sockaddr_un* pFrom) {
+    for(uint32_t i = 0; i < pHapd->nrClients; i++) {
+        if(strcmp(pHapd->clients[i].sun_path, pFrom->sun_path) == 0) {
+            pHapd->clients[i] = pHapd->clients[pHapd->nrClients - 1];
+            pHapd->clientLens[i] = pHapd->clientLens[pHapd->nrClients - 1];
+            pHapd->nrClients--;
+            return;
+        }
+    }
+}
+
+/* Returns the reply of a request, and the event to emit after it, if any */
+static const char* s_handleCmdLocked(fake_hostapd_t* pHapd, const char* cmd, const struct sockaddr_un* pFrom, socklen_t fromLen,
+                                     const char** pEvent) {
+    pHapd->stats.nrCmds++;
+    *pEvent = NULL;
+    if(strcmp(cmd, "PING") == 0) {
+        return "PONG\n";
+    }
+    if(strcmp(cmd, "ATTACH") == 0) {
+        s_attachLocked(pHapd, pFrom, fromLen);
+        return "OK\n";
+    }
+    if(strcmp(cmd, "DETACH") == 0) {
+        s_detachLocked(pHapd, pFrom);
+        return "OK\n";
+    }
+    if(s_startsWith(cmd, "SET ")) {
+        pHapd->stats.nrSet++;
+        return "OK\n";
+    }
+    if(strcmp(cmd, "RELOAD_BSS") == 0) {
+        pHapd->stats.nrReloadBss++;
+        *pEvent = "AP-ENABLED";
+        return "OK\n";
+    }
+    if(s_startsWith(cmd, "RECONF") || (strcmp(cmd, "BSS_RECONF") == 0)) {
+        pHapd->stats.nrReconf++;
+        *pEvent = "AP-ENABLED";
+        return "OK\n";
+    }
+    if(strcmp(cmd, "UPDATE_BEACON") == 0) {
+        pHapd->stats.nrUpdateBeacon++;
+        return "OK\n";
+    }
+    if(strcmp(cmd, "STATUS") == 0) {
+        return "state=ENABLED\n";
+    }
+    pHapd->stats.nrUnknown++;
+    return "UNKNOWN COMMAND\n";
+}
+
+static void* s_serverThread(void* arg) {
+    fake_hostapd_t* pHapd = (fake_hostapd_t*) arg;
+    struct pollfd fds[2] = {
+        {.fd = pHapd->fd, .events = POLLIN},
+        {.fd = pHapd->stopPipe[0], .events = POLLIN},
+    };
+    char cmd[FAKE_HOSTAPD_MSG_SIZE];
+    while(1) {
+        if(poll(fds, 2, -1) < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if(fds[1].revents) {
+            break;
+        }
+        if(!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+        struct sockaddr_un from;
+        socklen_t fromLen = sizeof(from);
+        ssize_t len = recvfrom(pHapd->fd, cmd, sizeof(cmd) - 1, 0, (struct sockaddr*) &from, &fromLen);
+        if(len <= 0) {
+            continue;
+        }
+        cmd[len] = '\0';
+        while((len > 0) && (cmd[len - 1] == '\n')) {
+            cmd[--len] = '\0';
+        }
+
+        s_sleepUs(pHapd->latencyUs);
+
+        pthread_mutex_lock(&pHapd->lock);
+        const char* event = NULL;
+        const char* reply = s_handleCmdLocked(pHapd, cmd, &from, fromLen, &event);
+        sendto(pHapd->fd, reply, strlen(reply), MSG_DONTWAIT, (struct sockaddr*) &from, fromLen);
+        if(event != NULL) {
+            s_sendEventLocked(pHapd, event);
+        }
+        pthread_mutex_unlock(&pHapd->lock);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Create a ctrl socket at sockPath, and serve it from a new thread
+ *
+ * @param sockPath ctrl socket path, as hostapd uses /var/run/hostapd/<ifname>
+ * @param latencyUs processing time of each request
+ * @return the server, NULL on error
+ */
+fake_hostapd_t* fake_hostapd_start(const char* sockPath, uint32_t latencyUs) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if((sockPath == NULL) || (strlen(sockPath) >= sizeof(addr.sun_path))) {
+        return NULL;
+    }
+    fake_hostapd_t* pHapd = calloc(1, sizeof(fake_hostapd_t));
+    if(pHapd == NULL) {
+        return NULL;
+    }
+    snprintf(pHapd->sockPath, sizeof(pHapd->sockPath), "%s", sockPath);
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", sockPath);
+    pHapd->latencyUs = latencyUs;
+    pthread_mutex_init(&pHapd->lock, NULL);
+    unlink(sockPath);
+    pHapd->fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if((pHapd->fd < 0) || (bind(pHapd->fd, (struct sockaddr*) &addr, sizeof(addr)) < 0) || (pipe(pHapd->stopPipe) < 0)) {
+        fprintf(stderr, "fake hostapd: fail to create %s: %s\n", sockPath, strerror(errno));
+        if(pHapd->fd >= 0) {
+            close(pHapd->fd);
+        }
+        free(pHapd);
+        return NULL;
+    }
+    if(pthread_create(&pHapd->thread, NULL, s_serverThread, pHapd) != 0) {
+        close(pHapd->fd);
+        close(pHapd->stopPipe[0]);
+        close(pHapd->stopPipe[1]);
+        unlink(sockPath);
+        free(pHapd);
+        return NULL;
+    }
+    return pHapd;
+}
+
+void fake_hostapd_stop(fake_hostapd_t* pHapd) {
+    if(pHapd == NULL) {
+        return;
+    }
+    if(write(pHapd->stopPipe[1], "x", 1) < 0) {
+        fprintf(stderr, "fake hostapd: fail to stop %s\n", pHapd->sockPath);
+    }
+    pthread_join(pHapd->thread, NULL);
+    close(pHapd->fd);
+    close(pHapd->stopPipe[0]);
+    close(pHapd->stopPipe[1]);
+    unlink(pHapd->sockPath);
+    pthread_mutex_destroy(&pHapd->lock);
+    free(pHapd);
+}
+
+/**
+ * @brief Send an unsolicited event, e.g. "AP-STA-CONNECTED 00:11:22:33:44:55", to the attached clients
+ */
+void fake_hostapd_emitEvent(fake_hostapd_t* pHapd, const char* event) {
+    if((pHapd == NULL) || (event == NULL)) {
+        return;
+    }
+    pthread_mutex_lock(&pHapd->lock);
+    s_sendEventLocked(pHapd, event);
+    pthread_mutex_unlock(&pHapd->lock);
+}
+
+void fake_hostapd_getStats(fake_hostapd_t* pHapd, fake_hostapd_stats_t* pStats) {
+    if((pHapd == NULL) || (pStats == NULL)) {
+        return;
+    }
+    pthread_mutex_lock(&pHapd->lock);
+    *pStats = pHapd->stats;
+    pthread_mutex_unlock(&pHapd->lock);
+}
+
+/**
+ * @brief Open a ctrl interface on a (fake) hostapd socket, attached for events
+ *
+ * @return the client, NULL when the socket can not be reached
+ */
+fake_hostapdClient_t* fake_hostapd_connect(const char* sockPath) {
+    static uint32_t s_clientId = 0;
+    struct sockaddr_un local = {.sun_family = AF_UNIX};
+    struct sockaddr_un remote = {.sun_family = AF_UNIX};
+    if((sockPath == NULL) || (strlen(sockPath) >= sizeof(remote.sun_path))) {
+        return NULL;
+    }
+    fake_hostapdClient_t* pClient = calloc(1, sizeof(fake_hostapdClient_t));
+    if(pClient == NULL) {
+        return NULL;
+    }
+    snprintf(remote.sun_path, sizeof(remote.sun_path), "%s", sockPath);
+    snprintf(pClient->localPath, sizeof(pClient->localPath), "%s.c%d_%u", sockPath, (int) getpid(), s_clientId++);
+    snprintf(local.sun_path, sizeof(local.sun_path), "%s", pClient->localPath);
+    unlink(pClient->localPath);
+    pClient->fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if((pClient->fd < 0) ||
+       (bind(pClient->fd, (struct sockaddr*) &local, sizeof(local)) < 0) ||
+       (connect(pClient->fd, (struct sockaddr*) &remote, sizeof(remote)) < 0)) {
+        fake_hostapd_disconnect(pClient);
+        return NULL;
+    }
+    char reply[16];
+    if(!fake_hostapd_request(pClient, "ATTACH", reply, sizeof(reply), 1000) || !s_startsWith(reply, "OK")) {
+        fake_hostapd_disconnect(pClient);
+        return NULL;
+    }
+    return pClient;
+}
+
+void fake_hostapd_disconnect(fake_hostapdClient_t* pClient) {
+    if(pClient == NULL) {
+        return;
+    }
+    if(pClient->fd >= 0) {
+        close(pClient->fd);
+    }
+    unlink(pClient->localPath);
+    free(pClient);
+}
+
+bool fake_hostapd_isConnected(const fake_hostapdClient_t* pClient) {
+    return (pClient != NULL) && (pClient->fd >= 0);
+}
+
+/**
+ * @brief Send a request and wait for its reply, counting the events received meanwhile
+ *
+ * @return true when a reply was received within timeoutMs
+ */
+bool fake_hostapd_request(fake_hostapdClient_t* pClient, const char* cmd, char* reply, size_t replyLen, uint32_t timeoutMs) {
+    if(!fake_hostapd_isConnected(pClient) || (cmd == NULL) || (reply == NULL) || (replyLen == 0)) {
+        return false;
+    }
+    if(send(pClient->fd, cmd, strlen(cmd), 0) < 0) {
+        return false;
+    }
+    struct pollfd pfd = {.fd = pClient->fd, .events = POLLIN};
+    char msg[FAKE_HOSTAPD_MSG_SIZE];
+    while(poll(&pfd, 1, (int) timeoutMs) > 0) {
+        ssize_t len = recv(pClient->fd, msg, sizeof(msg) - 1, 0);
+        if(len <= 0) {
+            return false;
+        }
+        msg[len] = '\0';
+        if(msg[0] == '<') {
+            pClient->nrEvents++;
+            continue;
+        }
+        snprintf(reply, replyLen, "%s", msg);
+        return true;
+    }
+    return false;
+}
+
+uint64_t fake_hostapd_getNrEventsReceived(const fake_hostapdClient_t* pClient) {
+    return (pClient != NULL) ? pClient->nrEvents : 0;
+}
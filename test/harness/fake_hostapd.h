@@ -0,0 +1,45 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __FAKE_HOSTAPD_H__
+#define __FAKE_HOSTAPD_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FAKE_HOSTAPD_MAX_CLIENTS    8
+#define FAKE_HOSTAPD_MSG_SIZE       4096
+
+typedef struct fake_hostapd fake_hostapd_t;
+typedef struct fake_hostapdClient fake_hostapdClient_t;
+
+typedef struct {
+    uint64_t nrCmds;        /* all requests received */
+    uint64_t nrSet;
+    uint64_t nrReloadBss;
+    uint64_t nrReconf;      /* RECONF <ifname> and BSS_RECONF */
+    uint64_t nrUpdateBeacon;
+    uint64_t nrUnknown;
+    uint64_t nrEvents;      /* events sent to attached clients */
+} fake_hostapd_stats_t;
+
+/* Server side: one ctrl socket, as hostapd creates per BSS */
+fake_hostapd_t* fake_hostapd_start(const char* sockPath, uint32_t latencyUs);
+void fake_hostapd_stop(fake_hostapd_t* pHapd);
+void fake_hostapd_emitEvent(fake_hostapd_t* pHapd, const char* event);
+void fake_hostapd_getStats(fake_hostapd_t* pHapd, fake_hostapd_stats_t* pStats);
+
+/* Client side: the ctrl interface the module talks through */
+fake_hostapdClient_t* fake_hostapd_connect(const char* sockPath);
+void fake_hostapd_disconnect(fake_hostapdClient_t* pClient);
+bool fake_hostapd_isConnected(const fake_hostapdClient_t* pClient);
+bool fake_hostapd_request(fake_hostapdClient_t* pClient, const char* cmd, char* reply, size_t replyLen, uint32_t timeoutMs);
+uint64_t fake_hostapd_getNrEventsReceived(const fake_hostapdClient_t* pClient);
+
+#endif /* __FAKE_HOSTAPD_H__ */
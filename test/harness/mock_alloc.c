@@ -0,0 +1,81 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : mock_alloc.c                                          *
+*         Description  : Heap allocation counters of the host harness          *
+*                                                                              *
+*  *****************************************************************************/
+
+/*
+ * malloc and friends are interposed in the harness executable, so that the
+ * allocations of the module and of the libraries it calls (amxc variants,
+ * timers, lists) are all counted. The glibc entry points do the real work.
+ * Counters are updated atomically, the fake hostapd threads allocate as well.
+ */
+
+#include <stddef.h>
+
+#include "mock_alloc.h"
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t nmemb, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+static mock_alloc_stats_t s_stats;
+
+static void s_count(uint64_t* pCounter, uint64_t value) {
+    __atomic_add_fetch(pCounter, value, __ATOMIC_RELAXED);
+}
+
+void* malloc(size_t size) {
+    s_count(&s_stats.nrAllocs, 1);
+    s_count(&s_stats.nrBytes, size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t nmemb, size_t size) {
+    s_count(&s_stats.nrAllocs, 1);
+    s_count(&s_stats.nrBytes, nmemb * size);
+    return __libc_calloc(nmemb, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    s_count((ptr == NULL) ? &s_stats.nrAllocs : &s_stats.nrReallocs, 1);
+    s_count(&s_stats.nrBytes, size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) {
+    if(ptr != NULL) {
+        s_count(&s_stats.nrFrees, 1);
+    }
+    __libc_free(ptr);
+}
+
+void mock_alloc_getStats(mock_alloc_stats_t* pStats) {
+    if(pStats == NULL) {
+        return;
+    }
+    pStats->nrAllocs = __atomic_load_n(&s_stats.nrAllocs, __ATOMIC_RELAXED);
+    pStats->nrReallocs = __atomic_load_n(&s_stats.nrReallocs, __ATOMIC_RELAXED);
+    pStats->nrFrees = __atomic_load_n(&s_stats.nrFrees, __ATOMIC_RELAXED);
+    pStats->nrBytes = __atomic_load_n(&s_stats.nrBytes, __ATOMIC_RELAXED);
+}
+
+void mock_alloc_diff(mock_alloc_stats_t* pDiff, const mock_alloc_stats_t* pFrom, const mock_alloc_stats_t* pTo) {
+    if((pDiff == NULL) || (pFrom == NULL) || (pTo == NULL)) {
+        return;
+    }
+    pDiff->nrAllocs = pTo->nrAllocs - pFrom->nrAllocs;
+    pDiff->nrReallocs = pTo->nrReallocs - pFrom->nrReallocs;
+    pDiff->nrFrees = pTo->nrFrees - pFrom->nrFrees;
+    pDiff->nrBytes = pTo->nrBytes - pFrom->nrBytes;
+}
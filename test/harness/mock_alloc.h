@@ -0,0 +1,24 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __MOCK_ALLOC_H__
+#define __MOCK_ALLOC_H__
+
+#include <stdint.h>
+
+typedef struct {
+    uint64_t nrAllocs;      /* malloc, calloc and realloc of a NULL pointer */
+    uint64_t nrReallocs;
+    uint64_t nrFrees;
+    uint64_t nrBytes;       /* bytes requested by allocs and reallocs */
+} mock_alloc_stats_t;
+
+void mock_alloc_getStats(mock_alloc_stats_t* pStats);
+void mock_alloc_diff(mock_alloc_stats_t* pDiff, const mock_alloc_stats_t* pFrom, const mock_alloc_stats_t* pTo);
+
+#endif /* __MOCK_ALLOC_H__ */
@@ -0,0 +1,243 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : mock_nl80211.c                                        *
+*         Description  : Scripted nl80211 vendor driver for the host harness   *
+*                                                                              *
+*  *****************************************************************************/
+
+/*
+ * The module sends its vendor subcmds through wld_rad_nl80211_sendVendorSubCmd()
+ * and wld_ap_nl80211_sendVendorSubCmd(). The harness links the module with
+ * --wrap on both, so that they land here instead of on a netlink socket.
+ *
+ * Each subcmd is answered from its script, after the scripted latency:
+ * - sync requests sleep for the latency, then call the handler before returning
+ * - async requests are parked, and answered by mock_nl80211_deliverDue() from the bench loop
+ *
+ * Replies are built in a static buffer as NL80211_CMD_VENDOR messages carrying
+ * NL80211_ATTR_VENDOR_DATA, so that the module parses them exactly as driver replies.
+ * The mock does not allocate, so that the allocation counts only reflect the module.
+ */
+
+#include <time.h>
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+
+#include "swl/swl_common.h"
+#include "swl/swl_common_time_spec.h"
+#include "wld/wld.h"
+
+#include <nl80211_copy.h>
+
+#include "mock_nl80211.h"
+
+#define ME "mockNl"
+
+typedef swl_rc_ne (* mock_nl80211_handler_f)(swl_rc_ne rc, struct nlmsghdr* nlh, void* priv);
+
+typedef struct {
+    mock_nl80211_script_t script;
+    uint8_t payload[MOCK_NL80211_MAX_PAYLOAD];
+} mock_nl80211_scriptEntry_t;
+
+typedef struct {
+    bool used;
+    swl_timeSpecMono_t dueTs;
+    uint32_t subcmd;
+    mock_nl80211_handler_f handler;
+    void* priv;
+} mock_nl80211_pending_t;
+
+static mock_nl80211_scriptEntry_t s_scripts[MOCK_NL80211_MAX_SCRIPTS];
+static uint32_t s_nrScripts = 0;
+static mock_nl80211_pending_t s_pending[MOCK_NL80211_MAX_PENDING];
+static uint32_t s_nrPending = 0;
+static uint32_t s_defLatencyUs = 0;
+static mock_nl80211_stats_t s_stats;
+
+static uint8_t s_msgBuf[NLMSG_HDRLEN + GENL_HDRLEN + NLA_HDRLEN + NLA_ALIGN(MOCK_NL80211_MAX_PAYLOAD)];
+
+static void s_sleepUs(uint32_t us) {
+    if(us == 0) {
+        return;
+    }
+    struct timespec ts = {.tv_sec = us / 1000000, .tv_nsec = (long) (us % 1000000) * 1000};
+    nanosleep(&ts, NULL);
+}
+
+static bool s_isDue(const swl_timeSpecMono_t* pDueTs, const swl_timeSpecMono_t* pNow) {
+    if(pNow->tv_sec != pDueTs->tv_sec) {
+        return (pNow->tv_sec > pDueTs->tv_sec);
+    }
+    return (pNow->tv_nsec >= pDueTs->tv_nsec);
+}
+
+static const mock_nl80211_script_t* s_findScript(uint32_t subcmd) {
+    for(uint32_t i = 0; i < s_nrScripts; i++) {
+        if(s_scripts[i].script.subcmd == subcmd) {
+            return &s_scripts[i].script;
+        }
+    }
+    return NULL;
+}
+
+static struct nlmsghdr* s_buildReply(const mock_nl80211_script_t* pScript) {
+    memset(s_msgBuf, 0, sizeof(s_msgBuf));
+    struct nlmsghdr* nlh = (struct nlmsghdr*) s_msgBuf;
+    struct genlmsghdr* gnlh = (struct genlmsghdr*) (s_msgBuf + NLMSG_HDRLEN);
+    struct nlattr* nla = (struct nlattr*) ((uint8_t*) gnlh + GENL_HDRLEN);
+    gnlh->cmd = NL80211_CMD_VENDOR;
+    nla->nla_type = NL80211_ATTR_VENDOR_DATA;
+    nla->nla_len = NLA_HDRLEN + pScript->len;
+    memcpy((uint8_t*) nla + NLA_HDRLEN, pScript->payload, pScript->len);
+    nlh->nlmsg_len = NLMSG_HDRLEN + GENL_HDRLEN + NLA_HDRLEN + NLA_ALIGN(pScript->len);
+    return nlh;
+}
+
+static void s_answer(uint32_t subcmd, mock_nl80211_handler_f handler, void* priv) {
+    s_stats.nrReplies++;
+    ASSERTS_NOT_NULL(handler, , ME, "no handler");
+    const mock_nl80211_script_t* pScript = s_findScript(subcmd);
+    if(pScript == NULL) {
+        s_stats.nrUnscripted++;
+        handler(SWL_RC_NOT_IMPLEMENTED, NULL, priv);
+        return;
+    }
+    if(pScript->rc < SWL_RC_OK) {
+        handler(pScript->rc, NULL, priv);
+        return;
+    }
+    handler(SWL_RC_OK, (pScript->payload != NULL) ? s_buildReply(pScript) : NULL, priv);
+}
+
+static uint32_t s_getLatencyUs(uint32_t subcmd) {
+    const mock_nl80211_script_t* pScript = s_findScript(subcmd);
+    return (pScript != NULL) ? pScript->latencyUs : s_defLatencyUs;
+}
+
+static swl_rc_ne s_sendVendorSubCmd(uint32_t subcmd, bool isSync, mock_nl80211_handler_f handler, void* priv) {
+    s_stats.nrRequests++;
+    uint32_t latencyUs = s_getLatencyUs(subcmd);
+    if(isSync) {
+        s_stats.nrSyncRequests++;
+        s_sleepUs(latencyUs);
+        s_answer(subcmd, handler, priv);
+        return SWL_RC_OK;
+    }
+    for(uint32_t i = 0; i < MOCK_NL80211_MAX_PENDING; i++) {
+        mock_nl80211_pending_t* pPending = &s_pending[i];
+        if(pPending->used) {
+            continue;
+        }
+        pPending->used = true;
+        pPending->subcmd = subcmd;
+        pPending->handler = handler;
+        pPending->priv = priv;
+        swl_timespec_getMono(&pPending->dueTs);
+        pPending->dueTs.tv_nsec += (long) latencyUs * 1000;
+        pPending->dueTs.tv_sec += pPending->dueTs.tv_nsec / 1000000000;
+        pPending->dueTs.tv_nsec %= 1000000000;
+        s_nrPending++;
+        return SWL_RC_OK;
+    }
+    s_stats.nrDropped++;
+    return SWL_RC_ERROR;
+}
+
+swl_rc_ne __wrap_wld_rad_nl80211_sendVendorSubCmd(T_Radio* pRad _UNUSED, uint32_t oui _UNUSED, int subcmd, void* data _UNUSED, int dataLen _UNUSED,
+                                                  bool isSync, bool withAck _UNUSED, uint32_t flags _UNUSED,
+                                                  mock_nl80211_handler_f handler, void* priv) {
+    return s_sendVendorSubCmd((uint32_t) subcmd, isSync, handler, priv);
+}
+
+swl_rc_ne __wrap_wld_ap_nl80211_sendVendorSubCmd(T_AccessPoint* pAP _UNUSED, uint32_t oui _UNUSED, int subcmd, void* data _UNUSED, int dataLen _UNUSED,
+                                                 bool isSync, bool withAck _UNUSED, uint32_t flags _UNUSED,
+                                                 mock_nl80211_handler_f handler, void* priv) {
+    return s_sendVendorSubCmd((uint32_t) subcmd, isSync, handler, priv);
+}
+
+/**
+ * @brief Reset the mock: no scripts, no pending request, zero stats
+ *
+ * @param defLatencyUs latency of the subcmds without script, and of generic requests
+ */
+void mock_nl80211_init(uint32_t defLatencyUs) {
+    memset(s_scripts, 0, sizeof(s_scripts));
+    memset(s_pending, 0, sizeof(s_pending));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_nrScripts = 0;
+    s_nrPending = 0;
+    s_defLatencyUs = defLatencyUs;
+}
+
+/**
+ * @brief Add or replace the script of a subcmd, the payload is copied
+ */
+void mock_nl80211_setScript(const mock_nl80211_script_t* pScript) {
+    ASSERT_NOT_NULL(pScript, , ME, "NULL");
+    ASSERT_TRUE(pScript->len <= MOCK_NL80211_MAX_PAYLOAD, , ME, "payload of %u too big (%zu)", pScript->subcmd, pScript->len);
+    mock_nl80211_scriptEntry_t* pEntry = NULL;
+    for(uint32_t i = 0; i < s_nrScripts; i++) {
+        if(s_scripts[i].script.subcmd == pScript->subcmd) {
+            pEntry = &s_scripts[i];
+        }
+    }
+    if(pEntry == NULL) {
+        ASSERT_TRUE(s_nrScripts < MOCK_NL80211_MAX_SCRIPTS, , ME, "too many scripts");
+        pEntry = &s_scripts[s_nrScripts++];
+    }
+    pEntry->script = *pScript;
+    if(pScript->payload != NULL) {
+        memcpy(pEntry->payload, pScript->payload, pScript->len);
+        pEntry->script.payload = pEntry->payload;
+    }
+}
+
+/**
+ * @brief Account one generic (non vendor) nl80211 round trip, done synchronously
+ */
+void mock_nl80211_genericRoundTrip(void) {
+    s_stats.nrGenericRequests++;
+    s_sleepUs(s_defLatencyUs);
+}
+
+/**
+ * @brief Answer the async requests whose latency elapsed
+ *
+ * @return number of answered requests
+ */
+uint32_t mock_nl80211_deliverDue(void) {
+    uint32_t nrDelivered = 0;
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    for(uint32_t i = 0; (i < MOCK_NL80211_MAX_PENDING) && (s_nrPending > 0); i++) {
+        mock_nl80211_pending_t* pPending = &s_pending[i];
+        if(!pPending->used || !s_isDue(&pPending->dueTs, &now)) {
+            continue;
+        }
+        mock_nl80211_pending_t req = *pPending;
+        /* free the slot first: the handler may send the next request of a queue */
+        pPending->used = false;
+        s_nrPending--;
+        s_answer(req.subcmd, req.handler, req.priv);
+        nrDelivered++;
+    }
+    return nrDelivered;
+}
+
+uint32_t mock_nl80211_getNrPending(void) {
+    return s_nrPending;
+}
+
+void mock_nl80211_getStats(mock_nl80211_stats_t* pStats) {
+    ASSERTS_NOT_NULL(pStats, , ME, "NULL");
+    *pStats = s_stats;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+#ifndef __MOCK_NL80211_H__
+#define __MOCK_NL80211_H__
+
+#include "swl/swl_common.h"
+
+#define MOCK_NL80211_MAX_SCRIPTS    32
+#define MOCK_NL80211_MAX_PENDING    4096
+#define MOCK_NL80211_MAX_PAYLOAD    4096
+
+/* Scripted driver answer of one vendor subcmd */
+typedef struct {
+    uint32_t subcmd;
+    const void* payload;    /* reply vendor data, NULL for an ack only answer */
+    size_t len;
+    uint32_t latencyUs;     /* time between the request and its answer */
+    swl_rc_ne rc;           /* SWL_RC_OK, or the error reported to the handler */
+} mock_nl80211_script_t;
+
+typedef struct {
+    uint64_t nrRequests;    /* vendor subcmds sent by the module, sync and async */
+    uint64_t nrSyncRequests;
+    uint64_t nrGenericRequests; /* generic nl80211 requests (station dump, survey) */
+    uint64_t nrReplies;
+    uint64_t nrUnscripted;  /* subcmds without script, answered with SWL_RC_NOT_IMPLEMENTED */
+    uint64_t nrDropped;     /* async requests refused because the pending pool is full */
+} mock_nl80211_stats_t;
+
+void mock_nl80211_init(uint32_t defLatencyUs);
+void mock_nl80211_setScript(const mock_nl80211_script_t* pScript);
+void mock_nl80211_genericRoundTrip(void);
+uint32_t mock_nl80211_deliverDue(void);
+uint32_t mock_nl80211_getNrPending(void);
+void mock_nl80211_getStats(mock_nl80211_stats_t* pStats);
+
+#endif /* __MOCK_NL80211_H__ */
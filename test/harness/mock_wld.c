@@ -0,0 +1,197 @@
+/******************************************************************************
+
+         Copyright (c) 2023 - 2025, MaxLinear, Inc.
+
+  This software may be distributed under the terms of the BSD license.
+  See README for more details.
+
+*******************************************************************************/
+
+/*  *****************************************************************************
+*         File Name    : mock_wld.c                                            *
+*         Description  : pwhm boundary of the module in the host harness       *
+*                                                                              *
+*  *****************************************************************************/
+
+/*
+ * The module calls into libwld for netdev state, data model lookups, the generic
+ * nl80211 functions and the hostapd ctrl interfaces. On the benchmarked paths,
+ * those calls are redirected here with --wrap (see WRAPS in the makefile):
+ * - lookups resolve against the fixture
+ * - generic nl80211 requests are accounted by the nl80211 mock
+ * - wpa ctrl requests are sent to the fake hostapd socket of the AP
+ * - the hostapd config generation writes a synthetic config, one section per BSS
+ */
+
+#include <stdio.h>
+
+#include "swl/swl_common.h"
+#include "wld/wld.h"
+#include "wld/wld_radio.h"
+#include "wld/wld_accesspoint.h"
+#include "wld/wld_assocdev.h"
+#include "wld/wld_nl80211_api.h"
+
+#include "bench_fixture.h"
+#include "fake_hostapd.h"
+#include "mock_nl80211.h"
+
+#define ME "mockWld"
+
+#define MOCK_WLD_CTRL_TIMEOUT_MS 1000
+#define MOCK_WLD_NOISE_DBM       (-92)
+
+static fake_hostapdClient_t* s_ctrl(wld_wpaCtrlInterface_t* pIface) {
+    return (fake_hostapdClient_t*) pIface;
+}
+
+static bool s_ctrlCmd(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* expected, uint32_t timeoutMs) {
+    char reply[FAKE_HOSTAPD_MSG_SIZE] = {0};
+    ASSERTS_TRUE(fake_hostapd_request(s_ctrl(pIface), cmd, reply, sizeof(reply), timeoutMs), false, ME, "no reply to %s", cmd);
+    return (expected == NULL) || (strncmp(reply, expected, strlen(expected)) == 0);
+}
+
+/* netdev state */
+
+int __wrap_wld_linuxIfUtils_getLinkStateExt(char* ifName _UNUSED) {
+    return 1;
+}
+
+int __wrap_wld_linuxIfUtils_getIfIndex(int sock _UNUSED, char* ifName, int* pIfIndex) {
+    T_AccessPoint* pAP = bench_fixture_findAp(ifName);
+    ASSERTS_NOT_NULL(pAP, -1, ME, "%s: unknown interface", ifName);
+    if(pIfIndex != NULL) {
+        *pIfIndex = pAP->index;
+    }
+    return 0;
+}
+
+/* data model lookups */
+
+T_AccessPoint* __wrap_wld_vap_from_name(const char* name) {
+    return bench_fixture_findAp(name);
+}
+
+T_AssociatedDevice* __wrap_wld_vap_find_asociatedDevice(T_AccessPoint* pAP, swl_macBin_t* pMac) {
+    ASSERTS_NOT_NULL(pMac, NULL, ME, "NULL");
+    return bench_fixture_findStation(pAP, pMac->bMac);
+}
+
+T_AccessPoint* __wrap_wld_rad_getFirstVap(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, NULL, ME, "NULL");
+    amxc_llist_it_t* it = amxc_llist_get_first(&pRad->llAP);
+    ASSERTS_NOT_NULL(it, NULL, ME, "no AP");
+    return amxc_llist_it_get_data(it, T_AccessPoint, it);
+}
+
+bool __wrap_wld_rad_areAllVapsDone(T_Radio* pRad _UNUSED) {
+    return true;
+}
+
+bool __wrap_wld_secDmn_isRunning(wld_secDmn_t* pSecDmn) {
+    return (pSecDmn != NULL);
+}
+
+void __wrap_wld_rad_updateState(T_Radio* pRad _UNUSED, bool resetAll _UNUSED) {
+}
+
+void __wrap_wld_vap_updateState(T_AccessPoint* pAP _UNUSED) {
+}
+
+/* generic nl80211 */
+
+swl_rc_ne __wrap_wld_rad_getCurrentNoise(T_Radio* pRad _UNUSED, int32_t* pNoise) {
+    /* one survey dump */
+    mock_nl80211_genericRoundTrip();
+    if(pNoise != NULL) {
+        *pNoise = MOCK_WLD_NOISE_DBM;
+    }
+    return SWL_RC_OK;
+}
+
+static int s_getStationStats(T_AccessPoint* pAP _UNUSED) {
+    /* one station dump for all stations */
+    mock_nl80211_genericRoundTrip();
+    return SWL_RC_OK;
+}
+
+static int s_getSingleStationStats(T_AssociatedDevice* pAD _UNUSED) {
+    mock_nl80211_genericRoundTrip();
+    return SWL_RC_OK;
+}
+
+/*
+ * The generic implementation of the vendor functions called with CALL_NL80211_FTA*,
+ * only the station stats getters are benchmarked.
+ */
+const T_CWLD_FUNC_TABLE* __wrap_wld_nl80211_getVendorTable(void) {
+    static T_CWLD_FUNC_TABLE s_fta;
+    static bool s_ftaInit = false;
+    if(!s_ftaInit) {
+        memset(&s_fta, 0, sizeof(s_fta));
+        s_fta.mfn_wvap_get_station_stats = (void*) s_getStationStats;
+        s_fta.mfn_wvap_get_single_station_stats = (void*) s_getSingleStationStats;
+        s_ftaInit = true;
+    }
+    return &s_fta;
+}
+
+/* hostapd ctrl interfaces */
+
+bool __wrap_wld_wpaCtrlInterface_isReady(wld_wpaCtrlInterface_t* pIface) {
+    return fake_hostapd_isConnected(s_ctrl(pIface));
+}
+
+bool __wrap_wld_wpaCtrlInterface_open(wld_wpaCtrlInterface_t* pIface) {
+    return fake_hostapd_isConnected(s_ctrl(pIface));
+}
+
+void __wrap_wld_wpaCtrlInterface_setEnable(wld_wpaCtrlInterface_t* pIface _UNUSED, bool enable _UNUSED) {
+}
+
+bool __wrap_wld_wpaCtrl_sendCmd(wld_wpaCtrlInterface_t* pIface, const char* cmd) {
+    return s_ctrlCmd(pIface, cmd, NULL, MOCK_WLD_CTRL_TIMEOUT_MS);
+}
+
+bool __wrap_wld_wpaCtrl_sendCmdCheckResponse(wld_wpaCtrlInterface_t* pIface, char* cmd, char* expected) {
+    return s_ctrlCmd(pIface, cmd, expected, MOCK_WLD_CTRL_TIMEOUT_MS);
+}
+
+bool __wrap_wld_wpaCtrl_sendCmdCheckResponseExt(wld_wpaCtrlInterface_t* pIface, char* cmd, char* expected, uint32_t timeoutMs) {
+    return s_ctrlCmd(pIface, cmd, expected, timeoutMs);
+}
+
+swl_rc_ne __wrap_wld_ap_hostapd_sendCommand(T_AccessPoint* pAP, char* cmd, const char* reason _UNUSED) {
+    ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
+    return s_ctrlCmd(pAP->wpaCtrlInterface, cmd, "OK", MOCK_WLD_CTRL_TIMEOUT_MS) ? SWL_RC_OK : SWL_RC_ERROR;
+}
+
+/* hostapd config file */
+
+static bool s_writeCfg(T_Radio* pRad, const char* path) {
+    bench_fixture_t* pFx = bench_fixture_get();
+    ASSERT_NOT_NULL(pFx, false, ME, "no fixture");
+    FILE* fp = fopen(path, "w");
+    ASSERT_NOT_NULL(fp, false, ME, "fail to open %s", path);
+    fprintf(fp, "interface=%s\ndriver=nl80211\nctrl_interface=%s\nhw_mode=a\nchannel=36\n", pRad->Name, pFx->runDir);
+    fprintf(fp, "ieee80211n=1\nieee80211ac=1\nieee80211ax=1\nvht_oper_chwidth=1\nvht_oper_centr_freq_seg0_idx=42\n");
+    T_AccessPoint* pAP = NULL;
+    wld_rad_forEachAp(pAP, pRad) {
+        if(pAP != pFx->aps[0]) {
+            fprintf(fp, "bss=%s\n", pAP->alias);
+        }
+        fprintf(fp, "ssid=%s\nwpa=2\nwpa_key_mgmt=WPA-PSK\nrsn_pairwise=CCMP\nwpa_passphrase=bench%u\nmax_num_sta=%u\n",
+                pAP->pSSID->SSID, (pAP == pFx->aps[BENCH_NR_APS - 1]) ? pFx->cfgGeneration : 0, pFx->nrStations);
+    }
+    fclose(fp);
+    return true;
+}
+
+bool __wrap_wld_hostapd_cfgFile_create(T_Radio* pRad, char* path) {
+    return s_writeCfg(pRad, path);
+}
+
+void __wrap_wld_hostapd_cfgFile_createExt(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    s_writeCfg(pRad, pRad->hostapd->cfgFile);
+}